@@ -0,0 +1,166 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "RTTR_Assert.h"
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace helpers {
+
+template<class T>
+class IntrusiveListHook;
+
+/// Non-owning doubly linked list of pointers whose links are stored in the elements
+/// which must derive from IntrusiveListHook<T>.
+/// Adding, removing and checking if an element is contained are O(1) and don't allocate.
+/// Iteration is in insertion order and yields pointers like a std::list<T*> does.
+/// Like std::list removing an element only invalidates iterators to that element.
+/// An element can only be contained in one list at a time.
+/// T may be incomplete where the list is declared
+template<class T>
+class IntrusiveList
+{
+    static IntrusiveListHook<T>& hook(T& element) { return element; }
+    static const IntrusiveListHook<T>& hook(const T& element) { return element; }
+
+public:
+    class iterator
+    {
+        T* cur_;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T* const*;
+        using reference = T*;
+
+        explicit iterator(T* cur) : cur_(cur) {}
+        bool operator==(const iterator& other) const { return cur_ == other.cur_; }
+        bool operator!=(const iterator& other) const { return cur_ != other.cur_; }
+        T* operator*() const { return cur_; }
+        iterator& operator++()
+        {
+            cur_ = hook(*cur_).next;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator result = *this;
+            ++*this;
+            return result;
+        }
+    };
+    using const_iterator = iterator;
+    using value_type = T*;
+
+    IntrusiveList() = default;
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList(IntrusiveList&& other) noexcept { swap(other); }
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept
+    {
+        clear();
+        swap(other);
+        return *this;
+    }
+    ~IntrusiveList() { clear(); }
+
+    iterator begin() const { return iterator(head_); }
+    iterator end() const { return iterator(nullptr); }
+    bool empty() const { return head_ == nullptr; }
+    size_t size() const { return size_; }
+
+    /// Append the element which must not be in any list
+    void push_back(T* element)
+    {
+        IntrusiveListHook<T>& elHook = hook(*element);
+        RTTR_Assert(!elHook.owner);
+        elHook.owner = this;
+        elHook.prev = tail_;
+        elHook.next = nullptr;
+        if(tail_)
+            hook(*tail_).next = element;
+        else
+            head_ = element;
+        tail_ = element;
+        ++size_;
+    }
+    /// Remove the element pointed to and return an iterator to the next one
+    iterator erase(iterator it)
+    {
+        T* element = *it;
+        ++it;
+        unlink(*element);
+        return it;
+    }
+    /// Remove the element if it is contained in this list
+    void remove(T* element)
+    {
+        if(contains(element))
+            unlink(*element);
+    }
+    bool contains(const T* element) const { return hook(*element).owner == this; }
+    /// Remove all elements
+    void clear()
+    {
+        while(head_)
+            unlink(*head_);
+    }
+
+    void swap(IntrusiveList& other) noexcept
+    {
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+        // Elements refer to their list so update them
+        for(T* element : *this)
+            hook(*element).owner = this;
+        for(T* element : other)
+            hook(*element).owner = &other;
+    }
+
+private:
+    void unlink(T& element)
+    {
+        IntrusiveListHook<T>& elHook = hook(element);
+        if(elHook.prev)
+            hook(*elHook.prev).next = elHook.next;
+        else
+            head_ = elHook.next;
+        if(elHook.next)
+            hook(*elHook.next).prev = elHook.prev;
+        else
+            tail_ = elHook.prev;
+        elHook.owner = nullptr;
+        elHook.prev = elHook.next = nullptr;
+        --size_;
+    }
+
+    T* head_ = nullptr;
+    T* tail_ = nullptr;
+    size_t size_ = 0;
+};
+
+/// Base class for elements of an IntrusiveList<T> storing the links. Copies of elements are not part of any list
+template<class T>
+class IntrusiveListHook
+{
+public:
+    IntrusiveListHook() = default;
+    IntrusiveListHook(const IntrusiveListHook&) {}
+    IntrusiveListHook& operator=(const IntrusiveListHook&) { return *this; }
+
+private:
+    friend class IntrusiveList<T>;
+
+    const void* owner = nullptr;
+    T* prev = nullptr;
+    T* next = nullptr;
+};
+
+} // namespace helpers
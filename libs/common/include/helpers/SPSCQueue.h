@@ -0,0 +1,81 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace helpers {
+
+/// Bounded lock-free queue for exactly one producer and one consumer thread.
+/// push/full may only be called from the producer, pop/empty only from the consumer.
+/// Items are moved in and out so move-only types (e.g. unique_ptr) are supported.
+template<typename T>
+class SPSCQueue
+{
+public:
+    /// Create a queue holding up to capacity items. The capacity is rounded up to the next power of 2
+    explicit SPSCQueue(size_t capacity) : capacity_(roundUpToPowerOf2(capacity)), items_(new T[capacity_])
+    {
+        if(capacity == 0)
+            throw std::invalid_argument("Capacity must not be 0");
+    }
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    size_t capacity() const { return capacity_; }
+
+    /// Add an item. Return false and leave item untouched if the queue is full
+    bool push(T&& item)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if(tail - head_.load(std::memory_order_acquire) == capacity_)
+            return false;
+        items_[tail & (capacity_ - 1)] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    /// Remove the oldest item and store it in item. Return false if the queue is empty
+    bool pop(T& item)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if(head == tail_.load(std::memory_order_acquire))
+            return false;
+        T& slot = items_[head & (capacity_ - 1)];
+        item = std::move(slot);
+        slot = T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Producer side: True if push would fail. Can only change to false concurrently
+    bool full() const
+    {
+        return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire) == capacity_;
+    }
+    /// Consumer side: True if pop would fail. Can only change to false concurrently
+    bool empty() const { return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire); }
+
+private:
+    static size_t roundUpToPowerOf2(size_t value)
+    {
+        size_t result = 1;
+        while(result < value)
+            result <<= 1;
+        return result;
+    }
+
+    const size_t capacity_;
+    std::unique_ptr<T[]> items_;
+    /// Index of the next item to pop, written by the consumer only
+    alignas(64) std::atomic<size_t> head_{0};
+    /// Index of the next free slot, written by the producer only. On its own cache line to avoid false sharing
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+} // namespace helpers
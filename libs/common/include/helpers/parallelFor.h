@@ -0,0 +1,72 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace helpers {
+
+/// Return the number of worker threads to use by default (at least 1)
+inline unsigned getNumWorkerThreads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Call func(i) for every i in [0, numItems) using up to numThreads threads (0 = all cores).
+/// Items are distributed dynamically, so func must only write to state owned by its index to stay deterministic.
+/// The calling thread participates in the work. The first exception thrown (by lowest index) is rethrown after all
+/// threads have finished.
+template<class T_Func>
+void parallelFor(unsigned numItems, T_Func&& func, unsigned numThreads = 0)
+{
+    if(numThreads == 0)
+        numThreads = getNumWorkerThreads();
+    numThreads = std::min(numThreads, numItems);
+    if(numThreads <= 1)
+    {
+        for(unsigned i = 0; i < numItems; i++)
+            func(i);
+        return;
+    }
+
+    std::atomic<unsigned> nextItem(0);
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    unsigned errorItem = numItems;
+    const auto worker = [&]() {
+        for(unsigned i = nextItem++; i < numItems; i = nextItem++)
+        {
+            try
+            {
+                func(i);
+            } catch(...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if(i < errorItem)
+                {
+                    errorItem = i;
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for(unsigned i = 1; i < numThreads; i++)
+        threads.emplace_back(worker);
+    worker();
+    for(std::thread& thread : threads)
+        thread.join();
+    if(error)
+        std::rethrow_exception(error);
+}
+
+} // namespace helpers
@@ -5,9 +5,10 @@
 #pragma once
 
 #include "DescIdx.h"
-#include <map>
+#include <algorithm>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 /// Hold describing data about a type with access by name and index
@@ -30,30 +31,44 @@ struct DescriptionContainer
     T& getMutable(DescIdx<T> idx);
 
 private:
+    using NameIndex = std::vector<std::pair<std::string, unsigned>>;
+    /// Return the first entry in name2Idx not less than name
+    typename NameIndex::const_iterator findName(const std::string& name) const;
+
     std::vector<T> items;
-    std::map<std::string, unsigned> name2Idx;
+    /// Names with the index of their item sorted by name. Flat as there are only few entries which are rarely added
+    NameIndex name2Idx;
 };
 
 template<typename T>
 inline DescIdx<T> DescriptionContainer<T>::add(T desc)
 {
-    if(!getIndex(desc.name))
+    const auto it = findName(desc.name);
+    if(it == name2Idx.end() || it->first != desc.name)
     {
         if(size() >= DescIdx<T>::INVALID)
             throw std::runtime_error("To many entries!");
         DescIdx<T> idx(size());
-        items.push_back(desc);
-        name2Idx[desc.name] = idx.value;
+        name2Idx.emplace(it, desc.name, idx.value);
+        items.push_back(std::move(desc));
         return idx;
     }
     throw std::runtime_error(std::string("Duplicate entry with name ") + desc.name + " added!");
 }
 
+template<typename T>
+inline typename DescriptionContainer<T>::NameIndex::const_iterator
+DescriptionContainer<T>::findName(const std::string& name) const
+{
+    return std::lower_bound(name2Idx.begin(), name2Idx.end(), name,
+                            [](const auto& entry, const std::string& value) { return entry.first < value; });
+}
+
 template<typename T>
 inline DescIdx<T> DescriptionContainer<T>::getIndex(const std::string& name) const
 {
-    auto it = name2Idx.find(name);
-    if(it == name2Idx.end())
+    const auto it = findName(name);
+    if(it == name2Idx.end() || it->first != name)
         return DescIdx<T>();
     return DescIdx<T>(it->second);
 }
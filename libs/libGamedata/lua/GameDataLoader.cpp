@@ -14,11 +14,93 @@
 #include "gameData/WorldDescription.h"
 #include "s25util/Log.h"
 #include <kaguya/kaguya.hpp>
+#include <boost/crc.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace bfs = boost::filesystem;
 
+namespace {
+/// Relative path, size and modification time of a script which may be included
+struct ScriptFileInfo
+{
+    std::string path;
+    uintmax_t size;
+    std::time_t lastWriteTime;
+
+    bool operator==(const ScriptFileInfo& rhs) const
+    {
+        return path == rhs.path && size == rhs.size && lastWriteTime == rhs.lastWriteTime;
+    }
+    bool operator!=(const ScriptFileInfo& rhs) const { return !(*this == rhs); }
+};
+using ScriptFileInfos = std::vector<ScriptFileInfo>;
+/// CRC32 of all scripts, in the same order as the ScriptFileInfos
+using ScriptChecksums = std::vector<uint32_t>;
+
+ScriptFileInfos getScriptFileInfos(const bfs::path& basePath)
+{
+    ScriptFileInfos result;
+    if(!bfs::is_directory(basePath))
+        return result;
+    for(const auto& entry : bfs::recursive_directory_iterator(basePath))
+    {
+        if(entry.path().extension() != ".lua" || !bfs::is_regular_file(entry.status()))
+            continue;
+        result.push_back(ScriptFileInfo{entry.path().lexically_relative(basePath).generic_string(),
+                                        bfs::file_size(entry.path()), bfs::last_write_time(entry.path())});
+    }
+    std::sort(result.begin(), result.end(),
+              [](const ScriptFileInfo& lhs, const ScriptFileInfo& rhs) { return lhs.path < rhs.path; });
+    return result;
+}
+
+ScriptChecksums calcScriptChecksums(const bfs::path& basePath, const ScriptFileInfos& files)
+{
+    ScriptChecksums result;
+    result.reserve(files.size());
+    for(const ScriptFileInfo& fileInfo : files)
+    {
+        boost::nowide::ifstream file(basePath / fileInfo.path, std::ios::binary);
+        const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        boost::crc_32_type crc;
+        crc.process_bytes(content.data(), content.size());
+        result.push_back(crc.checksum());
+    }
+    return result;
+}
+
+struct CachedGameData
+{
+    ScriptFileInfos files;
+    /// Time (before) the files were checked. Files modified in that second or later may have changed unnoticed
+    /// as the modification time has a resolution of 1s only
+    std::time_t checkTime;
+    ScriptChecksums checksums;
+    std::shared_ptr<const WorldDescription> worldDesc;
+
+    bool isUnchanged(const ScriptFileInfos& curFiles) const
+    {
+        return curFiles == files && !helpers::contains_if(files, [this](const ScriptFileInfo& fileInfo) {
+            return fileInfo.lastWriteTime >= checkTime;
+        });
+    }
+};
+
+std::mutex gameDataCacheMutex;
+/// Last successfully loaded game data per (normalized) base path
+std::map<bfs::path, CachedGameData> gameDataCache;
+} // namespace
+
 GameDataLoader::GameDataLoader(WorldDescription& worldDesc, const boost::filesystem::path& basePath)
     : worldDesc_(worldDesc), basePath_(basePath.lexically_normal().make_preferred()), curIncludeDepth_(0),
       errorInIncludeFile_(false)
@@ -29,9 +111,7 @@ GameDataLoader::GameDataLoader(WorldDescription& worldDesc, const boost::filesys
     lua["include"] = kaguya::function([this](const std::string& file) { Include(file); });
 }
 
-GameDataLoader::GameDataLoader(WorldDescription& worldDesc)
-    : GameDataLoader(worldDesc, RTTRCONFIG.ExpandPath(s25::folders::gamedata) / "world")
-{}
+GameDataLoader::GameDataLoader(WorldDescription& worldDesc) : GameDataLoader(worldDesc, GetDefaultBasePath()) {}
 
 GameDataLoader::~GameDataLoader() = default;
 
@@ -52,6 +132,11 @@ bool GameDataLoader::Load()
     return !errorInIncludeFile_;
 }
 
+bfs::path GameDataLoader::GetDefaultBasePath()
+{
+    return RTTRCONFIG.ExpandPath(s25::folders::gamedata) / "world";
+}
+
 void GameDataLoader::Register(kaguya::State& state)
 {
     state["RTTRGameData"].setClass(kaguya::UserdataMetatable<GameDataLoader, LuaInterfaceBase>()
@@ -120,9 +205,48 @@ void GameDataLoader::AddTerrain(const kaguya::LuaTable& data)
 }
 
 void loadGameData(WorldDescription& worldDesc)
+{
+    const auto gameData = loadSharedGameData();
+    if(!gameData)
+        throw std::runtime_error("Failed to load game data");
+    worldDesc = *gameData;
+}
 
+std::shared_ptr<const WorldDescription> loadSharedGameData(const bfs::path& basePath)
 {
-    GameDataLoader gdLoader(worldDesc);
+    const bfs::path cacheKey = basePath.lexically_normal().make_preferred();
+    const std::time_t checkTime = std::time(nullptr);
+    ScriptFileInfos files = getScriptFileInfos(cacheKey);
+    {
+        std::lock_guard<std::mutex> lock(gameDataCacheMutex);
+        const auto it = gameDataCache.find(cacheKey);
+        if(it != gameDataCache.end() && it->second.isUnchanged(files))
+            return it->second.worldDesc;
+    }
+
+    // Only read the files when the cheap check failed. They might still have the same content (e.g. only touched)
+    ScriptChecksums checksums = calcScriptChecksums(cacheKey, files);
+    {
+        std::lock_guard<std::mutex> lock(gameDataCacheMutex);
+        const auto it = gameDataCache.find(cacheKey);
+        if(it != gameDataCache.end() && it->second.checksums == checksums)
+        {
+            it->second.files = std::move(files);
+            it->second.checkTime = checkTime;
+            return it->second.worldDesc;
+        }
+    }
+
+    auto worldDesc = std::make_shared<WorldDescription>();
+    GameDataLoader gdLoader(*worldDesc, basePath);
     if(!gdLoader.Load())
-        throw std::runtime_error("Failed to load game data");
+        return nullptr;
+    std::lock_guard<std::mutex> lock(gameDataCacheMutex);
+    gameDataCache[cacheKey] = CachedGameData{std::move(files), checkTime, std::move(checksums), worldDesc};
+    return worldDesc;
+}
+
+std::shared_ptr<const WorldDescription> loadSharedGameData()
+{
+    return loadSharedGameData(GameDataLoader::GetDefaultBasePath());
 }
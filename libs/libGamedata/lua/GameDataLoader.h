@@ -6,6 +6,7 @@
 
 #include "LuaInterfaceBase.h"
 #include <boost/filesystem/path.hpp>
+#include <memory>
 
 namespace kaguya {
 class State;
@@ -13,6 +14,8 @@ class LuaTable;
 } // namespace kaguya
 struct WorldDescription;
 
+/// Runs the game data scripts adding their descriptions to a WorldDescription.
+/// Always executes the scripts, use loadSharedGameData to avoid that when the data is only read
 class GameDataLoader : public LuaInterfaceBase
 {
 public:
@@ -22,6 +25,9 @@ public:
 
     bool Load();
 
+    /// Return the folder containing the default game data scripts
+    static boost::filesystem::path GetDefaultBasePath();
+
     static void Register(kaguya::State& state);
 
 private:
@@ -36,4 +42,11 @@ private:
     bool errorInIncludeFile_;
 };
 
+/// Load the game data from the default location into worldDesc. Throws on error
 void loadGameData(WorldDescription& worldDesc);
+/// Return the game data loaded from the scripts in basePath or nullptr on error.
+/// The result is shared process-wide and the scripts are only run again when their checksums change.
+/// The checksums are only computed when the list of scripts, their sizes or modification times changed
+std::shared_ptr<const WorldDescription> loadSharedGameData(const boost::filesystem::path& basePath);
+/// Same as above for the default location
+std::shared_ptr<const WorldDescription> loadSharedGameData();
@@ -4,6 +4,7 @@
 
 #include "Debug.h"
 #include "GameManager.h"
+#include "Loader.h"
 #include "QuickStartGame.h"
 #include "RTTR_AssertError.h"
 #include "RTTR_Version.h"
@@ -12,9 +13,11 @@
 #include "SignalHandler.h"
 #include "WindowManager.h"
 #include "commands.h"
+#include "desktops/dskBenchmark.h"
 #include "drivers/AudioDriverWrapper.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "files.h"
+#include "gameData/ApplicationLoader.h"
 #include "helpers/format.hpp"
 #include "mygettext/mygettext.h"
 #include "ogl/glAllocator.h"
@@ -27,6 +30,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/nowide/args.hpp>
 #include <boost/nowide/iostream.hpp>
+#include <boost/optional.hpp>
 #include <boost/program_options.hpp>
 #include <array>
 #include <cstdlib>
@@ -373,7 +377,8 @@ bool InitDirectories()
     // Create all required/useful folders
     const std::array<std::string, 10> dirs = {
       {s25::folders::config, s25::folders::logs, s25::folders::mapsOwn, s25::folders::mapsPlayed, s25::folders::replays,
-       s25::folders::save, s25::folders::assetsUserOverrides, s25::folders::screenshots, s25::folders::playlists}};
+       s25::folders::save, s25::folders::assetsUserOverrides, s25::folders::screenshots, s25::folders::playlists,
+       s25::folders::cache}};
 
     for(const std::string& rawDir : dirs)
     {
@@ -435,6 +440,16 @@ bool InitGame(GameManager& gameManager)
     return true;
 }
 
+/// Load the files required for the GUI and show the benchmark desktop which runs the configured benchmarks
+bool StartBenchmark(dskBenchmark::Config config)
+{
+    ApplicationLoader loader(RTTRCONFIG, LOADER, LOG, SETTINGS.sound.playlist);
+    if(!loader.load())
+        return false;
+    WINDOWMANAGER.Switch(std::make_unique<dskBenchmark>(std::move(config)));
+    return true;
+}
+
 int RunProgram(po::variables_map& options)
 {
     LOG.write("%1%\n\n", LogTarget::Stdout) % GetProgramDescription();
@@ -466,6 +481,25 @@ int RunProgram(po::variables_map& options)
         }
     }
 
+    boost::optional<dskBenchmark::Config> benchmarkConfig;
+    if(options.count("benchmark"))
+    {
+        benchmarkConfig.emplace();
+        try
+        {
+            benchmarkConfig->benchmarks = parseBenchmarks(options["benchmark"].as<std::string>());
+        } catch(const std::invalid_argument& e)
+        {
+            bnw::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        benchmarkConfig->numFrames = options["benchmark-frames"].as<unsigned>();
+        benchmarkConfig->numGFsPerFrame = options["benchmark-gfs"].as<unsigned>();
+        benchmarkConfig->numInstances = options["benchmark-instances"].as<int>();
+        if(options.count("benchmark-output"))
+            benchmarkConfig->outputFile = options["benchmark-output"].as<std::string>();
+    }
+
     SetGlobalInstanceWrapper<GameManager> gameManager(setGlobalGameManager, LOG, SETTINGS, VIDEODRIVER, AUDIODRIVER,
                                                       WINDOWMANAGER);
     try
@@ -473,7 +507,11 @@ int RunProgram(po::variables_map& options)
         if(!InitGame(gameManager))
             return 2;
 
-        if(options.count("map"))
+        if(benchmarkConfig)
+        {
+            if(!StartBenchmark(std::move(*benchmarkConfig)))
+                return 1;
+        } else if(options.count("map"))
         {
             std::vector<std::string> aiPlayers;
             if(options.count("ai"))
@@ -532,6 +570,12 @@ int main(int argc, char** argv)
         ("ai", po::value<std::vector<std::string>>(),"AI player(s) to add")
         ("version", "Show version information and exit")
         ("convert-sounds", "Convert sounds and exit")
+        ("benchmark", po::value<std::string>(),
+            "Run benchmarks and exit. Comma separated list of text, primitives, emptyGame, basicGame, fullGame or all")
+        ("benchmark-frames", po::value<unsigned>()->default_value(500), "Number of frames drawn per benchmark")
+        ("benchmark-gfs", po::value<unsigned>()->default_value(0), "GFs simulated per frame in the game benchmarks")
+        ("benchmark-instances", po::value<int>()->default_value(1000), "Number of objects created by the benchmarks")
+        ("benchmark-output", po::value<std::string>(), "File to write the benchmark results to as JSON")
         ;
     // clang-format on
     po::positional_options_description positionalOptions;
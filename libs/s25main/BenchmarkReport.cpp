@@ -0,0 +1,172 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkReport.h"
+#include "RTTR_Assert.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <locale>
+#include <numeric>
+#include <ostream>
+#ifdef _WIN32
+#    include <windows.h>
+#    include <psapi.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+namespace {
+using milliseconds_f = std::chrono::duration<double, std::milli>;
+using seconds_f = std::chrono::duration<double>;
+
+double toMs(BenchmarkReport::clock::duration duration)
+{
+    return std::chrono::duration_cast<milliseconds_f>(duration).count();
+}
+
+/// Element at the given percentile of the sorted values using the nearest-rank method
+BenchmarkReport::clock::duration getPercentile(const std::vector<BenchmarkReport::clock::duration>& sortedValues,
+                                               unsigned percentile)
+{
+    const auto rank = static_cast<size_t>(std::ceil(percentile / 100. * sortedValues.size()));
+    return sortedValues[std::max<size_t>(rank, 1u) - 1u];
+}
+
+void writeStatistics(std::ostream& os, const char* name, std::vector<BenchmarkReport::clock::duration> durations)
+{
+    const BenchmarkReport::Statistics stats = BenchmarkReport::getStatistics(std::move(durations));
+    os << "      \"" << name << "\": {\"min\": " << toMs(stats.min) << ", \"median\": " << toMs(stats.median)
+       << ", \"p95\": " << toMs(stats.p95) << ", \"p99\": " << toMs(stats.p99) << ", \"max\": " << toMs(stats.max)
+       << ", \"mean\": " << toMs(stats.mean) << "}";
+}
+
+void writeString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for(const char c : str)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\';
+        os << c;
+    }
+    os << '"';
+}
+} // namespace
+
+BenchmarkReport::Statistics BenchmarkReport::getStatistics(std::vector<clock::duration> durations)
+{
+    Statistics result;
+    if(durations.empty())
+        return result;
+    std::sort(durations.begin(), durations.end());
+    result.min = durations.front();
+    result.median = getPercentile(durations, 50);
+    result.p95 = getPercentile(durations, 95);
+    result.p99 = getPercentile(durations, 99);
+    result.max = durations.back();
+    result.mean = std::accumulate(durations.begin(), durations.end(), clock::duration::zero())
+                  / static_cast<clock::duration::rep>(durations.size());
+    return result;
+}
+
+BenchmarkReport::clock::duration BenchmarkReport::Test::getTotalTime() const
+{
+    return std::accumulate(frameTimes.begin(), frameTimes.end(), clock::duration::zero());
+}
+
+BenchmarkReport::clock::duration BenchmarkReport::Test::getTotalSimTime() const
+{
+    return std::accumulate(simTimes.begin(), simTimes.end(), clock::duration::zero());
+}
+
+std::vector<BenchmarkReport::clock::duration> BenchmarkReport::Test::getDrawTimes() const
+{
+    RTTR_Assert(frameTimes.size() == simTimes.size());
+    std::vector<clock::duration> result(frameTimes.size());
+    std::transform(frameTimes.begin(), frameTimes.end(), simTimes.begin(), result.begin(), std::minus<>());
+    return result;
+}
+
+double BenchmarkReport::Test::getGFsPerSecond() const
+{
+    const seconds_f simTime = getTotalSimTime();
+    if(numGFs == 0 || simTime.count() <= 0)
+        return 0;
+    return numGFs / simTime.count();
+}
+
+void BenchmarkReport::startTest(std::string name, int numInstances)
+{
+    if(isTestRunning_)
+        finishTest();
+    tests_.emplace_back();
+    tests_.back().name = std::move(name);
+    tests_.back().numInstances = numInstances;
+    isTestRunning_ = true;
+}
+
+void BenchmarkReport::addFrame(clock::duration frameTime, clock::duration simTime, unsigned numGFs)
+{
+    RTTR_Assert(isTestRunning_);
+    Test& test = tests_.back();
+    test.frameTimes.push_back(frameTime);
+    test.simTimes.push_back(std::min(simTime, frameTime));
+    test.numGFs += numGFs;
+}
+
+void BenchmarkReport::finishTest()
+{
+    RTTR_Assert(isTestRunning_);
+    tests_.back().peakMemoryUsage = getPeakMemoryUsage();
+    isTestRunning_ = false;
+}
+
+void BenchmarkReport::WriteJSON(std::ostream& os) const
+{
+    // Numbers must not be formatted according to the users locale
+    const std::locale oldLocale = os.imbue(std::locale::classic());
+    os << "{\n  \"peakMemoryBytes\": " << getPeakMemoryUsage() << ",\n  \"tests\": [";
+    const size_t numFinished = isTestRunning_ ? tests_.size() - 1u : tests_.size();
+    for(size_t i = 0; i < numFinished; i++)
+    {
+        const Test& test = tests_[i];
+        os << (i ? ",\n" : "\n") << "    {\n      \"name\": ";
+        writeString(os, test.name);
+        os << ",\n      \"instances\": " << test.numInstances << ",\n      \"frames\": " << test.frameTimes.size()
+           << ",\n      \"gfs\": " << test.numGFs << ",\n      \"totalMs\": " << toMs(test.getTotalTime())
+           << ",\n      \"simulationMs\": " << toMs(test.getTotalSimTime())
+           << ",\n      \"gfsPerSecond\": " << test.getGFsPerSecond()
+           << ",\n      \"peakMemoryBytes\": " << test.peakMemoryUsage << ",\n";
+        writeStatistics(os, "frameMs", test.frameTimes);
+        os << ",\n";
+        writeStatistics(os, "simulationFrameMs", test.simTimes);
+        os << ",\n";
+        writeStatistics(os, "drawFrameMs", test.getDrawTimes());
+        os << "\n    }";
+    }
+    os << (numFinished ? "\n  ]\n}\n" : "]\n}\n");
+    os.imbue(oldLocale);
+}
+
+uint64_t getPeakMemoryUsage()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#    ifdef __APPLE__
+    // Already in bytes
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#    else
+    // In kilobytes
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024u;
+#    endif
+#endif
+}
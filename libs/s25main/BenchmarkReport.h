@@ -0,0 +1,71 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// Records the frame times of benchmark runs, separated into time spent simulating GFs and drawing,
+/// and writes them as JSON for automatic evaluation
+class BenchmarkReport
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Statistics
+    {
+        clock::duration min = clock::duration::zero(), median = clock::duration::zero(),
+                        p95 = clock::duration::zero(), p99 = clock::duration::zero(),
+                        max = clock::duration::zero(), mean = clock::duration::zero();
+    };
+    /// Calculate the statistics of the durations using the nearest-rank method. All zero if there are none
+    static Statistics getStatistics(std::vector<clock::duration> durations);
+
+    struct Test
+    {
+        std::string name;
+        int numInstances = 0;
+        /// Total time and time spent simulating GFs for each frame
+        std::vector<clock::duration> frameTimes, simTimes;
+        unsigned numGFs = 0;
+        /// Peak memory usage of the process when the test finished in bytes
+        uint64_t peakMemoryUsage = 0;
+
+        clock::duration getTotalTime() const;
+        clock::duration getTotalSimTime() const;
+        /// Time spent drawing each frame, i.e. everything but the simulation
+        std::vector<clock::duration> getDrawTimes() const;
+        /// Simulated GFs per second of simulation time. 0 if no GF was run
+        double getGFsPerSecond() const;
+    };
+
+    /// Start recording a new test
+    void startTest(std::string name, int numInstances);
+    /// Add a frame to the current test which took frameTime, of which simTime was spent simulating numGFs GFs
+    void addFrame(clock::duration frameTime, clock::duration simTime = clock::duration::zero(), unsigned numGFs = 0);
+    /// Finish the current test
+    void finishTest();
+
+    const std::vector<Test>& getTests() const { return tests_; }
+    /// Remove all tests including a running one
+    void Clear()
+    {
+        tests_.clear();
+        isTestRunning_ = false;
+    }
+
+    /// Write all finished tests as a JSON object. Durations are in milliseconds
+    void WriteJSON(std::ostream& os) const;
+
+private:
+    std::vector<Test> tests_;
+    bool isTestRunning_ = false;
+};
+
+/// Return the largest amount of physical memory used by this process so far in bytes or 0 if unknown
+uint64_t getPeakMemoryUsage();
@@ -9,6 +9,23 @@
 #include "ogl/glArchivItem_Bitmap.h"
 #include "gameData/BuildingConsts.h"
 #include "s25util/colors.h"
+#include <map>
+#include <memory>
+#include <tuple>
+
+namespace detail {
+/// Only the game logic may call this as the instances are not guarded against concurrent access
+template<class T, typename... T_Values>
+const T* getShared(T_Values... values)
+{
+    static std::map<std::tuple<T_Values...>, std::unique_ptr<const T>> instances;
+    const auto key = std::make_tuple(values...);
+    auto it = instances.find(key);
+    if(it == instances.end())
+        it = instances.emplace(key, std::unique_ptr<const T>(new T(values...))).first;
+    return it->second.get();
+}
+} // namespace detail
 
 /// Berechnet die dunklere Spielerfarbe zum Zeichnen
 unsigned CalcPlayerFOWDrawColor(const unsigned color)
@@ -30,7 +47,17 @@ unsigned CalcPlayerFOWDrawColor(const unsigned color)
 
 fowBuilding::fowBuilding(const BuildingType type, const Nation nation) : type(type), nation(nation) {}
 
-fowBuilding::fowBuilding(SerializedGameData& sgd) : type(sgd.Pop<BuildingType>()), nation(sgd.Pop<Nation>()) {}
+const fowBuilding* fowBuilding::Get(const BuildingType type, const Nation nation)
+{
+    return detail::getShared<fowBuilding>(type, nation);
+}
+
+const fowBuilding* fowBuilding::Deserialize(SerializedGameData& sgd)
+{
+    const auto type = sgd.Pop<BuildingType>();
+    const auto nation = sgd.Pop<Nation>();
+    return Get(type, nation);
+}
 
 void fowBuilding::Serialize(SerializedGameData& sgd) const
 {
@@ -51,10 +78,20 @@ fowBuildingSite::fowBuildingSite(const bool planing, const BuildingType type, co
     : planing(planing), type(type), nation(nation), build_progress(build_progress)
 {}
 
-fowBuildingSite::fowBuildingSite(SerializedGameData& sgd)
-    : planing(sgd.PopBool()), type(sgd.Pop<BuildingType>()), nation(sgd.Pop<Nation>()),
-      build_progress(sgd.PopUnsignedChar())
-{}
+const fowBuildingSite* fowBuildingSite::Get(const bool planing, const BuildingType type, const Nation nation,
+                                            const unsigned char build_progress)
+{
+    return detail::getShared<fowBuildingSite>(planing, type, nation, build_progress);
+}
+
+const fowBuildingSite* fowBuildingSite::Deserialize(SerializedGameData& sgd)
+{
+    const bool planing = sgd.PopBool();
+    const auto type = sgd.Pop<BuildingType>();
+    const auto nation = sgd.Pop<Nation>();
+    const unsigned char build_progress = sgd.PopUnsignedChar();
+    return Get(planing, type, nation, build_progress);
+}
 
 void fowBuildingSite::Serialize(SerializedGameData& sgd) const
 {
@@ -106,13 +143,27 @@ void fowBuildingSite::Draw(DrawPoint drawPt) const
 ////////////////////////////////////////////////////////////////////////////////////
 // fowFlag
 
-fowFlag::fowFlag(const unsigned playerColor, const Nation nation, const FlagType flag_type)
-    : color(CalcPlayerFOWDrawColor(playerColor)), nation(nation), flag_type(flag_type)
+fowFlag::fowFlag(const unsigned drawColor, const Nation nation, const FlagType flag_type)
+    : color(drawColor), nation(nation), flag_type(flag_type)
 {}
 
-fowFlag::fowFlag(SerializedGameData& sgd)
-    : color(sgd.PopUnsignedInt()), nation(sgd.Pop<Nation>()), flag_type(sgd.Pop<FlagType>())
-{}
+const fowFlag* fowFlag::Get(const unsigned playerColor, const Nation nation, const FlagType flag_type)
+{
+    return GetWithDrawColor(CalcPlayerFOWDrawColor(playerColor), nation, flag_type);
+}
+
+const fowFlag* fowFlag::GetWithDrawColor(const unsigned drawColor, const Nation nation, const FlagType flag_type)
+{
+    return detail::getShared<fowFlag>(drawColor, nation, flag_type);
+}
+
+const fowFlag* fowFlag::Deserialize(SerializedGameData& sgd)
+{
+    const unsigned drawColor = sgd.PopUnsignedInt();
+    const auto nation = sgd.Pop<Nation>();
+    const auto flag_type = sgd.Pop<FlagType>();
+    return GetWithDrawColor(drawColor, nation, flag_type);
+}
 
 void fowFlag::Serialize(SerializedGameData& sgd) const
 {
@@ -131,7 +182,17 @@ void fowFlag::Draw(DrawPoint drawPt) const
 
 fowTree::fowTree(const unsigned char type, const unsigned char size) : type(type), size(size) {}
 
-fowTree::fowTree(SerializedGameData& sgd) : type(sgd.PopUnsignedChar()), size(sgd.PopUnsignedChar()) {}
+const fowTree* fowTree::Get(const unsigned char type, const unsigned char size)
+{
+    return detail::getShared<fowTree>(type, size);
+}
+
+const fowTree* fowTree::Deserialize(SerializedGameData& sgd)
+{
+    const unsigned char type = sgd.PopUnsignedChar();
+    const unsigned char size = sgd.PopUnsignedChar();
+    return Get(type, size);
+}
 
 void fowTree::Serialize(SerializedGameData& sgd) const
 {
@@ -158,7 +219,17 @@ void fowTree::Draw(DrawPoint drawPt) const
 
 fowGranite::fowGranite(const GraniteType type, const unsigned char state) : type(type), state(state) {}
 
-fowGranite::fowGranite(SerializedGameData& sgd) : type(sgd.Pop<GraniteType>()), state(sgd.PopUnsignedChar()) {}
+const fowGranite* fowGranite::Get(const GraniteType type, const unsigned char state)
+{
+    return detail::getShared<fowGranite>(type, state);
+}
+
+const fowGranite* fowGranite::Deserialize(SerializedGameData& sgd)
+{
+    const auto type = sgd.Pop<GraniteType>();
+    const unsigned char state = sgd.PopUnsignedChar();
+    return Get(type, state);
+}
 
 void fowGranite::Serialize(SerializedGameData& sgd) const
 {
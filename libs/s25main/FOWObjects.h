@@ -17,6 +17,12 @@ const unsigned FOW_DRAW_COLOR = 0xFF808080;
 /// Berechnet die dunklere Spielerfarbe zum Zeichnen
 unsigned CalcPlayerFOWDrawColor(unsigned color);
 
+namespace detail {
+/// Return the shared instance of T with the given values, creating it on first use
+template<class T, typename... T_Values>
+const T* getShared(T_Values... values);
+} // namespace detail
+
 /// Gebäude im Nebel
 class fowBuilding : public FOWObject
 {
@@ -26,9 +32,14 @@ private:
     /// Volk des Gebäudes (muss extra gespeichert werden, da ja auch z.B. fremde Gebäude erobert werden können)
     const Nation nation;
 
-public:
     fowBuilding(BuildingType type, Nation nation);
-    fowBuilding(SerializedGameData& sgd);
+    template<class T, typename... T_Values>
+    friend const T* detail::getShared(T_Values...);
+
+public:
+    /// Get the shared instance with the given values
+    static const fowBuilding* Get(BuildingType type, Nation nation);
+    static const fowBuilding* Deserialize(SerializedGameData& sgd);
     void Serialize(SerializedGameData& sgd) const override;
     void Draw(DrawPoint drawPt) const override;
     FoW_Type GetType() const override { return FoW_Type::Building; }
@@ -47,9 +58,14 @@ private:
     /// Gibt den Baufortschritt an, wie hoch das Gebäude schon gebaut ist, gemessen in 8 Stufen für jede verbaute Ware
     const unsigned char build_progress;
 
-public:
     fowBuildingSite(bool planing, BuildingType type, Nation nation, unsigned char build_progress);
-    fowBuildingSite(SerializedGameData& sgd);
+    template<class T, typename... T_Values>
+    friend const T* detail::getShared(T_Values...);
+
+public:
+    /// Get the shared instance with the given values
+    static const fowBuildingSite* Get(bool planing, BuildingType type, Nation nation, unsigned char build_progress);
+    static const fowBuildingSite* Deserialize(SerializedGameData& sgd);
     void Serialize(SerializedGameData& sgd) const override;
     void Draw(DrawPoint drawPt) const override;
     FoW_Type GetType() const override { return FoW_Type::Buildingsite; }
@@ -59,14 +75,21 @@ public:
 class fowFlag : public FOWObject
 {
 private:
+    /// Draw color, see CalcPlayerFOWDrawColor
     const unsigned color;
     const Nation nation;
     /// Flaggenart
     const FlagType flag_type;
 
+    fowFlag(unsigned drawColor, Nation nation, FlagType flag_type);
+    template<class T, typename... T_Values>
+    friend const T* detail::getShared(T_Values...);
+    static const fowFlag* GetWithDrawColor(unsigned drawColor, Nation nation, FlagType flag_type);
+
 public:
-    fowFlag(unsigned playerColor, Nation nation, FlagType flag_type);
-    fowFlag(SerializedGameData& sgd);
+    /// Get the shared instance with the given values. The player color is converted to the draw color
+    static const fowFlag* Get(unsigned playerColor, Nation nation, FlagType flag_type);
+    static const fowFlag* Deserialize(SerializedGameData& sgd);
     void Serialize(SerializedGameData& sgd) const override;
     void Draw(DrawPoint drawPt) const override;
     FoW_Type GetType() const override { return FoW_Type::Flag; }
@@ -81,9 +104,14 @@ private:
     /// Größe des Baumes (0-2, 3 = aufgewachsen!)
     const unsigned char size;
 
-public:
     fowTree(unsigned char type, unsigned char size);
-    fowTree(SerializedGameData& sgd);
+    template<class T, typename... T_Values>
+    friend const T* detail::getShared(T_Values...);
+
+public:
+    /// Get the shared instance with the given values
+    static const fowTree* Get(unsigned char type, unsigned char size);
+    static const fowTree* Deserialize(SerializedGameData& sgd);
     void Serialize(SerializedGameData& sgd) const override;
     void Draw(DrawPoint drawPt) const override;
     FoW_Type GetType() const override { return FoW_Type::Tree; }
@@ -96,9 +124,14 @@ private:
     const GraniteType type;    /// Welcher Typ ( gibt 2 )
     const unsigned char state; /// Status, 0 - 5, von sehr wenig bis sehr viel
 
-public:
     fowGranite(GraniteType type, unsigned char state);
-    fowGranite(SerializedGameData& sgd);
+    template<class T, typename... T_Values>
+    friend const T* detail::getShared(T_Values...);
+
+public:
+    /// Get the shared instance with the given values
+    static const fowGranite* Get(GraniteType type, unsigned char state);
+    static const fowGranite* Deserialize(SerializedGameData& sgd);
     void Serialize(SerializedGameData& sgd) const override;
     void Draw(DrawPoint drawPt) const override;
     FoW_Type GetType() const override { return FoW_Type::Granite; }
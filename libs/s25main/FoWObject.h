@@ -24,7 +24,9 @@ constexpr auto maxEnumValue(FoW_Type)
     return FoW_Type::Granite;
 }
 
-/// Visual object in the Fog of War which shows what a player has seen there
+/// Visual object in the Fog of War which shows what a player has seen there.
+/// The objects are immutable and there is only one instance per distinct value (see the Get functions in FOWObjects.h),
+/// which is shared by all nodes and players and lives until the program exits
 class FOWObject
 {
 public:
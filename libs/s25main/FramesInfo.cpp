@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "FramesInfo.h"
+#include <algorithm>
 
 FramesInfo::FramesInfo()
 {
@@ -20,6 +21,8 @@ void FramesInfo::Clear()
     isPaused = false;
 }
 
+constexpr unsigned FramesInfoClient::MAX_CATCHUP_GFS;
+
 FramesInfoClient::FramesInfoClient()
 {
     Clear();
@@ -31,3 +34,25 @@ void FramesInfoClient::Clear()
     forcePauseStart = UsedClock::time_point();
     forcePauseLen = milliseconds32_t::zero();
 }
+
+FramesInfo::milliseconds32_t FramesInfoClient::GetFrameTimeAt(const UsedClock::time_point currentTime) const
+{
+    if(currentTime <= lastTime)
+        return milliseconds32_t::zero();
+    // Clamp before converting as the time since the last GF may be too large for 32 bits
+    const UsedClock::duration maxFrameTime = gf_length - milliseconds32_t(1);
+    return std::chrono::duration_cast<milliseconds32_t>(std::min(currentTime - lastTime, maxFrameTime));
+}
+
+FramesInfo::UsedClock::time_point FramesInfoClient::GetNextGFTime(const UsedClock::time_point currentTime,
+                                                                  const UsedClock::duration maxWait) const
+{
+    UsedClock::time_point nextGFTime;
+    if(isPaused)
+        nextGFTime = currentTime + maxWait;
+    else if(forcePauseLen.count())
+        nextGFTime = forcePauseStart + forcePauseLen;
+    else
+        nextGFTime = lastTime + gf_length;
+    return std::min(nextGFTime, currentTime + maxWait);
+}
@@ -32,10 +32,44 @@ struct FramesInfo
 /// Same as FramesInfo but with additional data that is only meaningfull for the client
 struct FramesInfoClient : public FramesInfo
 {
+    /// Maximum number of GFs to run in one call to RunDueGFs
+    static constexpr unsigned MAX_CATCHUP_GFS = 10;
+
     FramesInfoClient();
     void Clear();
 
+    /// Run all GFs that are due at currentTime (catch up if the last call was too long ago) via runGF(isSkipping),
+    /// which must advance lastTime. While isSkipping() returns true a GF is always due, but only 1 is run per call.
+    /// Runs at most MAX_CATCHUP_GFS GFs, so drawing does not starve if the simulation cannot keep up at all.
+    /// Return false if runGF returned false (e.g. a player is lagging)
+    template<class T_IsSkipping, class T_RunGF>
+    bool RunDueGFs(UsedClock::time_point currentTime, const T_IsSkipping& isSkipping, const T_RunGF& runGF);
+    /// Time since the last GF at currentTime as used for interpolation when drawing (valid range: [0, gf_length) )
+    milliseconds32_t GetFrameTimeAt(UsedClock::time_point currentTime) const;
+    /// Time at which the next GF is due, but at most maxWait after currentTime to notice e.g. pauses in time
+    UsedClock::time_point GetNextGFTime(UsedClock::time_point currentTime, UsedClock::duration maxWait) const;
+
     /// Force pause the game (start TS and length) e.g. to compensate for lags
     UsedClock::time_point forcePauseStart;
     milliseconds32_t forcePauseLen;
 };
+
+template<class T_IsSkipping, class T_RunGF>
+bool FramesInfoClient::RunDueGFs(const UsedClock::time_point currentTime, const T_IsSkipping& isSkipping,
+                                 const T_RunGF& runGF)
+{
+    for(unsigned numGFs = 0; numGFs < MAX_CATCHUP_GFS; numGFs++)
+    {
+        const bool skipping = isSkipping();
+        // Is it time for the next GF? If we are skipping, it is always time for the next GF
+        if(!skipping && (currentTime - lastTime) < gf_length)
+            break;
+        if(!runGF(skipping))
+            return false;
+        // When skipping the caller runs us as often as required.
+        // Otherwise stop catching up when this took as long as a GF so the next frame can be drawn
+        if(skipping || isPaused || UsedClock::now() - currentTime >= gf_length)
+            break;
+    }
+    return true;
+}
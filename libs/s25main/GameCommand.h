@@ -93,6 +93,8 @@ public:
     /// Execute this GameCommand
     virtual void Execute(GameWorld& world, uint8_t playerId) = 0;
 
+    GCType GetType() const { return gcType; }
+
 protected:
     GameCommand(const GCType gcType) : gcType(gcType), refCounter_(0) {}
 };
@@ -0,0 +1,135 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameCommandProfiler.h"
+#include "EventManager.h"
+#include "helpers/EnumRange.h"
+#include "helpers/chronoIO.h"
+#include "world/GameWorld.h"
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+namespace {
+using microseconds_f = std::chrono::duration<double, std::micro>;
+using milliseconds_f = std::chrono::duration<double, std::milli>;
+} // namespace
+
+const char* gc::getName(GCType type)
+{
+    switch(type)
+    {
+        case GCType::SetFlag: return "SetFlag";
+        case GCType::DestroyFlag: return "DestroyFlag";
+        case GCType::BuildRoad: return "BuildRoad";
+        case GCType::DestroyRoad: return "DestroyRoad";
+        case GCType::ChangeDistribution: return "ChangeDistribution";
+        case GCType::ChangeBuildOrder: return "ChangeBuildOrder";
+        case GCType::SetBuildingsite: return "SetBuildingsite";
+        case GCType::DestroyBuilding: return "DestroyBuilding";
+        case GCType::ChangeTransport: return "ChangeTransport";
+        case GCType::ChangeMilitary: return "ChangeMilitary";
+        case GCType::ChangeTools: return "ChangeTools";
+        case GCType::CallSpecialist: return "CallSpecialist";
+        case GCType::CallScout: return "CallScout";
+        case GCType::Attack: return "Attack";
+        case GCType::SetCoinsAllowed: return "SetCoinsAllowed";
+        case GCType::SetProductionEnabled: return "SetProductionEnabled";
+        case GCType::SetInventorySetting: return "SetInventorySetting";
+        case GCType::SetAllInventorySettings: return "SetAllInventorySettings";
+        case GCType::ChangeReserve: return "ChangeReserve";
+        case GCType::SuggestPact: return "SuggestPact";
+        case GCType::AcceptPact: return "AcceptPact";
+        case GCType::CancelPact: return "CancelPact";
+        case GCType::SetShipyardMode: return "SetShipyardMode";
+        case GCType::StartStopExpedition: return "StartStopExpedition";
+        case GCType::ExpeditionCommand: return "ExpeditionCommand";
+        case GCType::SeaAttack: return "SeaAttack";
+        case GCType::StartStopExplorationExpedition: return "StartStopExplorationExpedition";
+        case GCType::Trade: return "Trade";
+        case GCType::Surrender: return "Surrender";
+        case GCType::CheatArmageddon: return "CheatArmageddon";
+        case GCType::DestroyAll: return "DestroyAll";
+        case GCType::UpgradeRoad: return "UpgradeRoad";
+        case GCType::SendSoldiersHome: return "SendSoldiersHome";
+        case GCType::OrderNewSoldiers: return "OrderNewSoldiers";
+        case GCType::NotifyAlliesOfLocation: return "NotifyAlliesOfLocation";
+        case GCType::SendWorstSoldiersHome: return "SendWorstSoldiersHome";
+        case GCType::SetMilitaryOverrideAllowed: return "SetMilitaryOverrideAllowed";
+    }
+    return "Unknown"; // LCOV_EXCL_LINE
+}
+
+GameCommandProfiler::Stats& GameCommandProfiler::Stats::operator+=(const Stats& rhs)
+{
+    count += rhs.count;
+    duration += rhs.duration;
+    numEventsAdded += rhs.numEventsAdded;
+    return *this;
+}
+
+void GameCommandProfiler::Execute(gc::GameCommand& gc, GameWorld& world, uint8_t playerId)
+{
+    const unsigned startEventCtr = world.GetEvMgr().GetEventInstanceCtr();
+    const clock::time_point startTime = clock::now();
+    gc.Execute(world, playerId);
+    Stats& stats = stats_[gc.GetType()];
+    stats.duration += clock::now() - startTime;
+    stats.numEventsAdded += world.GetEvMgr().GetEventInstanceCtr() - startEventCtr;
+    ++stats.count;
+}
+
+GameCommandProfiler::Stats GameCommandProfiler::GetTotal() const
+{
+    Stats result;
+    for(const Stats& stats : stats_)
+        result += stats;
+    return result;
+}
+
+void GameCommandProfiler::Clear()
+{
+    std::fill(stats_.begin(), stats_.end(), Stats());
+}
+
+void GameCommandProfiler::WriteCSV(std::ostream& os) const
+{
+    os << "command,count,total_us,avg_us,events_added\n";
+    for(const auto type : helpers::enumRange<gc::GCType>())
+    {
+        const Stats& stats = stats_[type];
+        if(!stats.count)
+            continue;
+        const microseconds_f duration = stats.duration;
+        os << getName(type) << ',' << stats.count << ',' << duration.count() << ','
+           << duration.count() / stats.count << ',' << stats.numEventsAdded << '\n';
+    }
+}
+
+void GameCommandProfiler::PrintSummary(std::ostream& os, unsigned maxEntries) const
+{
+    const Stats total = GetTotal();
+    os << "Executed " << total.count << " game commands in "
+       << helpers::withUnit(std::chrono::duration_cast<milliseconds_f>(total.duration)) << ", "
+       << total.numEventsAdded << " events added\n";
+
+    std::vector<gc::GCType> types;
+    for(const auto type : helpers::enumRange<gc::GCType>())
+    {
+        if(stats_[type].count)
+            types.push_back(type);
+    }
+    std::sort(types.begin(), types.end(),
+              [this](gc::GCType lhs, gc::GCType rhs) { return stats_[lhs].duration > stats_[rhs].duration; });
+    if(types.size() > maxEntries)
+        types.resize(maxEntries);
+    for(const auto type : types)
+    {
+        const Stats& stats = stats_[type];
+        const microseconds_f duration = stats.duration;
+        os << "  " << getName(type) << ": " << stats.count << "x, "
+           << helpers::withUnit(std::chrono::duration_cast<milliseconds_f>(duration)) << " total, "
+           << helpers::withUnit(duration / stats.count) << " avg, " << stats.numEventsAdded << " events\n";
+    }
+}
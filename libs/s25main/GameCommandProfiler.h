@@ -0,0 +1,52 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "GameCommand.h"
+#include "helpers/EnumArray.h"
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+class GameWorld;
+
+/// Executes GameCommands and keeps track of how expensive each type of command is:
+/// How often it was executed, how long that took and how many events were scheduled by it
+class GameCommandProfiler
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Stats
+    {
+        unsigned count = 0;
+        clock::duration duration = clock::duration::zero();
+        /// Number of events added to the event manager while executing the commands
+        unsigned numEventsAdded = 0;
+
+        Stats& operator+=(const Stats& rhs);
+    };
+
+    /// Execute the command and record its cost
+    void Execute(gc::GameCommand& gc, GameWorld& world, uint8_t playerId);
+
+    const Stats& GetStats(gc::GCType type) const { return stats_[type]; }
+    /// Sum of the stats of all command types
+    Stats GetTotal() const;
+    void Clear();
+
+    /// Write the stats of all executed command types as CSV including a header line
+    void WriteCSV(std::ostream& os) const;
+    /// Write a human readable summary of the command types with the highest total duration
+    void PrintSummary(std::ostream& os, unsigned maxEntries = 10) const;
+
+private:
+    helpers::EnumArray<Stats, gc::GCType> stats_;
+};
+
+namespace gc {
+/// Name of the command type, e.g. for output
+const char* getName(GCType type);
+} // namespace gc
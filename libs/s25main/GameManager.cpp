@@ -23,6 +23,8 @@
 #include "s25util/Log.h"
 #include "s25util/error.h"
 #include <boost/pointer_cast.hpp>
+#include <chrono>
+#include <thread>
 
 GameManager::GameManager(Log& log, Settings& settings, VideoDriverWrapper& videoDriver, AudioDriverWrapper& audioDriver,
                          WindowManager& windowManager)
@@ -40,6 +42,12 @@ bool GameManager::Start()
     // Einstellungen laden
     settings_.Load();
 
+    // Keep the network responsive even when drawing a frame takes long
+    GAMECLIENT.SetUseNetworkThread(true);
+    GAMESERVER.SetUseNetworkThread(true);
+    // Don't let slow frames slow down the game (and vice versa)
+    GAMECLIENT.SetUseSimulationThread(true);
+
     /// Videotreiber laden
     if(!videoDriver_.LoadDriver(settings_.driver.video))
     {
@@ -93,6 +101,10 @@ void GameManager::Stop()
  */
 bool GameManager::Run()
 {
+    // Input handling and drawing must see the state of a single GF, so keep the simulation thread out until the frame
+    // is drawn
+    auto worldLock = GAMECLIENT.LockWorld();
+
     // Nachrichtenschleife
     if(!videoDriver_.Run())
         GLOBALVARS.notdone = false;
@@ -111,20 +123,21 @@ bool GameManager::Run()
         const unsigned curGF = GAMECLIENT.GetGFNumber();
         if(targetSkipGF > curGF)
         {
-            if(curGF % 5000 == 0)
+            if(!lastSkipReport)
             {
-                if(lastSkipReport)
-                {
-                    // Elapsed time in ms
-                    const auto timeDiff = static_cast<double>(current_time - lastSkipReport->time);
-                    const unsigned numGFPassed = curGF - lastSkipReport->gf;
-                    log_.write(_("jumping to gf %i, now at gf %i, time for last 5k gf: %.3f s, avg gf time %.3f ms \n"))
-                      % targetSkipGF % curGF % (timeDiff / 1000) % (timeDiff / numGFPassed);
-                } else
+                if(curGF % 5000 == 0)
                     log_.write(_("jumping to gf %i, now at gf %i \n")) % targetSkipGF % curGF;
                 lastSkipReport = SkipReport{current_time, curGF};
-            } else if(!lastSkipReport)
+            } else if(curGF / 5000 > lastSkipReport->gf / 5000)
+            {
+                // The simulation thread may run many GFs per frame, so report whenever the next 5k GFs are passed
+                // Elapsed time in ms
+                const auto timeDiff = static_cast<double>(current_time - lastSkipReport->time);
+                const unsigned numGFPassed = curGF - lastSkipReport->gf;
+                log_.write(_("jumping to gf %i, now at gf %i, time for last 5k gf: %.3f s, avg gf time %.3f ms \n"))
+                  % targetSkipGF % curGF % (timeDiff / 1000) % (timeDiff / numGFPassed);
                 lastSkipReport = SkipReport{current_time, curGF};
+            }
         } else
         {
             // Jump just completed
@@ -141,17 +154,26 @@ bool GameManager::Run()
                 log_.write(_("jump to gf %1% complete\n")) % targetSkipGF;
             }
         }
+        // Nothing is drawn, so give the simulation thread the time to jump
+        worldLock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     } else
     {
         videoDriver_.ClearScreen();
         windowManager_.Draw();
+        // The simulation can continue while waiting for the buffer swap (e.g. VSync)
+        worldLock.unlock();
         videoDriver_.SwapBuffers();
     }
     gfCounter_.update();
 
     // Fenstermanager aufräumen
     if(!GLOBALVARS.notdone)
+    {
+        // The windows may still reference the game
+        worldLock.lock();
         windowManager_.CleanUp();
+    }
 
     return GLOBALVARS.notdone;
 }
@@ -148,6 +148,7 @@ void GamePlayer::LoadStandardDistribution()
     }
 }
 
+GamePlayer::GamePlayer(GamePlayer&&) = default;
 GamePlayer::~GamePlayer() = default;
 
 void GamePlayer::Serialize(SerializedGameData& sgd) const
@@ -468,7 +469,7 @@ void GamePlayer::AddRoad(RoadSegment* rs)
 
 void GamePlayer::DeleteRoad(RoadSegment* rs)
 {
-    RTTR_Assert(helpers::contains(roads, rs));
+    RTTR_Assert(roads.contains(rs));
     roads.remove(rs);
 }
 
@@ -1256,9 +1257,20 @@ void GamePlayer::CallFlagWorker(const MapPoint pt, const Job job)
         wh->OrderJob(job, flag, true);
 }
 
-bool GamePlayer::IsFlagWorker(const nofFlagWorker* flagworker)
+void GamePlayer::RegisterFlagWorker(nofFlagWorker* flagworker)
 {
-    return helpers::contains(flagworkers, flagworker);
+    flagworkers.push_back(flagworker);
+}
+
+void GamePlayer::RemoveFlagWorker(nofFlagWorker* flagworker)
+{
+    RTTR_Assert(IsFlagWorker(flagworker));
+    flagworkers.remove(flagworker);
+}
+
+bool GamePlayer::IsFlagWorker(const nofFlagWorker* flagworker) const
+{
+    return flagworkers.contains(flagworker);
 }
 
 void GamePlayer::FlagDestroyed(noFlag* flag)
@@ -1542,7 +1554,7 @@ void GamePlayer::SuggestPact(const unsigned char targetPlayerId, const PactType
         pacts[targetPlayerId][pt].accepted = false;
         pacts[targetPlayerId][pt].duration = duration;
         pacts[targetPlayerId][pt].start = world.GetEvMgr().GetCurrentGF();
-        GamePlayer targetPlayer = world.GetPlayer(targetPlayerId);
+        GamePlayer& targetPlayer = world.GetPlayer(targetPlayerId);
         if(targetPlayer.isHuman())
             targetPlayer.SendPostMessage(std::make_unique<DiplomacyPostQuestion>(
               world.GetEvMgr().GetCurrentGF(), pt, pacts[targetPlayerId][pt].start, *this, duration));
@@ -1716,9 +1728,20 @@ void GamePlayer::MakeStartPacts()
     }
 }
 
-bool GamePlayer::IsWareRegistred(const Ware& ware)
+void GamePlayer::RegisterWare(Ware& ware)
+{
+    ware_list.push_back(&ware);
+}
+
+void GamePlayer::RemoveWare(Ware& ware)
+{
+    RTTR_Assert(IsWareRegistred(ware));
+    ware_list.remove(&ware);
+}
+
+bool GamePlayer::IsWareRegistred(const Ware& ware) const
 {
-    return helpers::contains(ware_list, &ware);
+    return ware_list.contains(&ware);
 }
 
 bool GamePlayer::IsWareDependent(const Ware& ware)
@@ -7,6 +7,7 @@
 #include "BuildingRegister.h"
 #include "GamePlayerInfo.h"
 #include "helpers/EnumArray.h"
+#include "helpers/IntrusiveList.h"
 #include "helpers/MultiArray.h"
 #include "gameTypes/BuildingType.h"
 #include "gameTypes/Inventory.h"
@@ -80,6 +81,7 @@ public:
     };
 
     GamePlayer(unsigned playerId, const PlayerInfo& playerInfo, GameWorld& world);
+    GamePlayer(GamePlayer&&);
     ~GamePlayer();
 
     /// Serialisieren
@@ -166,13 +168,9 @@ public:
     void ConvertTransportData(const TransportOrders& transport_data);
 
     /// Ware zur globalen Warenliste hinzufügen und entfernen
-    void RegisterWare(Ware& ware) { ware_list.push_back(&ware); }
-    void RemoveWare(Ware& ware)
-    {
-        RTTR_Assert(IsWareRegistred(ware));
-        ware_list.remove(&ware);
-    }
-    bool IsWareRegistred(const Ware& ware);
+    void RegisterWare(Ware& ware);
+    void RemoveWare(Ware& ware);
+    bool IsWareRegistred(const Ware& ware) const;
     bool IsWareDependent(const Ware& ware);
 
     /// Fügt Waren zur Inventur hinzu
@@ -216,13 +214,9 @@ public:
     void CallFlagWorker(MapPoint pt, Job job);
     /// Registriert einen Geologen bzw. einen Späher an einer bestimmten Flagge, damit diese informiert werden,
     /// wenn die Flagge abgerissen wird
-    void RegisterFlagWorker(nofFlagWorker* flagworker) { flagworkers.push_back(flagworker); }
-    void RemoveFlagWorker(nofFlagWorker* flagworker)
-    {
-        RTTR_Assert(IsFlagWorker(flagworker));
-        flagworkers.remove(flagworker);
-    }
-    bool IsFlagWorker(const nofFlagWorker* flagworker);
+    void RegisterFlagWorker(nofFlagWorker* flagworker);
+    void RemoveFlagWorker(nofFlagWorker* flagworker);
+    bool IsFlagWorker(const nofFlagWorker* flagworker) const;
 
     /// Wird aufgerufen, wenn eine Flagge abgerissen wurde, damit das den Flaggen-Arbeitern gesagt werden kann
     void FlagDestroyed(noFlag* flag);
@@ -341,7 +335,7 @@ private:
     BuildingRegister buildings; //-V730_NOINIT
 
     /// Lister aller Straßen von dem Spieler
-    std::list<RoadSegment*> roads;
+    helpers::IntrusiveList<RoadSegment> roads;
 
     struct JobNeeded
     {
@@ -353,9 +347,9 @@ private:
     std::list<JobNeeded> jobs_wanted;
 
     /// Liste von sämtlichen Waren, die herumgetragen werden und an Fahnen liegen
-    std::list<Ware*> ware_list;
+    helpers::IntrusiveList<Ware> ware_list;
     /// Liste von Geologen und Spähern, die an eine Flagge gebunden sind
-    std::list<nofFlagWorker*> flagworkers;
+    helpers::IntrusiveList<nofFlagWorker> flagworkers;
     /// Liste von Schiffen dieses Spielers
     std::vector<noShip*> ships;
 
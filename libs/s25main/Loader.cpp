@@ -15,6 +15,7 @@
 #include "files.h"
 #include "helpers/EnumRange.h"
 #include "helpers/containerUtils.h"
+#include "helpers/parallelFor.h"
 #include "ogl/MusicItem.h"
 #include "ogl/SoundEffectItem.h"
 #include "ogl/glArchivItem_Bitmap_Player.h"
@@ -44,6 +45,7 @@
 #include "s25util/StringConversion.h"
 #include "s25util/System.h"
 #include "s25util/strAlgos.h"
+#include <boost/container_hash/hash.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/pointer_cast.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -62,6 +64,15 @@ struct Loader::FileEntry
     ResolvedFile resolvedFile;
 };
 
+struct Loader::LoadRequest
+{
+    ResourceId id;
+    ResolvedFile resolvedFile;
+    const libsiedler2::ArchivItem_Palette* palette;
+    libsiedler2::Archiv archive;
+    bool failed;
+};
+
 template<typename T>
 static T convertChecked(libsiedler2::ArchivItem* item)
 {
@@ -211,13 +222,23 @@ bool Loader::LoadFilesAtStart()
             files.push_back((loadScreenFolders[1] / filename).string());
     }
 
-    if(!LoadFiles(files))
-        return false;
-
-    if(!LoadSounds())
+    const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
+    std::vector<LoadRequest> requests;
+    for(const std::string& curFile : files)
+    {
+        if(!AddLoadRequest(requests, config_.ExpandPath(curFile), pal5))
+            return false;
+    }
+    const std::vector<ResourceId> resources = {"io_new", "client", "languages", "logo", "menu", "rttr"};
+    for(const ResourceId& curResource : resources)
+    {
+        if(!AddLoadRequest(requests, curResource, pal5))
+            return false;
+    }
+    if(!LoadRequests(requests))
         return false;
 
-    return LoadResources({"io_new", "client", "languages", "logo", "menu", "rttr"});
+    return LoadSounds();
 }
 
 bool Loader::LoadSounds()
@@ -441,27 +462,47 @@ bool Loader::LoadFilesAtGame(const std::string& mapGfxPath, bool isWinterGFX, co
 
     const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
 
-    if(!LoadFiles(files) || !Load(ResourceId("map_new"), pal5))
+    // All files are independent of each other, so collect them first and decode them at once
+    std::vector<LoadRequest> requests;
+    for(const std::string& curFile : files)
+    {
+        if(!AddLoadRequest(requests, config_.ExpandPath(curFile), pal5))
+            return false;
+    }
+    if(!AddLoadRequest(requests, ResourceId("map_new"), pal5))
         return false;
 
-    // Load nation building and icon graphics
-    nation_gfx = nationIcons_ = {};
+    // Nation building and icon graphics
     for(Nation nation : nations)
     {
         const auto resourceSource = getNationResourcesSource(nation, isWinterGFX, config_);
-        if(!Load(resourceSource.buildingsFilePath, pal5) || !Load(resourceSource.iconsFilePath, pal5))
+        if(!AddLoadRequest(requests, resourceSource.buildingsFilePath, pal5)
+           || !AddLoadRequest(requests, resourceSource.iconsFilePath, pal5))
             return false;
-        nation_gfx[nation] = &files_[ResourceId::make(resourceSource.buildingsFilePath)].archive;
-        nationIcons_[nation] = &files_[ResourceId::make(resourceSource.iconsFilePath)].archive;
     }
 
     // TODO: Move to addon folder and make it overwrite existing file
-    if(!LoadResources({"charburner", "charburner_bobs"}))
-        return false;
+    const std::vector<ResourceId> resources = {"charburner", "charburner_bobs"};
+    for(const ResourceId& curResource : resources)
+    {
+        if(!AddLoadRequest(requests, curResource, pal5))
+            return false;
+    }
 
     const bfs::path mapGFXFile = config_.ExpandPath(mapGfxPath);
-    if(!Load(mapGFXFile, pal5))
+    if(!AddLoadRequest(requests, mapGFXFile, pal5))
         return false;
+
+    if(!LoadRequests(requests))
+        return false;
+
+    nation_gfx = nationIcons_ = {};
+    for(Nation nation : nations)
+    {
+        const auto resourceSource = getNationResourcesSource(nation, isWinterGFX, config_);
+        nation_gfx[nation] = &files_[ResourceId::make(resourceSource.buildingsFilePath)].archive;
+        nationIcons_[nation] = &files_[ResourceId::make(resourceSource.iconsFilePath)].archive;
+    }
     map_gfx = &GetArchive(ResourceId::make(mapGFXFile));
 
     isWinterGFX_ = isWinterGFX;
@@ -472,33 +513,25 @@ bool Loader::LoadFilesAtGame(const std::string& mapGfxPath, bool isWinterGFX, co
 bool Loader::LoadFiles(const std::vector<std::string>& files)
 {
     const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
-    // load the files
+    std::vector<LoadRequest> requests;
     for(const std::string& curFile : files)
     {
-        const bfs::path filePath = config_.ExpandPath(curFile);
-        if(!Load(filePath, pal5))
-        {
-            logger_.write(_("Failed to load %s\n")) % filePath;
+        if(!AddLoadRequest(requests, config_.ExpandPath(curFile), pal5))
             return false;
-        }
     }
-
-    return true;
+    return LoadRequests(requests);
 }
 
 bool Loader::LoadResources(const std::vector<ResourceId>& resources)
 {
     const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
+    std::vector<LoadRequest> requests;
     for(const ResourceId& curResource : resources)
     {
-        if(!Load(curResource, pal5))
-        {
-            logger_.write(_("Failed to load %s\n")) % curResource;
+        if(!AddLoadRequest(requests, curResource, pal5))
             return false;
-        }
     }
-
-    return true;
+    return LoadRequests(requests);
 }
 
 void Loader::fillCaches()
@@ -908,12 +941,65 @@ void Loader::fillCaches()
 
     if(SETTINGS.video.shared_textures)
     {
-        // generate mega texture
-        stp->pack();
+        // Try to reuse the mega texture of the last run, else generate and store it
+        const bfs::path cacheFilePath = config_.ExpandPath(s25::folders::cache) / "sprites.cache";
+        const uint64_t cacheKey = CalcSpriteCacheKey();
+        if(!stp->loadCache(cacheFilePath, cacheKey) && stp->pack(true))
+        {
+            boost::system::error_code ec;
+            bfs::create_directories(cacheFilePath.parent_path(), ec);
+            if(!stp->saveCache(cacheFilePath, cacheKey))
+                logger_.write(_("Could not write sprite cache %1%\n")) % cacheFilePath;
+        }
     } else
         stp.reset();
 }
 
+namespace {
+/// Add the identity of the file or all files in the directory (name, size, modification time) to the hash
+void hashFileIdentity(size_t& hash, const bfs::path& filePath)
+{
+    boost::system::error_code ec;
+    if(bfs::is_directory(filePath, ec))
+    {
+        std::vector<bfs::path> entries;
+        for(const auto& entry : bfs::recursive_directory_iterator(filePath, ec))
+            entries.push_back(entry.path());
+        // Iteration order is unspecified
+        std::sort(entries.begin(), entries.end());
+        for(const bfs::path& entry : entries)
+        {
+            if(!bfs::is_directory(entry, ec))
+                hashFileIdentity(hash, entry);
+        }
+        return;
+    }
+    boost::hash_combine(hash, filePath.string());
+    boost::hash_combine(hash, bfs::file_size(filePath, ec));
+    boost::hash_combine(hash, bfs::last_write_time(filePath, ec));
+}
+} // namespace
+
+uint64_t Loader::CalcSpriteCacheKey() const
+{
+    size_t hash = 0;
+    boost::hash_combine(hash, isWinterGFX_);
+    for(const auto nation : helpers::enumRange<Nation>())
+        boost::hash_combine(hash, nation_gfx[nation] != nullptr);
+    // The override folders (nation, addon and user overrides) decide which sprites replace the original ones
+    for(const auto& overrideFolder : archiveLocator_->getOverrideFolders())
+    {
+        boost::hash_combine(hash, overrideFolder.path.string());
+        hashFileIdentity(hash, overrideFolder.path);
+    }
+    for(const auto& entry : files_)
+    {
+        for(const bfs::path& filePath : entry.second.resolvedFile)
+            hashFileIdentity(hash, filePath);
+    }
+    return hash;
+}
+
 /**
  *  Extrahiert eine Textur aus den Daten.
  */
@@ -1003,30 +1089,68 @@ bool Loader::Load(libsiedler2::Archiv& archive, const ResourceId& resId, const l
 }
 
 template<typename T>
-bool Loader::LoadImpl(const T& resIdOrPath, const libsiedler2::ArchivItem_Palette* palette)
+bool Loader::AddLoadRequest(std::vector<LoadRequest>& requests, const T& resIdOrPath,
+                            const libsiedler2::ArchivItem_Palette* palette)
 {
-    const auto resolvedFile = archiveLocator_->resolve(resIdOrPath);
+    auto resolvedFile = archiveLocator_->resolve(resIdOrPath);
     if(!resolvedFile)
     {
         logger_.write(_("Failed to resolve resource %1%\n")) % resIdOrPath;
         return false;
     }
-    FileEntry& entry = files_[ResourceId::make(resIdOrPath)];
+    const ResourceId id = ResourceId::make(resIdOrPath);
     // Do we really need to reload or can we reused the loaded version?
-    if(entry.resolvedFile != resolvedFile)
+    const auto itEntry = files_.find(id);
+    if(itEntry != files_.end() && itEntry->second.resolvedFile == resolvedFile)
     {
+        RTTR_Assert(!itEntry->second.archive.empty());
+        return true;
+    }
+    const bool isQueued = helpers::contains_if(requests, [&id](const LoadRequest& request) { return request.id == id; });
+    if(!isQueued)
+        requests.push_back(LoadRequest{id, std::move(resolvedFile), palette, libsiedler2::Archiv(), false});
+    return true;
+}
+
+bool Loader::LoadRequests(std::vector<LoadRequest>& requests)
+{
+    // Decoding and palette conversion does not touch the GL context (textures are created lazily on first use by the
+    // render thread) and the archive loader is thread-safe, so files can be decoded in parallel
+    helpers::parallelFor(static_cast<unsigned>(requests.size()), [this, &requests](unsigned i) {
+        LoadRequest& request = requests[i];
         try
         {
-            entry.archive = archiveLoader_->load(resolvedFile, palette);
+            request.archive = archiveLoader_->load(request.resolvedFile, request.palette);
         } catch(const LoadError&)
         {
-            return false;
+            request.failed = true;
         }
+    });
+
+    // Store results in request order so the outcome does not depend on thread scheduling
+    bool result = true;
+    for(LoadRequest& request : requests)
+    {
+        if(request.failed)
+        {
+            logger_.write(_("Failed to load %s\n")) % request.id;
+            result = false;
+            continue;
+        }
+        FileEntry& entry = files_[request.id];
+        entry.archive = std::move(request.archive);
         // Update how we loaded this
-        entry.resolvedFile = resolvedFile;
+        entry.resolvedFile = std::move(request.resolvedFile);
+        RTTR_Assert(!entry.archive.empty());
     }
-    RTTR_Assert(!entry.archive.empty());
-    return true;
+    return result;
+}
+
+template<typename T>
+bool Loader::LoadImpl(const T& resIdOrPath, const libsiedler2::ArchivItem_Palette* palette)
+{
+    std::vector<LoadRequest> requests;
+    return AddLoadRequest(requests, resIdOrPath, palette) && LoadRequests(requests);
 }
 
 bool Loader::Load(const bfs::path& path, const libsiedler2::ArchivItem_Palette* palette)
@@ -225,7 +225,17 @@ public:
 private:
     /// Load all sounds
     bool LoadSounds();
+    /// Calculate a key identifying the sources of the sprites in the caches (files, nations, winter gfx)
+    uint64_t CalcSpriteCacheKey() const;
 
+    /// A file to be loaded by LoadRequests
+    struct LoadRequest;
+    /// Resolve the given file and add it to the requests unless it is already loaded from the same source
+    template<typename T>
+    bool AddLoadRequest(std::vector<LoadRequest>& requests, const T& resIdOrPath,
+                        const libsiedler2::ArchivItem_Palette* palette);
+    /// Decode all requested files in parallel and store them in files_ in request order
+    bool LoadRequests(std::vector<LoadRequest>& requests);
     template<typename T>
     bool LoadImpl(const T& resIdOrPath, const libsiedler2::ArchivItem_Palette* palette);
 
@@ -0,0 +1,221 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "MapCatalog.h"
+#include "ListDir.h"
+#include "commonDefines.h"
+#include "helpers/containerUtils.h"
+#include "libsiedler2/Archiv.h"
+#include "libsiedler2/ArchivItem_Map.h"
+#include "libsiedler2/ArchivItem_Map_Header.h"
+#include "libsiedler2/ErrorCodes.h"
+#include "libsiedler2/prototypen.h"
+#include "s25util/BinaryFile.h"
+#include "s25util/utf8.h"
+#include <boost/filesystem/operations.hpp>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace bfs = boost::filesystem;
+
+namespace {
+constexpr auto catalogFileId = "RTTRMapCatalog";
+
+void writeUInt64(BinaryFile& file, uint64_t value)
+{
+    file.WriteUnsignedInt(static_cast<uint32_t>(value));
+    file.WriteUnsignedInt(static_cast<uint32_t>(value >> 32));
+}
+
+uint64_t readUInt64(BinaryFile& file)
+{
+    const uint64_t low = file.ReadUnsignedInt();
+    return low | (static_cast<uint64_t>(file.ReadUnsignedInt()) << 32);
+}
+} // namespace
+
+MapCatalog::MapCatalog(bfs::path catalogFilePath) : catalogFilePath_(std::move(catalogFilePath)) {}
+
+MapCatalog::~MapCatalog()
+{
+    save();
+}
+
+void MapCatalog::startScan(std::vector<bfs::path> folders)
+{
+    stopScan();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        newEntries_.clear();
+        isScanning_ = true;
+    }
+    stop_ = false;
+    thread_ = std::thread([this, folders = std::move(folders)]() { scan(folders); });
+}
+
+void MapCatalog::stopScan()
+{
+    stop_ = true;
+    if(thread_.joinable())
+        thread_.join();
+}
+
+bool MapCatalog::isScanning() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return isScanning_;
+}
+
+std::vector<MapCatalog::Entry> MapCatalog::fetchEntries()
+{
+    std::vector<Entry> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(result, newEntries_);
+    return result;
+}
+
+void MapCatalog::scan(const std::vector<bfs::path>& folders)
+{
+    if(!isLoaded_)
+        load();
+    for(const bfs::path& folder : folders)
+    {
+        std::set<std::string> foundFiles;
+        for(const char* extension : {"swd", "wld"})
+        {
+            for(const bfs::path& filePath : ListDir(folder, extension))
+            {
+                if(stop_)
+                    break;
+                foundFiles.insert(filePath.string());
+                Entry entry = getEntry(filePath);
+                std::lock_guard<std::mutex> lock(mutex_);
+                newEntries_.push_back(std::move(entry));
+            }
+        }
+        if(stop_)
+            break;
+        // Forget about removed maps
+        const bfs::path preferredFolder = bfs::path(folder).make_preferred();
+        for(auto it = knownEntries_.begin(); it != knownEntries_.end();)
+        {
+            if(it->second.filePath.parent_path() == preferredFolder && !helpers::contains(foundFiles, it->first))
+            {
+                it = knownEntries_.erase(it);
+                isModified_ = true;
+            } else
+                ++it;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    isScanning_ = false;
+}
+
+MapCatalog::Entry MapCatalog::getEntry(const bfs::path& filePath)
+{
+    boost::system::error_code ec;
+    const std::time_t lastWriteTime = bfs::last_write_time(filePath, ec);
+    const uintmax_t fileSize = ec ? 0 : bfs::file_size(filePath, ec);
+    const bool hasLua = bfs::is_regular_file(bfs::path(filePath).replace_extension("lua"));
+
+    auto it = knownEntries_.find(filePath.string());
+    if(!ec && it != knownEntries_.end() && it->second.lastWriteTime == lastWriteTime
+       && it->second.fileSize == fileSize)
+    {
+        it->second.hasLua = hasLua;
+        return it->second;
+    }
+
+    Entry entry;
+    entry.filePath = filePath;
+    entry.lastWriteTime = lastWriteTime;
+    entry.fileSize = fileSize;
+    entry.hasLua = hasLua;
+    libsiedler2::Archiv map;
+    if(int loadEc = libsiedler2::loader::LoadMAP(filePath, map, true))
+        entry.error = libsiedler2::getErrorString(loadEc);
+    else
+    {
+        const libsiedler2::ArchivItem_Map_Header& header =
+          checkedCast<const libsiedler2::ArchivItem_Map*>(map[0])->getHeader();
+        entry.name = s25util::ansiToUTF8(header.getName());
+        entry.author = s25util::ansiToUTF8(header.getAuthor());
+        entry.numPlayers = header.getNumPlayers();
+        entry.gfxSet = header.getGfxSet();
+        entry.width = header.getWidth();
+        entry.height = header.getHeight();
+    }
+    // Don't store entries of files which could not be accessed so they are retried next time
+    if(!ec)
+    {
+        knownEntries_[filePath.string()] = entry;
+        isModified_ = true;
+    }
+    return entry;
+}
+
+void MapCatalog::load()
+{
+    isLoaded_ = true;
+    BinaryFile file;
+    if(!bfs::exists(catalogFilePath_) || !file.Open(catalogFilePath_, OFM_READ))
+        return;
+    try
+    {
+        if(file.ReadShortString() != catalogFileId || file.ReadUnsignedShort() != catalogVersion)
+            return;
+        const unsigned numEntries = file.ReadUnsignedInt();
+        for(unsigned i = 0; i < numEntries; i++)
+        {
+            Entry entry;
+            entry.filePath = file.ReadLongString();
+            entry.lastWriteTime = static_cast<std::time_t>(readUInt64(file));
+            entry.fileSize = readUInt64(file);
+            entry.name = file.ReadLongString();
+            entry.author = file.ReadLongString();
+            entry.numPlayers = file.ReadUnsignedChar();
+            entry.gfxSet = file.ReadUnsignedChar();
+            entry.width = file.ReadUnsignedShort();
+            entry.height = file.ReadUnsignedShort();
+            entry.error = file.ReadLongString();
+            knownEntries_[entry.filePath.string()] = std::move(entry);
+        }
+    } catch(const std::runtime_error&)
+    {
+        // Corrupt catalog: Start from scratch
+        knownEntries_.clear();
+    }
+}
+
+bool MapCatalog::save()
+{
+    stopScan();
+    if(!isModified_)
+        return true;
+    boost::system::error_code ec;
+    bfs::create_directories(catalogFilePath_.parent_path(), ec);
+    BinaryFile file;
+    if(!file.Open(catalogFilePath_, OFM_WRITE))
+        return false;
+    file.WriteShortString(catalogFileId);
+    file.WriteUnsignedShort(catalogVersion);
+    file.WriteUnsignedInt(static_cast<unsigned>(knownEntries_.size()));
+    for(const auto& it : knownEntries_)
+    {
+        const Entry& entry = it.second;
+        file.WriteLongString(it.first);
+        writeUInt64(file, static_cast<uint64_t>(entry.lastWriteTime));
+        writeUInt64(file, entry.fileSize);
+        file.WriteLongString(entry.name);
+        file.WriteLongString(entry.author);
+        file.WriteUnsignedChar(entry.numPlayers);
+        file.WriteUnsignedChar(entry.gfxSet);
+        file.WriteUnsignedShort(entry.width);
+        file.WriteUnsignedShort(entry.height);
+        file.WriteLongString(entry.error);
+    }
+    isModified_ = false;
+    return true;
+}
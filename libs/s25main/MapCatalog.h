@@ -0,0 +1,75 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Header information of the maps in a set of folders which is gathered by a background thread.
+/// Known maps are stored in a catalog file and only read again when their size or modification time changed.
+class MapCatalog
+{
+public:
+    struct Entry
+    {
+        boost::filesystem::path filePath;
+        /// Modification time and size of the file when the entry was created
+        std::time_t lastWriteTime = 0;
+        uintmax_t fileSize = 0;
+        /// Name and author as UTF-8
+        std::string name, author;
+        unsigned char numPlayers = 0, gfxSet = 0;
+        unsigned short width = 0, height = 0;
+        /// True if there is a lua script next to the map. Checked on every scan
+        bool hasLua = false;
+        /// Reason why the map could not be loaded or empty if it is valid
+        std::string error;
+    };
+
+    explicit MapCatalog(boost::filesystem::path catalogFilePath);
+    /// Stops the scan and saves the catalog
+    ~MapCatalog();
+
+    /// Start listing the maps (SWD and WLD) in the given folders in the background.
+    /// Entries of a previous scan not yet fetched are discarded
+    void startScan(std::vector<boost::filesystem::path> folders);
+    /// Stop the current scan (if any) and wait for the background thread to finish
+    void stopScan();
+    /// Return true while a scan is running.
+    /// When this returns false, the next fetchEntries call returns all remaining entries of the last scan.
+    bool isScanning() const;
+    /// Return the entries found since the last call
+    std::vector<Entry> fetchEntries();
+
+    /// Write the catalog file if there were any changes. Stops any running scan
+    bool save();
+
+private:
+    /// Version of the catalog file. Increase when the format changes to ignore outdated files
+    static constexpr unsigned short catalogVersion = 1;
+
+    void scan(const std::vector<boost::filesystem::path>& folders);
+    Entry getEntry(const boost::filesystem::path& filePath);
+    void load();
+
+    boost::filesystem::path catalogFilePath_;
+    /// Known entries by their path. Only accessed by the scan thread while it is running
+    std::map<std::string, Entry> knownEntries_;
+    bool isLoaded_ = false, isModified_ = false;
+
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+    /// Guards the members below
+    mutable std::mutex mutex_;
+    std::vector<Entry> newEntries_;
+    bool isScanning_ = false;
+};
@@ -38,12 +38,12 @@ void PreviewMinimap::SetMap(const libsiedler2::ArchivItem_Map& s2map)
     else
         CalcShadows(s2map.getLayer(MapLayer::Altitude));
 
-    WorldDescription worldDesc;
-    GameDataLoader gdLoader(worldDesc);
-    if(!gdLoader.Load())
+    const auto gameData = loadSharedGameData();
+    if(!gameData)
         LOG.write(_("Failed to load game data!"));
     else
     {
+        const WorldDescription& worldDesc = *gameData;
         DescIdx<LandscapeDesc> lt(0);
         for(DescIdx<LandscapeDesc> i(0); i.value < worldDesc.landscapes.size(); i.value++)
         {
@@ -5,11 +5,56 @@
 #include "Replay.h"
 #include "Savegame.h"
 #include "network/PlayerGameCommands.h"
+#include "gameTypes/CompressedData.h"
 #include "gameTypes/MapInfo.h"
 #include <s25util/tmpFile.h>
 #include <boost/filesystem.hpp>
 #include <memory>
 #include <mygettext/mygettext.h>
+#include <stdexcept>
+
+namespace {
+/// A block is written when it reaches this size...
+constexpr unsigned MAX_BLOCK_SIZE = 64 * 1024;
+/// ... or contains commands of that many GFs, so a crashed game leaves a usable replay
+constexpr unsigned MAX_BLOCK_GFS = 1000;
+
+void pushVarUInt(Serializer& ser, uint32_t value)
+{
+    while(value >= 0x80)
+    {
+        ser.PushUnsignedChar(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    ser.PushUnsignedChar(static_cast<uint8_t>(value));
+}
+
+uint32_t popVarUInt(Serializer& ser)
+{
+    uint32_t result = 0;
+    for(unsigned shift = 0; shift < 32; shift += 7)
+    {
+        const uint8_t curByte = ser.PopUnsignedChar();
+        result |= static_cast<uint32_t>(curByte & 0x7F) << shift;
+        if(!(curByte & 0x80))
+            return result;
+    }
+    throw std::runtime_error("Invalid variable length value in replay");
+}
+
+/// Store the difference of 2 (wrapping) counters, small in both directions
+void pushDelta(Serializer& ser, uint32_t value, uint32_t prevValue)
+{
+    const auto diff = static_cast<int32_t>(value - prevValue);
+    pushVarUInt(ser, (static_cast<uint32_t>(diff) << 1) ^ static_cast<uint32_t>(diff >> 31));
+}
+
+uint32_t popDelta(Serializer& ser, uint32_t prevValue)
+{
+    const uint32_t zigZag = popVarUInt(ser);
+    return prevValue + ((zigZag >> 1) ^ (0u - (zigZag & 1u)));
+}
+} // namespace
 
 std::string Replay::GetSignature() const
 {
@@ -20,17 +65,32 @@ uint16_t Replay::GetVersion() const
 {
     /// Version des Replay-Formates
     /// Search for "TODO(Replay)" when increasing this (breaking Replay compatibility)
+    /// 8: Commands stored in independently compressed blocks with delta encoded GFs and checksums
+    return 8;
+}
+
+uint16_t Replay::GetMinReadVersion() const
+{
+    // TODO(Replay): Version 7 is still read for its uncompressed and fully compressed commands
     return 7;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-Replay::Replay() : random_init(0), isRecording_(false), lastGF_(0), lastGfFilePos_(0), mapType_(MapType::OldMap) {}
+Replay::Replay()
+    : random_init(0), isRecording_(false), lastGF_(0), lastGfFilePos_(0), mapType_(MapType::OldMap), usesBlocks_(false),
+      blockStartGF_(0), prevCmdGF_(0)
+{}
 
-Replay::~Replay() = default;
+Replay::~Replay()
+{
+    // Keep the recorded commands in case of e.g. an exception
+    StopRecording();
+}
 
 void Replay::Close()
 {
+    StopRecording();
     file_.Close();
     uncompressedDataFile_.reset();
     isRecording_ = false;
@@ -42,54 +102,71 @@ bool Replay::StopRecording()
 {
     if(!isRecording_)
         return true;
-    const unsigned replayDataSize = file_.Tell();
+    bool result = true;
+    try
+    {
+        WriteBlock();
+    } catch(const std::exception& e)
+    {
+        lastErrorMsg = e.what();
+        result = false;
+    }
     isRecording_ = false;
     file_.Close();
+    return result;
+}
 
-    BinaryFile file;
-    if(!file.Open(filepath_, OpenFileMode::OFM_READ))
-        return false;
+void Replay::ResetDeltaState()
+{
+    prevCmdGF_ = 0;
+    prevChecksum_ = AsyncChecksum();
+}
+
+void Replay::WriteBlock()
+{
+    if(!curBlock_.GetLength())
+        return;
+    const std::vector<char> data(curBlock_.GetData(), curBlock_.GetData() + curBlock_.GetLength());
+    curBlock_.Clear();
+    ResetDeltaState();
+    const std::vector<char> compressedData = CompressedData::compress(data);
+    file_.WriteUnsignedInt(data.size());
+    // Store uncompressed if compression does not help (e.g. tiny blocks) which is marked by equal sizes
+    if(compressedData.size() < data.size())
+    {
+        file_.WriteUnsignedInt(compressedData.size());
+        file_.WriteRawData(compressedData.data(), compressedData.size());
+    } else
+    {
+        file_.WriteUnsignedInt(data.size());
+        file_.WriteRawData(data.data(), data.size());
+    }
+    file_.Flush();
+}
+
+bool Replay::ReadBlock()
+{
+    unsigned uncompressedSize, storedSize;
+    std::vector<char> data;
     try
     {
-        TmpFile tmpReplayFile(".rpl");
-        file.Seek(0, SEEK_SET);
-        tmpReplayFile.close();
-        BinaryFile compressedReplay;
-        compressedReplay.Open(tmpReplayFile.filePath, OpenFileMode::OFM_WRITE);
-
-        // Copy header data uncompressed
-        std::vector<char> data(lastGfFilePos_);
-        file.ReadRawData(data.data(), data.size());
-        compressedReplay.WriteRawData(data.data(), data.size());
-        const auto lastGF = file.ReadUnsignedInt();
-        RTTR_Assert(lastGF == lastGF_);
-        compressedReplay.WriteUnsignedInt(lastGF);
-        file.ReadUnsignedChar(); // Ignore compressed flag
-        compressedReplay.WriteUnsignedChar(1);
-
-        // Read and compress remaining data
-        const auto uncompressedSize = replayDataSize - file.Tell();
-        data.resize(uncompressedSize);
-        file.ReadRawData(data.data(), data.size());
-        data = CompressedData::compress(data);
-        // If the compressed data turns out to be larger than the uncompressed one, bail out
-        // This can happen for very short replays
-        if(data.size() >= uncompressedSize)
-            return true;
-        compressedReplay.WriteUnsignedInt(uncompressedSize);
-        compressedReplay.WriteUnsignedInt(data.size());
-        compressedReplay.WriteRawData(data.data(), data.size());
-
-        // All done. Replace uncompressed replay
-        compressedReplay.Close();
-        file.Close();
-        boost::filesystem::rename(tmpReplayFile.filePath, filepath_);
-        return true;
-    } catch(const std::exception& e)
+        uncompressedSize = file_.ReadUnsignedInt();
+        storedSize = file_.ReadUnsignedInt();
+        data.resize(storedSize);
+        file_.ReadRawData(data.data(), data.size());
+    } catch(std::runtime_error&)
     {
-        lastErrorMsg = e.what();
-        return false;
+        // End of replay, possibly with an incomplete last block after a crash
+        if(file_.EndOfFile())
+            return false;
+        throw;
     }
+    if(storedSize != uncompressedSize)
+        data = CompressedData::decompress(data, uncompressedSize);
+    curBlock_.Clear();
+    curBlock_.PushRawData(data.data(), data.size());
+    ResetDeltaState();
+    return true;
 }
 
 bool Replay::StartRecording(const boost::filesystem::path& filepath, const MapInfo& mapInfo)
@@ -118,7 +195,9 @@ bool Replay::StartRecording(const boost::filesystem::path& filepath, const MapIn
     // Position merken für End-GF
     lastGfFilePos_ = file_.Tell();
     file_.WriteUnsignedInt(lastGF_);
-    file_.WriteUnsignedChar(0); // Compressed flag
+    usesBlocks_ = true;
+    curBlock_.Clear();
+    ResetDeltaState();
 
     WritePlayerData(file_);
     WriteGGS(file_);
@@ -197,8 +276,10 @@ bool Replay::LoadGameData(MapInfo& mapInfo)
 {
     try
     {
-        const bool isCompressed = file_.ReadUnsignedChar() != 0;
-        if(isCompressed)
+        // TODO(Replay): Version 7 stored the commands plain or compressed as a whole, marked by a flag
+        usesBlocks_ = readVersion_ >= 8;
+        curBlock_.Clear();
+        if(!usesBlocks_ && file_.ReadUnsignedChar() != 0)
         {
             const auto uncompressedSize = file_.ReadUnsignedInt();
             const auto compressedSize = file_.ReadUnsignedInt();
@@ -257,15 +338,19 @@ void Replay::AddChatCommand(unsigned gf, uint8_t player, ChatDestination dest, c
     if(!file_.IsValid())
         return;
 
-    file_.WriteUnsignedInt(gf);
+    if(curBlock_.GetLength() >= MAX_BLOCK_SIZE || gf - blockStartGF_ >= MAX_BLOCK_GFS)
+        WriteBlock();
+    if(!curBlock_.GetLength())
+        blockStartGF_ = gf;
 
-    file_.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Chat));
-    file_.WriteUnsignedChar(player);
-    file_.WriteUnsignedChar(static_cast<uint8_t>(dest));
-    file_.WriteLongString(str);
+    RTTR_Assert(gf >= prevCmdGF_);
+    pushVarUInt(curBlock_, gf - prevCmdGF_);
+    prevCmdGF_ = gf;
 
-    // Sofort rein damit
-    file_.Flush();
+    curBlock_.PushUnsignedChar(static_cast<uint8_t>(ReplayCommand::Chat));
+    curBlock_.PushUnsignedChar(player);
+    curBlock_.PushUnsignedChar(static_cast<uint8_t>(dest));
+    curBlock_.PushLongString(str);
 }
 
 void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommands& cmds)
@@ -274,21 +359,45 @@ void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommand
     if(!file_.IsValid())
         return;
 
-    file_.WriteUnsignedInt(gf);
-
-    file_.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Game));
-    Serializer ser;
-    ser.PushUnsignedChar(player);
-    cmds.Serialize(ser);
-    ser.WriteToFile(file_);
-
-    // Sofort rein damit
-    file_.Flush();
+    if(curBlock_.GetLength() >= MAX_BLOCK_SIZE || gf - blockStartGF_ >= MAX_BLOCK_GFS)
+        WriteBlock();
+    if(!curBlock_.GetLength())
+        blockStartGF_ = gf;
+
+    RTTR_Assert(gf >= prevCmdGF_);
+    pushVarUInt(curBlock_, gf - prevCmdGF_);
+    prevCmdGF_ = gf;
+
+    curBlock_.PushUnsignedChar(static_cast<uint8_t>(ReplayCommand::Game));
+    curBlock_.PushUnsignedChar(player);
+    // All players send the checksum of the same state and the counters change slowly, so store only the differences
+    const AsyncChecksum& checksum = cmds.checksum;
+    const bool isSameRandChecksum = checksum.randChecksum == prevChecksum_.randChecksum;
+    curBlock_.PushBool(isSameRandChecksum);
+    if(!isSameRandChecksum)
+        curBlock_.PushUnsignedInt(checksum.randChecksum);
+    pushDelta(curBlock_, checksum.objCt, prevChecksum_.objCt);
+    pushDelta(curBlock_, checksum.objIdCt, prevChecksum_.objIdCt);
+    pushDelta(curBlock_, checksum.eventCt, prevChecksum_.eventCt);
+    pushDelta(curBlock_, checksum.evInstanceCt, prevChecksum_.evInstanceCt);
+    prevChecksum_ = checksum;
+    cmds.SerializeCommands(curBlock_);
 }
 
 bool Replay::ReadGF(unsigned* gf)
 {
     RTTR_Assert(IsReplaying());
+    if(usesBlocks_)
+    {
+        if(!curBlock_.GetBytesLeft() && !ReadBlock())
+        {
+            *gf = 0xFFFFFFFF;
+            return false;
+        }
+        prevCmdGF_ += popVarUInt(curBlock_);
+        *gf = prevCmdGF_;
+        return true;
+    }
     try
     {
         *gf = file_.ReadUnsignedInt();
@@ -306,12 +415,19 @@ ReplayCommand Replay::ReadRCType()
 {
     RTTR_Assert(IsReplaying());
     // Type auslesen
-    return ReplayCommand(file_.ReadUnsignedChar());
+    return ReplayCommand(usesBlocks_ ? curBlock_.PopUnsignedChar() : file_.ReadUnsignedChar());
 }
 
 void Replay::ReadChatCommand(uint8_t& player, uint8_t& dest, std::string& str)
 {
     RTTR_Assert(IsReplaying());
+    if(usesBlocks_)
+    {
+        player = curBlock_.PopUnsignedChar();
+        dest = curBlock_.PopUnsignedChar();
+        str = curBlock_.PopLongString();
+        return;
+    }
     player = file_.ReadUnsignedChar();
     dest = file_.ReadUnsignedChar();
     str = file_.ReadLongString();
@@ -320,6 +436,20 @@ void Replay::ReadChatCommand(uint8_t& player, uint8_t& dest, std::string& str)
 void Replay::ReadGameCommand(uint8_t& player, PlayerGameCommands& cmds)
 {
     RTTR_Assert(IsReplaying());
+    if(usesBlocks_)
+    {
+        player = curBlock_.PopUnsignedChar();
+        AsyncChecksum& checksum = cmds.checksum;
+        checksum.randChecksum = curBlock_.PopBool() ? prevChecksum_.randChecksum : curBlock_.PopUnsignedInt();
+        checksum.objCt = popDelta(curBlock_, prevChecksum_.objCt);
+        checksum.objIdCt = popDelta(curBlock_, prevChecksum_.objIdCt);
+        checksum.eventCt = popDelta(curBlock_, prevChecksum_.eventCt);
+        checksum.evInstanceCt = popDelta(curBlock_, prevChecksum_.evInstanceCt);
+        prevChecksum_ = checksum;
+        cmds.DeserializeCommands(curBlock_);
+        return;
+    }
+    // TODO(Replay): Version 7 stored each command in its own serializer
     Serializer ser;
     ser.ReadFromFile(file_);
     player = ser.PopUnsignedChar();
@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include "AsyncChecksum.h"
 #include "SavedFile.h"
 #include "gameTypes/ChatDestination.h"
 #include "gameTypes/MapType.h"
 #include "s25util/BinaryFile.h"
+#include "s25util/Serializer.h"
 #include <memory>
 #include <string>
 
@@ -27,7 +29,10 @@ enum class ReplayCommand
 /// It has a header that holds minimal information:
 ///     File header (version etc.), record time, map name, player names, length (last GF), savegame header (if
 ///     applicable)
-/// All game relevant data is stored afterwards
+/// All game relevant data is stored afterwards.
+/// The commands are written in independently compressed blocks with GFs and checksums stored as differences to the
+/// previous command. Blocks are written periodically, so a replay is readable up to the last written block at any time.
+/// Commands of the block not yet written (up to 1000 GFs or 64 KiB) are lost on a hard crash.
 class Replay : public SavedFile
 {
 public:
@@ -38,10 +43,12 @@ public:
 
     std::string GetSignature() const override;
     uint16_t GetVersion() const override;
+    uint16_t GetMinReadVersion() const override;
 
     /// Beginnt die Save-Datei und schreibt den Header
     bool StartRecording(const boost::filesystem::path& filepath, const MapInfo& mapInfo);
-    /// Stop recording. Will compress the data and return true if that succeeded. The file will be closed in any case
+    /// Stop recording. Writes the remaining data and returns true if that succeeded.
+    /// The file will be closed in any case
     bool StopRecording();
 
     /// Replaydatei gültig?
@@ -76,6 +83,13 @@ public:
     unsigned random_init;
 
 protected:
+    /// Write the current block of commands to the file (if not empty)
+    void WriteBlock();
+    /// Read the next block of commands. Return false if there is none
+    bool ReadBlock();
+    /// Reset the state used for the differences between commands, done at the start of each block
+    void ResetDeltaState();
+
     BinaryFile file_;
     std::unique_ptr<TmpFile> uncompressedDataFile_; /// Used when reading a compressed replay
     boost::filesystem::path filepath_;              /// Path to current file
@@ -86,4 +100,14 @@ protected:
     /// Position des End-GF in der Datei
     unsigned lastGfFilePos_;
     MapType mapType_;
+
+    /// True if the commands are stored in blocks, false for the old formats
+    bool usesBlocks_;
+    /// Commands of the block currently written or read
+    Serializer curBlock_;
+    /// GF of the first command in the block currently written
+    unsigned blockStartGF_;
+    /// GF and checksum of the previous command in the current block
+    unsigned prevCmdGF_;
+    AsyncChecksum prevChecksum_;
 };
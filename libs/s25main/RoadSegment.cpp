@@ -8,6 +8,7 @@
 #include "SerializedGameData.h"
 #include "buildings/nobBaseWarehouse.h"
 #include "figures/nofCarrier.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "random/Random.h"
 #include "world/GameWorld.h"
 #include "nodeObjs/noFlag.h"
@@ -41,6 +42,18 @@ RoadSegment::RoadSegment(SerializedGameData& sgd, const unsigned obj_id)
     f2->SetRoute(route.back() + 3u, this);
 }
 
+void RoadSegment::SetF1(noRoadNode* o)
+{
+    f1 = o;
+    world->GetRoadPathFinder().InvalidateConnectivity();
+}
+
+void RoadSegment::SetF2(noRoadNode* o)
+{
+    f2 = o;
+    world->GetRoadPathFinder().InvalidateConnectivity();
+}
+
 bool RoadSegment::GetNodeID(const noRoadNode& rn) const
 {
     RTTR_Assert(&rn == f1 || &rn == f2);
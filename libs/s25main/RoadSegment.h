@@ -5,6 +5,7 @@
 #pragma once
 
 #include "GameObject.h"
+#include "helpers/IntrusiveList.h"
 #include "gameTypes/Direction.h"
 #include <array>
 #include <vector>
@@ -27,7 +28,7 @@ constexpr auto maxEnumValue(RoadType)
     return RoadType::Water;
 }
 
-class RoadSegment : public GameObject
+class RoadSegment : public GameObject, public helpers::IntrusiveListHook<RoadSegment>
 {
 public:
     RoadSegment(RoadType rt, noRoadNode* f1, noRoadNode* f2, std::vector<Direction> route);
@@ -49,11 +50,11 @@ public:
     /// gibt Flagge 1 zurück
     noRoadNode* GetF1() const { return f1; }
     /// setzt Flagge 1 auf o
-    void SetF1(noRoadNode* o) { f1 = o; }
+    void SetF1(noRoadNode* o);
     /// gibt Flagge 2 zurück
     noRoadNode* GetF2() const { return f2; }
     /// setzt Flagge 2 auf o
-    void SetF2(noRoadNode* o) { f2 = o; }
+    void SetF2(noRoadNode* o);
     /// gibt die Route nr zurück
     Direction GetRoute(unsigned nr) const { return route.at(nr); }
     /// setzt die Route nr auf r
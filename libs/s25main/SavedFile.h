@@ -24,6 +24,8 @@ public:
     virtual std::string GetSignature() const = 0;
     /// Return the file format version
     virtual uint16_t GetVersion() const = 0;
+    /// Return the oldest file format version which can still be read
+    virtual uint16_t GetMinReadVersion() const { return GetVersion(); }
 
     /// Schreibt Signatur und Version der Datei
     void WriteFileHeader(BinaryFile& file) const;
@@ -64,6 +66,8 @@ public:
 protected:
     /// Last error message during loading
     std::string lastErrorMsg;
+    /// Format version of the file as read by ReadFileHeader
+    uint16_t readVersion_;
 
 private:
     std::vector<BasePlayerInfo> players;
@@ -6,7 +6,10 @@
 #include "gameTypes/CompressedData.h"
 #include "s25util/BinaryFile.h"
 #include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/nowide/fstream.hpp>
+#include <mygettext/mygettext.h>
+#include <stdexcept>
 
 std::string Savegame::GetSignature() const
 {
@@ -22,7 +25,7 @@ uint16_t Savegame::GetVersion() const
 
 //////////////////////////////////////////////////////////////////////////
 
-Savegame::Savegame() : start_gf(0) {}
+Savegame::Savegame() : start_gf(0), gameDataOffset_(0) {}
 
 Savegame::~Savegame() = default;
 
@@ -46,8 +49,14 @@ bool Savegame::Save(BinaryFile& file, const std::string& mapName)
 bool Savegame::Load(const boost::filesystem::path& filePath, const SaveGameDataToLoad what)
 {
     BinaryFile file;
-
-    return file.Open(filePath, OFM_READ) && Load(file, what);
+    if(!file.Open(filePath, OFM_READ))
+        return false;
+    // The game data is the bulk of the file, so it is loaded separately from the mapped file
+    if(!Load(file, (what == SaveGameDataToLoad::All) ? SaveGameDataToLoad::HeaderAndSettings : what))
+        return false;
+    filePath_ = filePath;
+    file.Close();
+    return what != SaveGameDataToLoad::All || LoadGameData();
 }
 
 bool Savegame::Load(BinaryFile& file, const SaveGameDataToLoad what)
@@ -56,6 +65,8 @@ bool Savegame::Load(BinaryFile& file, const SaveGameDataToLoad what)
     {
         ClearPlayers();
         sgd.Clear();
+        filePath_.clear();
+        gameDataOffset_ = 0;
         if(!ReadAllHeaderData(file))
             return false;
 
@@ -64,6 +75,7 @@ bool Savegame::Load(BinaryFile& file, const SaveGameDataToLoad what)
 
         ReadPlayerData(file);
         ReadGGS(file);
+        gameDataOffset_ = file.Tell();
 
         if(what == SaveGameDataToLoad::HeaderAndSettings)
             return true;
@@ -78,6 +90,42 @@ bool Savegame::Load(BinaryFile& file, const SaveGameDataToLoad what)
     return true;
 }
 
+bool Savegame::LoadGameData()
+{
+    if(filePath_.empty() || !gameDataOffset_)
+    {
+        lastErrorMsg = "Settings of the savegame were not loaded from a file";
+        return false;
+    }
+    BinaryFile file;
+    if(!file.Open(filePath_, OFM_READ))
+    {
+        lastErrorMsg = _("File could not be opened.");
+        return false;
+    }
+    try
+    {
+        // Only the pages actually accessed are read from disk. Fall back to reading the file if it can't be mapped
+        boost::iostreams::mapped_file_source mappedFile;
+        try
+        {
+            mappedFile.open(filePath_);
+        } catch(const std::exception&)
+        {}
+        file.Seek(gameDataOffset_, SEEK_SET);
+        if(mappedFile.is_open())
+            ReadGameData(file, mappedFile.data(), mappedFile.size());
+        else
+            ReadGameData(file);
+    } catch(std::runtime_error& e)
+    {
+        sgd.Clear();
+        lastErrorMsg = e.what();
+        return false;
+    }
+    return true;
+}
+
 void Savegame::WriteExtHeader(BinaryFile& file, const std::string& mapName)
 {
     SavedFile::WriteExtHeader(file, mapName);
@@ -95,39 +143,54 @@ bool Savegame::ReadExtHeader(BinaryFile& file)
 void Savegame::WriteGameData(BinaryFile& file)
 {
     file.WriteUnsignedInt(1); // Compressed flag for compatibility
-    std::vector<char> data(sgd.GetData(), sgd.GetData() + sgd.GetLength());
-    const unsigned uncompressedLength = data.size();
-    data = CompressedData::compress(data);
-    file.WriteUnsignedInt(uncompressedLength);
+    // Compress directly from the serialized data without an intermediate copy
+    const std::vector<char> data = CompressedData::compress(sgd.GetData(), sgd.GetLength());
+    file.WriteUnsignedInt(sgd.GetLength());
     file.WriteUnsignedInt(data.size());
     file.WriteRawData(data.data(), data.size());
 }
 
-bool Savegame::ReadGameData(BinaryFile& file)
+bool Savegame::ReadGameData(BinaryFile& file, const char* fileData, size_t fileSize)
 {
     std::vector<char> data;
+    // Get the next bytes of the file either directly from memory or by reading them
+    const auto readRawData = [&](unsigned size) {
+        if(!fileData)
+        {
+            data.resize(size);
+            file.ReadRawData(data.data(), data.size());
+            return static_cast<const char*>(data.data());
+        }
+        const auto offset = static_cast<size_t>(file.Tell());
+        if(offset > fileSize || fileSize - offset < size)
+            throw std::runtime_error("Unexpected end of file in the game data");
+        return fileData + offset;
+    };
+
+    sgd.Clear();
     const auto compressedFlagOrSize = file.ReadUnsignedInt();
     if(compressedFlagOrSize == 1u)
     {
         const auto uncompressedLength = file.ReadUnsignedInt();
         const auto compressedLength = file.ReadUnsignedInt();
-        data.resize(compressedLength);
-        file.ReadRawData(data.data(), data.size());
-        data = CompressedData::decompress(data, uncompressedLength);
+        const char* compressedData = readRawData(compressedLength);
 #ifndef NDEBUG
         // In debug builds write uncompressed game data to temporary file
         const auto gameDataPath = boost::filesystem::temp_directory_path() / "rttrGameData.raw";
         boost::nowide::ofstream f(gameDataPath, std::ios::binary);
-        f.write(data.data(), data.size());
 #endif
+        // Decompress chunk-wise directly into the game data to avoid holding a second uncompressed copy
+        CompressedData::decompress(compressedData, compressedLength, uncompressedLength,
+                                   [&](const char* chunk, size_t chunkSize) {
+                                       sgd.PushRawData(chunk, chunkSize);
+#ifndef NDEBUG
+                                       f.write(chunk, chunkSize);
+#endif
+                                   });
     } else
     { // Old savegames have a size here which is always bigger than 1
         RTTR_Assert(compressedFlagOrSize > 1u);
-        data.resize(compressedFlagOrSize);
-        file.ReadRawData(data.data(), data.size());
+        sgd.PushRawData(readRawData(compressedFlagOrSize), compressedFlagOrSize);
     }
-
-    sgd.Clear();
-    sgd.PushRawData(data.data(), data.size());
     return true;
 }
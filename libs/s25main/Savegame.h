@@ -33,6 +33,9 @@ public:
     /// Lädt Savegame oder Teile davon
     bool Load(const boost::filesystem::path& filePath, SaveGameDataToLoad what);
     bool Load(BinaryFile& file, SaveGameDataToLoad what);
+    /// Load only the game data after the header and settings were loaded from a file.
+    /// The file is memory-mapped and the game data section decompressed directly from it
+    bool LoadGameData();
 
     void WriteExtHeader(BinaryFile& file, const std::string& mapName) override;
     bool ReadExtHeader(BinaryFile& file) override;
@@ -44,5 +47,12 @@ public:
 
 protected:
     void WriteGameData(BinaryFile& file);
-    bool ReadGameData(BinaryFile& file);
+    /// Read the game data section at the current position of the file.
+    /// If fileData is given it must point to the whole file in memory and is used instead of reading the data
+    bool ReadGameData(BinaryFile& file, const char* fileData = nullptr, size_t fileSize = 0);
+
+private:
+    /// File the header and settings were loaded from and offset of the game data section in it
+    boost::filesystem::path filePath_;
+    unsigned gameDataOffset_;
 };
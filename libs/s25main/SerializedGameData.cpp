@@ -56,7 +56,6 @@
 #include "figures/nofWarehouseWorker.h"
 #include "figures/nofWellguy.h"
 #include "figures/nofWoodcutter.h"
-#include "helpers/containerUtils.h"
 #include "helpers/format.hpp"
 #include "helpers/toString.h"
 #include "world/MapSerializer.h"
@@ -77,6 +76,7 @@
 #include "nodeObjs/noStaticObject.h"
 #include "nodeObjs/noTree.h"
 #include "s25util/Log.h"
+#include <algorithm>
 
 // clang-format off
 /// Version of the current game data
@@ -95,7 +95,8 @@
 /// 7: Use helpers::push/popContainer (uses var size)
 /// 8: noFlag::Wares converted to static_vector
 /// 9: Drop serialization of node BQ
-static const unsigned currentGameDataVersion = 9;
+/// 10: Lua GF interval and pending batched exploration events
+static const unsigned currentGameDataVersion = 10;
 // clang-format on
 
 std::unique_ptr<GameObject> SerializedGameData::Create_GameObject(const GO_Type got, const unsigned obj_id)
@@ -175,21 +176,22 @@ std::unique_ptr<GameObject> SerializedGameData::Create_GameObject(const GO_Type
                 + " found!");
 }
 
-std::unique_ptr<FOWObject> SerializedGameData::Create_FOWObject(const FoW_Type fowtype)
+const FOWObject* SerializedGameData::Create_FOWObject(const FoW_Type fowtype)
 {
     switch(fowtype)
     {
         default: return nullptr;
-        case FoW_Type::Building: return std::make_unique<fowBuilding>(*this);
-        case FoW_Type::Buildingsite: return std::make_unique<fowBuildingSite>(*this);
-        case FoW_Type::Flag: return std::make_unique<fowFlag>(*this);
-        case FoW_Type::Tree: return std::make_unique<fowTree>(*this);
-        case FoW_Type::Granite: return std::make_unique<fowGranite>(*this);
+        case FoW_Type::Building: return fowBuilding::Deserialize(*this);
+        case FoW_Type::Buildingsite: return fowBuildingSite::Deserialize(*this);
+        case FoW_Type::Flag: return fowFlag::Deserialize(*this);
+        case FoW_Type::Tree: return fowTree::Deserialize(*this);
+        case FoW_Type::Granite: return fowGranite::Deserialize(*this);
     }
 }
 
 SerializedGameData::SerializedGameData()
-    : debugMode(false), expectedNumObjects(0), em(nullptr), writeEm(nullptr), isReading(false)
+    : debugMode(false), numWrittenObjs(0), numWrittenEvents(0), numReadObjs(0), expectedNumObjects(0), em(nullptr),
+      writeEm(nullptr), isReading(false)
 {}
 
 void SerializedGameData::Prepare(bool reading)
@@ -209,18 +211,30 @@ void SerializedGameData::Prepare(bool reading)
         PushUnsignedInt(currentGameDataVersion);
         gameDataVersion = currentGameDataVersion;
     }
-    writtenObjIds.clear();
-    readObjects.clear();
+    ResetObjectTracking();
     expectedNumObjects = 0;
     isReading = reading;
 }
 
+void SerializedGameData::ResetObjectTracking()
+{
+    // Release the memory as the data itself may be kept for a long time, e.g. in a savegame
+    std::vector<bool>().swap(writtenObjIds);
+    std::vector<bool>().swap(writtenEventIds);
+    std::vector<GameObject*>().swap(readObjects);
+    std::unordered_map<unsigned, GameEvent*>().swap(readEvents);
+    numWrittenObjs = numWrittenEvents = numReadObjs = 0;
+}
+
 void SerializedGameData::MakeSnapshot(const Game& game)
 {
     Prepare(false);
 
     const GameWorldBase& gw = game.world_;
     writeEm = &gw.GetEvMgr();
+    // All ids are below their counters, so a flag per possible id can be used
+    writtenObjIds.resize(GameObject::GetObjIDCounter() + 1u);
+    writtenEventIds.resize(writeEm->GetEventInstanceCtr());
 
     // Anzahl Objekte reinschreiben (used for safety checks only)
     expectedNumObjects = GameObject::GetNumObjs();
@@ -244,21 +258,20 @@ void SerializedGameData::MakeSnapshot(const Game& game)
             LOG.write("Done serializing player %1% at %2%\n") % i % GetLength();
     }
 
-    if(writtenEventIds.size() != writeEm->GetNumActiveEvents())
+    if(numWrittenEvents != writeEm->GetNumActiveEvents())
     {
         throw Error(helpers::format("Event count mismatch. Expected: %1%, written: %2%", writeEm->GetNumActiveEvents(),
-                                    writtenEventIds.size()));
+                                    numWrittenEvents));
     }
     // If this check fails, we missed some objects or some objects were destroyed without decreasing the obj count
-    if(expectedNumObjects != writtenObjIds.size() + 1) // "Nothing" nodeObj does not get serialized
+    if(expectedNumObjects != numWrittenObjs + 1) // "Nothing" nodeObj does not get serialized
     {
         throw Error(helpers::format("Object count mismatch. Expected: %1%, written: %2%", expectedNumObjects,
-                                    writtenObjIds.size() + 1));
+                                    numWrittenObjs + 1));
     }
 
     writeEm = nullptr;
-    writtenObjIds.clear();
-    writtenEventIds.clear();
+    ResetObjectTracking();
 }
 
 void SerializedGameData::ReadSnapshot(Game& game, ILocalGameState& localGameState)
@@ -292,16 +305,16 @@ void SerializedGameData::ReadSnapshot(Game& game, ILocalGameState& localGameStat
         throw Error(helpers::format("Object count mismatch. Expected: %1%, Existing: %2%", expectedNumObjects,
                                     GameObject::GetNumObjs()));
     }
-    if(expectedNumObjects != readObjects.size() + 1) // "Nothing" nodeObj does not get serialized
+    if(expectedNumObjects != numReadObjs + 1) // "Nothing" nodeObj does not get serialized
     {
         throw Error(helpers::format("Object count mismatch. Expected: %1%, read: %2%", expectedNumObjects,
-                                    readObjects.size() + 1));
+                                    numReadObjs + 1));
     }
 
     // Sanity check for flag workers. See bug #1449
-    for(const auto& entry : readObjects)
+    for(const GameObject* obj : readObjects)
     {
-        const auto* worker = dynamic_cast<const nofFlagWorker*>(entry.second);
+        const auto* worker = dynamic_cast<const nofFlagWorker*>(obj);
         if(worker && worker->GetFlag() && worker->GetPlayer() != worker->GetFlag()->GetPlayer())
         {
             throw Error(helpers::format("Invalid flag worker at %1%", worker->GetPos()));
@@ -309,8 +322,7 @@ void SerializedGameData::ReadSnapshot(Game& game, ILocalGameState& localGameStat
     }
 
     em = nullptr;
-    readObjects.clear();
-    readEvents.clear();
+    ResetObjectTracking();
 }
 
 void SerializedGameData::PushObject_(const GameObject* go, const bool known)
@@ -346,12 +358,15 @@ void SerializedGameData::PushObject_(const GameObject* go, const bool known)
     }
 
     if(debugMode)
-        LOG.write("Saving objId %u, obj#=%u\n") % objId % writtenObjIds.size();
+        LOG.write("Saving objId %u, obj#=%u\n") % objId % numWrittenObjs;
 
     // Objekt merken
-    writtenObjIds.insert(objId);
+    if(objId >= writtenObjIds.size())
+        writtenObjIds.resize(objId + 1u);
+    writtenObjIds[objId] = true;
+    ++numWrittenObjs;
 
-    RTTR_Assert(writtenObjIds.size() < GameObject::GetNumObjs());
+    RTTR_Assert(numWrittenObjs < GameObject::GetNumObjs());
 
     // Objekt nich bekannt? Dann Type-ID noch mit drauf
     if(!known)
@@ -380,7 +395,10 @@ void SerializedGameData::PushEvent(const GameEvent* event)
     PushUnsignedInt(instanceId);
     if(IsEventSerialized(instanceId))
         return;
-    writtenEventIds.insert(instanceId);
+    if(instanceId >= writtenEventIds.size())
+        writtenEventIds.resize(instanceId + 1u);
+    writtenEventIds[instanceId] = true;
+    ++numWrittenEvents;
     if(debugMode)
         LOG.write("Start serializing event %1% at %2%\n") % instanceId % GetLength();
     event->Serialize(*this);
@@ -430,7 +448,7 @@ void SerializedGameData::PushFOWObject(const FOWObject* fowobj)
     fowobj->Serialize(*this);
 }
 
-std::unique_ptr<FOWObject> SerializedGameData::PopFOWObject()
+const FOWObject* SerializedGameData::PopFOWObject()
 {
     // Typ auslesen
     auto type = Pop<FoW_Type>();
@@ -452,6 +470,9 @@ GameObject* SerializedGameData::PopObject_(helpers::OptionalEnum<GO_Type> got)
     // Obj-ID = 0 ? Dann Null-Pointer zurueckgeben
     if(!objId)
         return nullptr;
+    // Ids are never above the counter. As that is read from the same data this only detects inconsistent data
+    if(objId > GameObject::GetObjIDCounter())
+        throw makeOutOfRange(objId, GameObject::GetObjIDCounter());
 
     if(GameObject* go = GetReadGameObject(objId))
         return go;
@@ -495,9 +516,13 @@ SerializedGameData::Error SerializedGameData::makeOutOfRange(unsigned value, uns
 void SerializedGameData::AddObject(GameObject* go)
 {
     RTTR_Assert(isReading);
-    RTTR_Assert(!readObjects[go->GetObjId()]); // Do not call this multiple times per GameObject
-    readObjects[go->GetObjId()] = go;
-    RTTR_Assert(readObjects.size() < expectedNumObjects);
+    const unsigned objId = go->GetObjId();
+    if(objId >= readObjects.size())
+        readObjects.resize(std::max(objId, GameObject::GetObjIDCounter()) + 1u, nullptr);
+    RTTR_Assert(!readObjects[objId]); // Do not call this multiple times per GameObject
+    readObjects[objId] = go;
+    ++numReadObjs;
+    RTTR_Assert(numReadObjs < expectedNumObjects);
 }
 
 unsigned SerializedGameData::AddEvent(unsigned instanceId, GameEvent* ev)
@@ -512,23 +537,19 @@ bool SerializedGameData::IsObjectSerialized(unsigned obj_id) const
 {
     RTTR_Assert(!isReading);
     RTTR_Assert(obj_id <= GameObject::GetObjIDCounter());
-    return helpers::contains(writtenObjIds, obj_id);
+    return obj_id < writtenObjIds.size() && writtenObjIds[obj_id];
 }
 
 bool SerializedGameData::IsEventSerialized(unsigned evInstanceid) const
 {
     RTTR_Assert(!isReading);
     RTTR_Assert(evInstanceid < writeEm->GetEventInstanceCtr());
-    return helpers::contains(writtenEventIds, evInstanceid);
+    return evInstanceid < writtenEventIds.size() && writtenEventIds[evInstanceid];
 }
 
 GameObject* SerializedGameData::GetReadGameObject(const unsigned obj_id) const
 {
     RTTR_Assert(isReading);
     RTTR_Assert(obj_id <= GameObject::GetObjIDCounter());
-    auto foundObj = readObjects.find(obj_id);
-    if(foundObj == readObjects.end())
-        return nullptr;
-    else
-        return foundObj->second;
+    return (obj_id < readObjects.size()) ? readObjects[obj_id] : nullptr;
 }
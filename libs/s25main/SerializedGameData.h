@@ -18,11 +18,11 @@
 #include "s25util/Serializer.h"
 #include "s25util/warningSuppression.h"
 #include <limits>
-#include <map>
 #include <memory>
-#include <set>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 class GameObject;
 class EventManager;
@@ -118,7 +118,7 @@ public:
     const GameEvent* PopEvent();
 
     /// FoW-Objekt
-    std::unique_ptr<FOWObject> PopFOWObject();
+    const FOWObject* PopFOWObject();
 
     /// Read a container of GameObjects
     template<typename T>
@@ -155,12 +155,15 @@ private:
     /// Version of the game data that is read. Gets set to the current version for writing
     unsigned gameDataVersion;
 
-    /// Stores the ids of all written objects (-> only valid during writing)
-    std::set<unsigned> writtenObjIds;
-    std::set<unsigned> writtenEventIds;
-    /// Maps already read object ids to GameObjects (-> only valid during reading)
-    std::map<unsigned, GameObject*> readObjects;
-    std::map<unsigned, GameEvent*> readEvents;
+    /// Flags for all object ids and event instance ids whether they were written (-> only valid during writing)
+    std::vector<bool> writtenObjIds, writtenEventIds;
+    unsigned numWrittenObjs, numWrittenEvents;
+    /// Already read GameObjects indexed by their id (-> only valid during reading)
+    std::vector<GameObject*> readObjects;
+    unsigned numReadObjs;
+    /// Maps already read event instance ids to events (-> only valid during reading).
+    /// Not a flat table as the instance ids count all events ever created and hence get much larger than the object ids
+    std::unordered_map<unsigned, GameEvent*> readEvents;
 
     /// Expected number of objects to be read/written
     unsigned expectedNumObjects;
@@ -174,10 +177,12 @@ private:
 
     /// Starts reading or writing according to the param
     void Prepare(bool reading);
+    /// Clears the bookkeeping of read and written objects and events and releases its memory
+    void ResetObjectTracking();
     /// Erzeugt GameObject
     std::unique_ptr<GameObject> Create_GameObject(GO_Type got, unsigned obj_id);
     /// Erzeugt FOWObject
-    std::unique_ptr<FOWObject> Create_FOWObject(FoW_Type fowtype);
+    const FOWObject* Create_FOWObject(FoW_Type fowtype);
 
     void PushObject_(const GameObject* go, bool known);
     /// Objekt(referenzen) lesen
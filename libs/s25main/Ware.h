@@ -6,6 +6,7 @@
 
 #include "GameObject.h"
 #include "RTTR_Assert.h"
+#include "helpers/IntrusiveList.h"
 #include "gameTypes/GoodTypes.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/RoadPathDirection.h"
@@ -18,7 +19,7 @@ class noFlag;
 class SerializedGameData;
 
 // Die Klasse Ware kennzeichnet eine Ware, die von einem Träger transportiert wird bzw gerade an einer Flagge liegt
-class Ware : public GameObject
+class Ware : public GameObject, public helpers::IntrusiveListHook<Ware>
 {
     /// Die Richtung von der Fahne auf dem Weg, auf dem die Ware transportiert werden will als nächstes
     RoadPathDirection next_dir;
@@ -69,7 +69,7 @@ void noBuilding::CloseDoor()
     --opendoor;
 }
 
-std::unique_ptr<FOWObject> noBuilding::CreateFOWObject() const
+const FOWObject* noBuilding::CreateFOWObject() const
 {
-    return std::make_unique<fowBuilding>(bldType_, nation);
+    return fowBuilding::Get(bldType_, nation);
 }
@@ -37,5 +37,5 @@ public:
     virtual bool FreePlaceAtFlag() = 0;
 
     /// Erzeugt von ihnen selbst ein FOW Objekt als visuelle "Erinnerung" für den Fog of War
-    std::unique_ptr<FOWObject> CreateFOWObject() const override;
+    const FOWObject* CreateFOWObject() const override;
 };
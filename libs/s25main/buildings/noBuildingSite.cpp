@@ -226,9 +226,9 @@ void noBuildingSite::Draw(DrawPoint drawPt)
 }
 
 /// Erzeugt von ihnen selbst ein FOW Objekt als visuelle "Erinnerung" für den Fog of War
-std::unique_ptr<FOWObject> noBuildingSite::CreateFOWObject() const
+const FOWObject* noBuildingSite::CreateFOWObject() const
 {
-    return std::make_unique<fowBuildingSite>(state == BuildingSiteState::Planing, bldType_, nation, build_progress);
+    return fowBuildingSite::Get(state == BuildingSiteState::Planing, bldType_, nation, build_progress);
 }
 
 void noBuildingSite::GotWorker(Job /*job*/, noFigure& worker)
@@ -65,7 +65,7 @@ public:
     void Draw(DrawPoint drawPt) override;
 
     /// Erzeugt von ihnen selbst ein FOW Objekt als visuelle "Erinnerung" für den Fog of War
-    std::unique_ptr<FOWObject> CreateFOWObject() const override;
+    const FOWObject* CreateFOWObject() const override;
 
     void AddWare(std::unique_ptr<Ware> ware) override;
     void GotWorker(Job job, noFigure& worker) override;
@@ -4,6 +4,7 @@
 
 #include "dskBenchmark.h"
 #include "Game.h"
+#include "GlobalVars.h"
 #include "Loader.h"
 #include "PlayerInfo.h"
 #include "RttrForeachPt.h"
@@ -15,6 +16,7 @@
 #include "factories/BuildingFactory.h"
 #include "figures/nofPassiveSoldier.h"
 #include "figures/nofPassiveWorker.h"
+#include "helpers/EnumRange.h"
 #include "helpers/mathFuncs.h"
 #include "helpers/toString.h"
 #include "lua/GameDataLoader.h"
@@ -29,9 +31,13 @@
 #include "gameData/GameLoader.h"
 #include "s25util/Log.h"
 #include "s25util/strFuncs.h"
+#include <boost/algorithm/string/split.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <helpers/chronoIO.h>
 #include <memory>
 #include <random>
+#include <sstream>
+#include <stdexcept>
 
 namespace {
 enum
@@ -42,7 +48,48 @@ enum
 };
 }
 
-static const unsigned numTestFrames = 500u;
+const char* getBenchmarkName(Benchmark benchmark)
+{
+    switch(benchmark)
+    {
+        case Benchmark::None: return "none";
+        case Benchmark::Text: return "text";
+        case Benchmark::Primitives: return "primitives";
+        case Benchmark::EmptyGame: return "emptyGame";
+        case Benchmark::BasicGame: return "basicGame";
+        case Benchmark::FullGame: return "fullGame";
+    }
+    return "unknown"; // LCOV_EXCL_LINE
+}
+
+std::vector<Benchmark> parseBenchmarks(const std::string& names)
+{
+    std::vector<Benchmark> result;
+    std::vector<std::string> splitNames;
+    boost::algorithm::split(splitNames, names, [](char c) { return c == ','; });
+    for(const std::string& name : splitNames)
+    {
+        if(name == "all")
+        {
+            for(const auto benchmark : helpers::enumRange<Benchmark>())
+            {
+                if(benchmark != Benchmark::None)
+                    result.push_back(benchmark);
+            }
+            continue;
+        }
+        Benchmark found = Benchmark::None;
+        for(const auto benchmark : helpers::enumRange<Benchmark>())
+        {
+            if(name == getBenchmarkName(benchmark))
+                found = benchmark;
+        }
+        if(found == Benchmark::None)
+            throw std::invalid_argument("Unknown benchmark: " + name);
+        result.push_back(found);
+    }
+    return result;
+}
 
 struct dskBenchmark::GameView
 {
@@ -57,14 +104,20 @@ struct dskBenchmark::GameView
     }
 };
 
-dskBenchmark::dskBenchmark()
-    : curTest_(Benchmark::None), runAll_(false), numInstances_(1000), frameCtr_(FrameCounter::clock::duration::max())
+dskBenchmark::dskBenchmark() : dskBenchmark(Config()) {}
+
+dskBenchmark::dskBenchmark(Config config)
+    : curTest_(Benchmark::None), pendingTests_(std::move(config.benchmarks)), isHeadless_(!pendingTests_.empty()),
+      numInstances_(config.numInstances), numFrames_(std::max(config.numFrames, 1u)),
+      numGFsPerFrame_(config.numGFsPerFrame), outputFile_(std::move(config.outputFile)),
+      frameCtr_(FrameCounter::clock::duration::max())
 {
     for(std::chrono::milliseconds& t : testDurations_)
         t = std::chrono::milliseconds::zero();
     AddText(ID_txtHelp, DrawPoint(5, 5), "Use F1-F5 to start benchmark, F10 for all, NUM_n to set amount of instances",
             COLOR_YELLOW, FontStyle::LEFT, LargeFont);
-    AddText(ID_txtAmount, DrawPoint(795, 5), "Instances: default", COLOR_YELLOW, FontStyle::RIGHT, LargeFont);
+    AddText(ID_txtAmount, DrawPoint(795, 5), "Instances: " + helpers::toString(numInstances_), COLOR_YELLOW,
+            FontStyle::RIGHT, LargeFont);
 }
 
 dskBenchmark::~dskBenchmark()
@@ -87,8 +140,8 @@ bool dskBenchmark::Msg_KeyDown(const KeyEvent& ke)
         case KeyType::F4: startTest(Benchmark::BasicGame); break;
         case KeyType::F5: startTest(Benchmark::FullGame); break;
         case KeyType::F10:
-            runAll_ = true;
-            startTest(Benchmark::Text);
+            pendingTests_ = parseBenchmarks("all");
+            startNextTest();
             break;
         case KeyType::Char:
             if(ke.c >= '0' && ke.c <= '9')
@@ -107,6 +160,16 @@ bool dskBenchmark::Msg_KeyDown(const KeyEvent& ke)
 
 void dskBenchmark::Msg_PaintAfter()
 {
+    // Simulate first so the game state is drawn afterwards, as it is ingame
+    clock::duration simTime = clock::duration::zero();
+    unsigned numGFs = 0;
+    if(game_ && numGFsPerFrame_ > 0)
+    {
+        const clock::time_point simStartTime = clock::now();
+        for(; numGFs < numGFsPerFrame_; numGFs++)
+            game_->RunGF();
+        simTime = clock::now() - simStartTime;
+    }
     for(const ColoredRect& rect : rects_)
         DrawRectangle(rect.rect, rect.clr);
     for(const ColoredLine& line : lines_)
@@ -119,10 +182,14 @@ void dskBenchmark::Msg_PaintAfter()
     }
     if(curTest_ != Benchmark::None)
     {
-        if(frameCtr_.getCurNumFrames() + 1u >= numTestFrames)
+        if(frameCtr_.getCurNumFrames() + 1u >= numFrames_)
             VIDEODRIVER.GetRenderer()->synchronize();
-        frameCtr_.update();
-        if(frameCtr_.getCurNumFrames() >= numTestFrames)
+        // The frame time includes everything since the end of the last frame, e.g. swapping the buffers
+        const clock::time_point now = clock::now();
+        report_.addFrame(now - lastFrameTime_, simTime, numGFs);
+        lastFrameTime_ = now;
+        frameCtr_.update(now);
+        if(frameCtr_.getCurNumFrames() >= numFrames_)
             finishTest();
     }
     dskMenuBase::Msg_PaintAfter();
@@ -130,18 +197,21 @@ void dskBenchmark::Msg_PaintAfter()
 
 void dskBenchmark::SetActive(bool activate)
 {
-    if(!IsActive() && activate)
+    const bool wasActive = IsActive();
+    if(!wasActive && activate)
         VIDEODRIVER.ResizeScreen(VideoMode(1600, 900), false);
     dskMenuBase::SetActive(activate);
+    if(!wasActive && activate && isHeadless_ && curTest_ == Benchmark::None && !startNextTest())
+        writeReport();
 }
 
-void dskBenchmark::startTest(Benchmark test)
+bool dskBenchmark::startTest(Benchmark test)
 {
     uint32_t seed = 0x1337;
     std::mt19937 rng(seed);
     switch(test)
     {
-        case Benchmark::None: return;
+        case Benchmark::None: return false;
         case Benchmark::Text:
         {
             static const std::string charset =
@@ -207,7 +277,7 @@ void dskBenchmark::startTest(Benchmark test)
         case Benchmark::EmptyGame:
             createGame();
             if(!game_)
-                return;
+                return false;
             RTTR_FOREACH_PT(MapPoint, game_->world_.GetSize())
             {
                 game_->world_.SetVisibility(pt, 0, Visibility::Visible);
@@ -217,7 +287,7 @@ void dskBenchmark::startTest(Benchmark test)
         {
             createGame();
             if(!game_)
-                return;
+                return false;
             std::vector<MapPoint> hqs(2, MapPoint(0, 0));
             hqs[1].x += 30;
             MapLoader::PlaceHQs(game_->world_, hqs, false);
@@ -227,7 +297,7 @@ void dskBenchmark::startTest(Benchmark test)
         {
             createGame();
             if(!game_)
-                return;
+                return false;
             std::vector<MapPoint> hqs(2, MapPoint(0, 0));
             hqs[1].x += 30;
             MapLoader::PlaceHQs(game_->world_, hqs, false);
@@ -264,17 +334,37 @@ void dskBenchmark::startTest(Benchmark test)
         }
     }
     if(game_)
+    {
+        game_->Start(false);
         gameView_ = std::make_unique<GameView>(game_->world_, VIDEODRIVER.GetRenderSize());
+    }
     VIDEODRIVER.GetRenderer()->synchronize();
     VIDEODRIVER.setTargetFramerate(-1);
     curTest_ = test;
+    report_.startTest(getBenchmarkName(test), numInstances_);
+    lastFrameTime_ = clock::now();
     frameCtr_ = FrameCounter(frameCtr_.getUpdateInterval());
+    return true;
+}
+
+bool dskBenchmark::startNextTest()
+{
+    while(!pendingTests_.empty())
+    {
+        const Benchmark test = pendingTests_.front();
+        pendingTests_.erase(pendingTests_.begin());
+        if(startTest(test))
+            return true;
+        LOG.write("Benchmark %1% could not be started\n") % getBenchmarkName(test);
+    }
+    return false;
 }
 
 void dskBenchmark::finishTest()
 {
     using namespace std::chrono;
     using helpers::withUnit;
+    report_.finishTest();
     LOG.write("Benchmark #%1% took %2%. -> %3%m/frame\n") % rttr::enum_cast(curTest_)
       % withUnit(duration_cast<duration<float>>(frameCtr_.getCurIntervalLength()))
       % withUnit(duration_cast<milliseconds>(frameCtr_.getCurIntervalLength() / frameCtr_.getCurNumFrames()));
@@ -296,18 +386,9 @@ void dskBenchmark::finishTest()
     game_.reset();
     SetFpsDisplay(true);
     VIDEODRIVER.setTargetFramerate(0);
-    if(!runAll_)
-        curTest_ = Benchmark::None;
-    else
-    {
-        if(curTest_ == helpers::MaxEnumValue<Benchmark>::value)
-            curTest_ = Benchmark::None;
-        else
-        {
-            curTest_ = Benchmark(rttr::enum_cast(curTest_) + 1);
-            startTest(curTest_);
-        }
-    }
+    curTest_ = Benchmark::None;
+    if(!startNextTest() && isHeadless_)
+        writeReport();
 }
 
 void dskBenchmark::createGame()
@@ -379,9 +460,28 @@ void dskBenchmark::printTimes() const
             continue;
         LOG.write("Benchmark #%1% took %2% -> %3%/frame\n") % rttr::enum_cast(i)
           % helpers::withUnit(duration_cast<duration<float>>(testDurations_[i]))
-          % helpers::withUnit(duration_cast<milliseconds>(testDurations_[i] / numTestFrames));
+          % helpers::withUnit(duration_cast<milliseconds>(testDurations_[i] / numFrames_));
         total += testDurations_[i];
     }
     LOG.write("Total benchmark time; %1% -> %2%/frame\n") % helpers::withUnit(duration_cast<duration<float>>(total))
-      % helpers::withUnit(duration_cast<milliseconds>(total / numTestFrames));
+      % helpers::withUnit(duration_cast<milliseconds>(total / numFrames_));
+}
+
+void dskBenchmark::writeReport()
+{
+    if(outputFile_.empty())
+    {
+        std::ostringstream s;
+        report_.WriteJSON(s);
+        LOG.write("%1%") % s.str();
+    } else
+    {
+        boost::nowide::ofstream file(outputFile_);
+        report_.WriteJSON(file);
+        if(file)
+            LOG.write("Benchmark results written to %1%\n") % outputFile_;
+        else
+            LOG.write("Could not write the benchmark results to %1%\n") % outputFile_;
+    }
+    GLOBALVARS.notdone = false;
 }
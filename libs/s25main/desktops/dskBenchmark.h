@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include "BenchmarkReport.h"
 #include "FrameCounter.h"
 #include "desktops/dskMenuBase.h"
 #include "helpers/EnumArray.h"
+#include <boost/filesystem/path.hpp>
 #include <chrono>
 #include <memory>
+#include <string>
 #include <vector>
 
 class Game;
@@ -26,6 +29,10 @@ constexpr auto maxEnumValue(Benchmark)
 {
     return Benchmark::FullGame;
 }
+/// Name of the benchmark as used on the command line and in the results
+const char* getBenchmarkName(Benchmark benchmark);
+/// Parse a comma separated list of benchmark names or "all". Throws std::invalid_argument on unknown names
+std::vector<Benchmark> parseBenchmarks(const std::string& names);
 
 class dskBenchmark : public dskMenuBase
 {
@@ -44,7 +51,22 @@ class dskBenchmark : public dskMenuBase
     struct GameView;
 
 public:
+    /// Settings for running benchmarks without user interaction
+    struct Config
+    {
+        /// Benchmarks to run in this order
+        std::vector<Benchmark> benchmarks;
+        unsigned numFrames = 500;
+        /// GFs to simulate before drawing each frame of the game benchmarks
+        unsigned numGFsPerFrame = 0;
+        int numInstances = 1000;
+        /// File to write the results to as JSON. Results are written to the log if empty
+        boost::filesystem::path outputFile;
+    };
+
     dskBenchmark();
+    /// Run the configured benchmarks, write the results and quit
+    explicit dskBenchmark(Config config);
     ~dskBenchmark();
 
     bool Msg_KeyDown(const KeyEvent& ke) override;
@@ -53,17 +75,29 @@ public:
 
 private:
     Benchmark curTest_;
-    bool runAll_;
+    /// Benchmarks to run after the current one
+    std::vector<Benchmark> pendingTests_;
+    /// Run the pending tests without user interaction and quit afterwards
+    bool isHeadless_;
     int numInstances_;
+    unsigned numFrames_, numGFsPerFrame_;
+    boost::filesystem::path outputFile_;
     FrameCounter frameCtr_;
+    /// End of the last frame of the current test
+    clock::time_point lastFrameTime_;
+    BenchmarkReport report_;
     std::vector<ColoredRect> rects_;
     std::vector<ColoredLine> lines_;
     std::shared_ptr<Game> game_;
     std::unique_ptr<GameView> gameView_;
     helpers::EnumArray<std::chrono::milliseconds, Benchmark> testDurations_;
 
-    void startTest(Benchmark test);
+    bool startTest(Benchmark test);
+    /// Start the first pending test which can be run. Return false if there is none
+    bool startNextTest();
     void finishTest();
     void createGame();
     void printTimes() const;
+    /// Write the report to the output file or log and quit
+    void writeReport();
 };
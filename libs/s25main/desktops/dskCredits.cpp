@@ -270,9 +270,8 @@ dskCredits::dskCredits() : Desktop(LOADER.GetImageN("setup013", 0)), itCurEntry(
     entry.lines.push_back(_("Thank you!"));
     entries.push_back(entry);
 
-    WorldDescription worldDesc;
-    GameDataLoader gdLoader(worldDesc);
-    if(!gdLoader.Load())
+    const auto gameData = loadSharedGameData();
+    if(!gameData)
     {
         WINDOWMANAGER.Show(std::make_unique<iwMsgbox>(_("Error"), _("Failed to load game data"), this, MsgboxButton::Ok,
                                                       MsgboxIcon::ExclamationRed, 0));
@@ -283,7 +282,7 @@ dskCredits::dskCredits() : Desktop(LOADER.GetImageN("setup013", 0)), itCurEntry(
     for(unsigned i = 0; i < NUM_NATIVE_NATIONS; i++)
         nations[i] = Nation(i);
 
-    if(!LOADER.LoadFilesAtGame(worldDesc.get(DescIdx<LandscapeDesc>(0)).mapGfxPath, false, nations, {}))
+    if(!LOADER.LoadFilesAtGame(gameData->get(DescIdx<LandscapeDesc>(0)).mapGfxPath, false, nations, {}))
     {
         WINDOWMANAGER.Show(std::make_unique<iwMsgbox>(_("Error"), _("Failed to load game resources"), this,
                                                       MsgboxButton::Ok, MsgboxIcon::ExclamationRed, 0));
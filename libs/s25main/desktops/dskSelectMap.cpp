@@ -3,8 +3,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "dskSelectMap.h"
-#include "ListDir.h"
 #include "Loader.h"
+#include "MapCatalog.h"
 #include "RttrConfig.h"
 #include "RttrLobbyClient.hpp"
 #include "WindowManager.h"
@@ -42,6 +42,7 @@
 #include "s25util/utf8.h"
 #include <boost/filesystem/operations.hpp>
 #include <boost/pointer_cast.hpp>
+#include <chrono>
 #include <stdexcept>
 #include <utility>
 
@@ -56,15 +57,17 @@ constexpr unsigned ID_msgBoxError = 0;
  *  @param[in] pass Server-Passwort
  */
 dskSelectMap::dskSelectMap(CreateServerInfo csi)
-    : Desktop(LOADER.GetImageN("setup015", 0)), csi(std::move(csi)), mapGenThread(nullptr), waitWnd(nullptr)
+    : Desktop(LOADER.GetImageN("setup015", 0)), csi(std::move(csi)), mapGenThread(nullptr), waitWnd(nullptr),
+      mapCatalog_(std::make_unique<MapCatalog>(RTTRCONFIG.ExpandPath(s25::folders::cache) / "mapCatalog.dat")),
+      isScanPending_(false), numNewBrokenMaps_(0)
 {
-    WorldDescription desc;
-    GameDataLoader gdLoader(desc);
-    if(!gdLoader.Load())
+    const auto gameData = loadSharedGameData();
+    if(!gameData)
     {
         LC_Status_Error(_("Failed to load game data!"));
         return;
     }
+    const WorldDescription& desc = *gameData;
 
     for(DescIdx<LandscapeDesc> i(0); i.value < desc.landscapes.size(); i.value++)
         landscapeNames[desc.get(i).s2Id] = _(desc.get(i).name);
@@ -153,31 +156,76 @@ void dskSelectMap::Msg_OptionGroupChange(const unsigned /*ctrl_id*/, unsigned se
                                                     s25::folders::mapsRttr, s25::folders::mapsOther,
                                                     s25::folders::mapsSea, s25::folders::mapsPlayed}};
 
-    const size_t numFaultyMapsPrior = brokenMapPaths.size();
-    const bfs::path mapPath = RTTRCONFIG.ExpandPath(ids[selection]);
-    FillTable(ListDir(mapPath, "swd"));
-    FillTable(ListDir(mapPath, "wld"));
+    // und Auswahl zurücksetzen
+    table->SetSelection(boost::none);
+
+    std::vector<bfs::path> mapFolders{RTTRCONFIG.ExpandPath(ids[selection])};
     // For own maps (WORLDS folder) also use the one in the installation folder as S2 does
-    if(mapPath.filename() == "WORLDS")
+    if(mapFolders.front().filename() == "WORLDS")
+        mapFolders.push_back(RTTRCONFIG.ExpandPath("WORLDS"));
+    // Rows are added in Draw_ as the maps are found
+    numNewBrokenMaps_ = 0;
+    isScanPending_ = true;
+    mapCatalog_->startScan(std::move(mapFolders));
+}
+
+void dskSelectMap::AddScannedMaps()
+{
+    if(!isScanPending_)
+        return;
+    // Check first, so all remaining entries are fetched below when the scan is done
+    const bool scanFinished = !mapCatalog_->isScanning();
+    auto* table = GetCtrl<ctrlTable>(1);
+    for(const MapCatalog::Entry& entry : mapCatalog_->fetchEntries())
     {
-        const bfs::path worldsPath = RTTRCONFIG.ExpandPath("WORLDS");
-        FillTable(ListDir(worldsPath, "swd"));
-        FillTable(ListDir(worldsPath, "wld"));
+        if(helpers::contains(brokenMapPaths, entry.filePath))
+            continue;
+        if(!entry.error.empty())
+        {
+            LOG.write(_("Failed to load map %1%: %2%\n")) % entry.filePath % entry.error;
+            brokenMapPaths.insert(entry.filePath);
+            numNewBrokenMaps_++;
+            continue;
+        }
+
+        // Und Zeilen vorbereiten
+        std::string players = (boost::format(_("%d Player")) % static_cast<unsigned>(entry.numPlayers)).str();
+        std::string size = helpers::toString(entry.width) + "x" + helpers::toString(entry.height);
+
+        std::string name = entry.name;
+        if(entry.hasLua)
+            name += " (*)";
+
+        table->AddRow({name, entry.author, players, landscapeNames[entry.gfxSet], size, entry.filePath.string()});
     }
+    if(!scanFinished)
+        return;
+    isScanPending_ = false;
 
-    if(brokenMapPaths.size() > numFaultyMapsPrior)
+    if(numNewBrokenMaps_ > 0)
     {
-        std::string errorTxt = helpers::format(_("%1% map(s) could not be loaded. Check the log for details"),
-                                               brokenMapPaths.size() - numFaultyMapsPrior);
+        std::string errorTxt =
+          helpers::format(_("%1% map(s) could not be loaded. Check the log for details"), numNewBrokenMaps_);
         WINDOWMANAGER.Show(
           std::make_unique<iwMsgbox>(_("Error"), errorTxt, this, MsgboxButton::Ok, MsgboxIcon::ExclamationRed, 1));
     }
 
-    // Dann noch sortieren
+    // Dann noch sortieren, ohne die Auswahl zu verlieren
+    std::string selectedPath = mapToSelect_;
+    mapToSelect_.clear();
+    if(selectedPath.empty() && table->GetSelection())
+        selectedPath = table->GetItemText(*table->GetSelection(), 5);
     table->SortRows(0, TableSortDir::Ascending);
-
-    // und Auswahl zurücksetzen
-    table->SetSelection(boost::none);
+    boost::optional<unsigned> newSelection;
+    for(unsigned i = 0; i < table->GetNumRows() && !selectedPath.empty(); i++)
+    {
+        if(table->GetItemText(i, 5) == selectedPath)
+        {
+            newSelection = i;
+            break;
+        }
+    }
+    table->SetSelection(newSelection);
 }
 
 /// Load a map, throw on error
@@ -204,6 +252,11 @@ void dskSelectMap::Msg_TableSelectItem(const unsigned ctrl_id, const boost::opti
     if(ctrl_id != 1)
         return;
 
+    const std::string path = selection ? GetCtrl<ctrlTable>(1)->GetItemText(*selection, 5) : "";
+    // Only moved, e.g. by sorting
+    if(!path.empty() && path == previewMapPath_)
+        return;
+
     ctrlPreviewMinimap& preview = *GetCtrl<ctrlPreviewMinimap>(11);
     ctrlText& txtMapName = *GetCtrl<ctrlText>(12);
     ctrlText& txtMapPath = *GetCtrl<ctrlText>(13);
@@ -213,29 +266,58 @@ void dskSelectMap::Msg_TableSelectItem(const unsigned ctrl_id, const boost::opti
     txtMapPath.SetText("");
     btContinue.SetEnabled(false);
 
-    // is the selection valid?
-    if(selection)
+    // Don't wait for the map of the previous selection to be loaded
+    if(previewMap_.valid() && previewMap_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        abandonedPreviewMaps_.push_back(std::move(previewMap_));
+
+    // is the selection valid? Then load the map in the background, shown in UpdatePreview
+    previewMapPath_ = path;
+    if(!path.empty())
+        previewMap_ = std::async(std::launch::async, loadAndVerifyMap, path);
+    else
+        previewMap_ = {};
+    const unsigned txtXPos = preview.GetPos().x + preview.GetSize().x + 10;
+    txtMapName.SetPos(DrawPoint(txtXPos, txtMapName.GetPos().y));
+    txtMapPath.SetPos(DrawPoint(txtXPos, txtMapPath.GetPos().y));
+}
+
+void dskSelectMap::UpdatePreview()
+{
+    // Drop the finished loads of previous selections
+    helpers::erase_if(abandonedPreviewMaps_, [](const auto& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+    if(!previewMap_.valid() || previewMap_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    ctrlPreviewMinimap& preview = *GetCtrl<ctrlPreviewMinimap>(11);
+    ctrlText& txtMapName = *GetCtrl<ctrlText>(12);
+    ctrlText& txtMapPath = *GetCtrl<ctrlText>(13);
+    try
+    {
+        std::unique_ptr<libsiedler2::ArchivItem_Map> map = previewMap_.get();
+        RTTR_Assert(map);
+        preview.SetMap(map.get());
+        txtMapName.SetText(s25util::ansiToUTF8(map->getHeader().getName()));
+        txtMapPath.SetText(previewMapPath_);
+        GetCtrl<ctrlButton>(5)->SetEnabled(true);
+    } catch(const std::runtime_error& e)
     {
+        const std::string path = previewMapPath_;
+        previewMapPath_.clear();
+        const std::string errorTxt = helpers::format(_("Could not load map:\n%1%\n%2%"), path, e.what());
+        LOG.write("%1%\n") % errorTxt;
+        WINDOWMANAGER.Show(std::make_unique<iwMsgbox>(_("Error"), errorTxt, this, MsgboxButton::Ok,
+                                                      MsgboxIcon::ExclamationRed, 1));
+        brokenMapPaths.insert(path);
         ctrlTable& table = *GetCtrl<ctrlTable>(1);
-        const std::string& path = table.GetItemText(*selection, 5);
-        if(!path.empty())
+        for(unsigned i = 0; i < table.GetNumRows(); i++)
         {
-            try
+            if(table.GetItemText(i, 5) == path)
             {
-                std::unique_ptr<libsiedler2::ArchivItem_Map> map = loadAndVerifyMap(path);
-                RTTR_Assert(map);
-                preview.SetMap(map.get());
-                txtMapName.SetText(s25util::ansiToUTF8(map->getHeader().getName()));
-                txtMapPath.SetText(path);
-                btContinue.SetEnabled(true);
-            } catch(const std::runtime_error& e)
-            {
-                const std::string errorTxt = helpers::format(_("Could not load map:\n%1%\n%2%"), path, e.what());
-                LOG.write("%1%\n") % errorTxt;
-                WINDOWMANAGER.Show(std::make_unique<iwMsgbox>(_("Error"), errorTxt, this, MsgboxButton::Ok,
-                                                              MsgboxIcon::ExclamationRed, 1));
-                brokenMapPaths.insert(path);
-                table.RemoveRow(*selection);
+                // Selects another map and starts loading it
+                table.RemoveRow(i);
+                break;
             }
         }
     }
@@ -298,8 +380,12 @@ void dskSelectMap::Msg_ButtonClick(const unsigned ctrl_id)
 
 void dskSelectMap::Msg_TableChooseItem(const unsigned /*ctrl_id*/, const unsigned /*selection*/)
 {
-    // Doppelklick auf bestimmte Map -> weiter
-    StartServer();
+    // Doppelklick auf bestimmte Map -> weiter, sobald sie geladen ist
+    if(previewMap_.valid())
+        previewMap_.wait();
+    UpdatePreview();
+    if(GetCtrl<ctrlButton>(5)->GetEnabled())
+        StartServer();
 }
 
 void dskSelectMap::CreateRandomMap()
@@ -324,17 +410,8 @@ void dskSelectMap::OnMapCreated(const boost::filesystem::path& mapPath)
     auto* optionGroup = GetCtrl<ctrlOptionGroup>(10);
     optionGroup->SetSelection(8, true);
 
-    // search for the random map entry and select it in the table
-    auto* table = GetCtrl<ctrlTable>(1);
-    const auto& mapPathString = mapPath.string();
-    for(int i = 0; i < table->GetNumRows(); i++)
-    {
-        if(table->GetItemText(i, 5) == mapPathString)
-        {
-            table->SetSelection(i);
-            break;
-        }
-    }
+    // select the random map entry in the table once it was found
+    mapToSelect_ = mapPath.string();
 }
 
 /// Startet das Spiel mit einer bestimmten Auswahl in der Tabelle
@@ -412,41 +489,7 @@ void dskSelectMap::Draw_()
         newRandMapPath.clear();
         randMapGenError.clear();
     }
+    AddScannedMaps();
+    UpdatePreview();
     Desktop::Draw_();
 }
-
-void dskSelectMap::FillTable(const std::vector<bfs::path>& files)
-{
-    auto* table = GetCtrl<ctrlTable>(1);
-
-    for(const bfs::path& filePath : files)
-    {
-        if(helpers::contains(brokenMapPaths, filePath))
-            continue;
-        // Karteninformationen laden
-        libsiedler2::Archiv map;
-        if(int ec = libsiedler2::loader::LoadMAP(filePath, map, true))
-        {
-            LOG.write(_("Failed to load map %1%: %2%\n")) % filePath % libsiedler2::getErrorString(ec);
-            brokenMapPaths.insert(filePath);
-            continue;
-        }
-
-        const libsiedler2::ArchivItem_Map_Header& header =
-          checkedCast<const libsiedler2::ArchivItem_Map*>(map[0])->getHeader();
-
-        const bfs::path luaFilepath = bfs::path(filePath).replace_extension("lua");
-        const bool hasLua = bfs::is_regular_file(luaFilepath);
-
-        // Und Zeilen vorbereiten
-        std::string players = (boost::format(_("%d Player")) % static_cast<unsigned>(header.getNumPlayers())).str();
-        std::string size = helpers::toString(header.getWidth()) + "x" + helpers::toString(header.getHeight());
-
-        std::string name = s25util::ansiToUTF8(header.getName());
-        if(hasLua)
-            name += " (*)";
-        std::string author = s25util::ansiToUTF8(header.getAuthor());
-
-        table->AddRow({name, author, players, landscapeNames[header.getGfxSet()], size, filePath.string()});
-    }
-}
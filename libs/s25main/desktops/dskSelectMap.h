@@ -10,6 +10,8 @@
 #include "liblobby/LobbyInterface.h"
 #include <boost/filesystem/path.hpp>
 #include <boost/signals2/connection.hpp>
+#include <future>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -17,6 +19,10 @@
 namespace boost {
 class thread;
 }
+namespace libsiedler2 {
+class ArchivItem_Map;
+}
+class MapCatalog;
 
 class dskSelectMap final : public Desktop, public LobbyInterface
 {
@@ -27,7 +33,10 @@ public:
 private:
     void Draw_() override;
 
-    void FillTable(const std::vector<boost::filesystem::path>& files);
+    /// Add the maps found by the catalog scan to the table and finish the table when the scan is done
+    void AddScannedMaps();
+    /// Show the preview map once it is loaded
+    void UpdatePreview();
 
     void Msg_OptionGroupChange(unsigned ctrl_id, unsigned selection) override;
     void Msg_ButtonClick(unsigned ctrl_id) override;
@@ -64,5 +73,18 @@ private:
     std::map<uint8_t, std::string> landscapeNames;
     /// Maps that we already know are broken
     std::set<boost::filesystem::path> brokenMapPaths;
+    /// Header information of the maps, read in the background
+    std::unique_ptr<MapCatalog> mapCatalog_;
+    /// True until all maps of the current scan were added to the table
+    bool isScanPending_;
+    /// Number of broken maps found during the current scan
+    unsigned numNewBrokenMaps_;
+    /// Path of a map to select once the scan is finished
+    std::string mapToSelect_;
+    /// Path of the selected map and the map itself which is loaded in the background for the preview
+    std::string previewMapPath_;
+    std::future<std::unique_ptr<libsiedler2::ArchivItem_Map>> previewMap_;
+    /// Still running loads of previously selected maps. Kept as destroying their futures would block until done
+    std::vector<std::future<std::unique_ptr<libsiedler2::ArchivItem_Map>>> abandonedPreviewMaps_;
     boost::signals2::scoped_connection onErrorConnection_;
 };
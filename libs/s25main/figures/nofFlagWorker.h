@@ -5,13 +5,14 @@
 #pragma once
 
 #include "figures/noFigure.h"
+#include "helpers/IntrusiveList.h"
 
 class noFlag;
 class SerializedGameData;
 class noRoadNode;
 
 /// Basisklasse für Geologen und Späher, also die, die an eine Flagge gebunden sind zum Arbeiten
-class nofFlagWorker : public noFigure
+class nofFlagWorker : public noFigure, public helpers::IntrusiveListHook<nofFlagWorker>
 {
 protected:
     /// Flaggen-Ausgangspunkt
@@ -8,7 +8,7 @@
 #include "s25util/Log.h"
 #include <boost/nowide/fstream.hpp>
 #include <bzlib.h>
-#include <cmath>
+#include <algorithm>
 #include <stdexcept>
 
 bool CompressedData::DecompressToFile(const boost::filesystem::path& filePath, unsigned* checksum) const
@@ -23,16 +23,17 @@ bool CompressedData::DecompressToFile(const boost::filesystem::path& filePath, u
 
     try
     {
-        const auto uncompressedData = decompress(data, uncompressedLength);
-
-        if(!file.write(uncompressedData.data(), uncompressedData.size()))
-        {
-            LOG.write("FATAL ERROR: Writing to %1% failed\n") % filePath;
-            return false;
-        }
+        // Write chunk-wise, so the uncompressed data is never held in memory as a whole.
+        // The checksum is a plain sum of all bytes and can hence be calculated per chunk
+        unsigned curChecksum = 0;
+        decompress(data.data(), data.size(), uncompressedLength, [&](const char* chunk, size_t chunkSize) {
+            if(!file.write(chunk, chunkSize))
+                throw std::runtime_error(helpers::format("Writing to %1% failed", filePath));
+            curChecksum += CalcChecksumOfBuffer(chunk, chunkSize);
+        });
 
         if(checksum)
-            *checksum = CalcChecksumOfBuffer(uncompressedData);
+            *checksum = curChecksum;
     } catch(const std::runtime_error& err)
     {
         LOG.write("FATAL ERROR: %1%\n") % err.what();
@@ -69,34 +70,97 @@ bool CompressedData::CompressFromFile(const boost::filesystem::path& filePath, u
     return true;
 }
 
+namespace {
+/// Size of the chunks used for streaming (de)compression
+constexpr unsigned CHUNK_SIZE = 64 * 1024;
+} // namespace
+
 std::vector<char> CompressedData::compress(const std::vector<char>& data)
 {
-    // Buffer should be at most 1% bigger + 600 Bytes according to docu
-    auto compressedLen = static_cast<unsigned>(std::ceil(data.size() * 1.01)) + 600u;
-    std::vector<char> compressedData(compressedLen);
+    return compress(data.data(), data.size());
+}
 
-    const int err = BZ2_bzBuffToBuffCompress(compressedData.data(), &compressedLen, const_cast<char*>(data.data()),
-                                             data.size(), 9, 0, 250);
+std::vector<char> CompressedData::compress(const void* data, size_t size)
+{
+    bz_stream stream{};
+    int err = BZ2_bzCompressInit(&stream, 9, 0, 250);
     if(err != BZ_OK)
-        throw std::runtime_error(helpers::format("BZ2_bzBuffToBuffCompress failed with error: %1%", err));
-    compressedData.resize(compressedLen);
+        throw std::runtime_error(helpers::format("BZ2_bzCompressInit failed with error: %1%", err));
+
+    std::vector<char> compressedData;
+    auto* input = static_cast<char*>(const_cast<void*>(data));
+    size_t remaining = size;
+    do
+    {
+        // bzip2 uses unsigned lengths so feed at most one chunk at a time
+        if(stream.avail_in == 0u && remaining > 0u)
+        {
+            stream.next_in = input;
+            stream.avail_in = static_cast<unsigned>(std::min<size_t>(remaining, CHUNK_SIZE));
+            input += stream.avail_in;
+            remaining -= stream.avail_in;
+        }
+        const size_t oldSize = compressedData.size();
+        compressedData.resize(oldSize + CHUNK_SIZE);
+        stream.next_out = compressedData.data() + oldSize;
+        stream.avail_out = CHUNK_SIZE;
+        err = BZ2_bzCompress(&stream, (remaining > 0u) ? BZ_RUN : BZ_FINISH);
+        compressedData.resize(compressedData.size() - stream.avail_out);
+    } while(err == BZ_RUN_OK || err == BZ_FINISH_OK);
+    BZ2_bzCompressEnd(&stream);
+
+    if(err != BZ_STREAM_END)
+        throw std::runtime_error(helpers::format("BZ2_bzCompress failed with error: %1%", err));
     return compressedData;
 }
 
 std::vector<char> CompressedData::decompress(const std::vector<char>& data, size_t const uncompressedSize)
 {
-    std::vector<char> uncompressedData(uncompressedSize);
-
-    unsigned outLength = uncompressedSize;
+    std::vector<char> uncompressedData;
+    uncompressedData.reserve(uncompressedSize);
+    decompress(data.data(), data.size(), uncompressedSize, [&uncompressedData](const char* chunk, size_t chunkSize) {
+        uncompressedData.insert(uncompressedData.end(), chunk, chunk + chunkSize);
+    });
+    return uncompressedData;
+}
 
-    const int err = BZ2_bzBuffToBuffDecompress(uncompressedData.data(), &outLength, const_cast<char*>(data.data()),
-                                               data.size(), 0, 0);
+void CompressedData::decompress(const void* data, size_t size, size_t const uncompressedSize,
+                                const std::function<void(const char*, size_t)>& onChunk)
+{
+    bz_stream stream{};
+    int err = BZ2_bzDecompressInit(&stream, 0, 0);
     if(err != BZ_OK)
-        throw std::runtime_error(helpers::format("BZ2_bzBuffToBuffDecompress failed with error: %1%", err));
+        throw std::runtime_error(helpers::format("BZ2_bzDecompressInit failed with error: %1%", err));
+
+    std::vector<char> chunk(CHUNK_SIZE);
+    stream.next_in = static_cast<char*>(const_cast<void*>(data));
+    stream.avail_in = static_cast<unsigned>(size);
+    size_t outLength = 0;
+    do
+    {
+        stream.next_out = chunk.data();
+        stream.avail_out = CHUNK_SIZE;
+        err = BZ2_bzDecompress(&stream);
+        const size_t chunkSize = CHUNK_SIZE - stream.avail_out;
+        if(err != BZ_OK && err != BZ_STREAM_END)
+            break;
+        outLength += chunkSize;
+        if(outLength > uncompressedSize)
+            break;
+        if(chunkSize > 0u)
+            onChunk(chunk.data(), chunkSize);
+        // No progress possible without more input -> truncated data
+        if(err == BZ_OK && stream.avail_in == 0u && chunkSize == 0u)
+        {
+            err = BZ_UNEXPECTED_EOF;
+            break;
+        }
+    } while(err == BZ_OK);
+    BZ2_bzDecompressEnd(&stream);
 
-    if(outLength != uncompressedSize)
+    if(err != BZ_OK && err != BZ_STREAM_END)
+        throw std::runtime_error(helpers::format("BZ2_bzDecompress failed with error: %1%", err));
+    if(err != BZ_STREAM_END || outLength != uncompressedSize)
         throw std::runtime_error(
           helpers::format("Length mismatch after decompressing. Expected: %1%, got %2%", uncompressedSize, outLength));
-
-    return uncompressedData;
 }
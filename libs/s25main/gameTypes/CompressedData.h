@@ -5,6 +5,7 @@
 #pragma once
 
 #include <boost/filesystem/path.hpp>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -26,5 +27,11 @@ struct CompressedData
     std::vector<char> data;
 
     static std::vector<char> compress(const std::vector<char>& data);
+    /// Compress the buffer in chunks, so no worst-case sized output buffer and no copy of the input is required
+    static std::vector<char> compress(const void* data, size_t size);
     static std::vector<char> decompress(const std::vector<char>& data, size_t uncompressedSize);
+    /// Decompress the data in chunks passing each decompressed chunk to the callback.
+    /// Throws if the data is invalid or does not decompress to exactly uncompressedSize bytes
+    static void decompress(const void* data, size_t size, size_t uncompressedSize,
+                           const std::function<void(const char*, size_t)>& onChunk);
 };
@@ -7,7 +7,7 @@
 #include "enum_cast.hpp"
 #include <algorithm>
 
-FoWNode::FoWNode() : last_update_time(0), visibility(Visibility::Invisible), owner(0)
+FoWNode::FoWNode() : last_update_time(0), visibility(Visibility::Invisible), object(nullptr), owner(0)
 {
     std::fill(roads.begin(), roads.end(), PointRoad::None);
     std::fill(boundary_stones.begin(), boundary_stones.end(), 0);
@@ -20,7 +20,7 @@ void FoWNode::Serialize(SerializedGameData& sgd) const
     if(visibility == Visibility::FogOfWar)
     {
         sgd.PushUnsignedInt(last_update_time);
-        sgd.PushFOWObject(object.get());
+        sgd.PushFOWObject(object);
         helpers::pushContainer(sgd, roads);
         sgd.PushUnsignedChar(owner);
         helpers::pushContainer(sgd, boundary_stones);
@@ -41,7 +41,7 @@ void FoWNode::Deserialize(SerializedGameData& sgd)
     } else
     {
         last_update_time = 0;
-        object.reset();
+        object = nullptr;
         std::fill(roads.begin(), roads.end(), PointRoad::None);
         owner = 0;
         std::fill(boundary_stones.begin(), boundary_stones.end(), 0);
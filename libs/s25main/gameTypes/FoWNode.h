@@ -49,8 +49,8 @@ struct FoWNode
     unsigned last_update_time;
     /// Sichtbarkeit des Punktes
     Visibility visibility;
-    /// FOW-Objekt
-    std::unique_ptr<FOWObject> object;
+    /// FOW-Objekt (shared, see FOWObject)
+    const FOWObject* object;
     helpers::EnumArray<PointRoad, RoadDir> roads;
     unsigned char owner;
     BoundaryStones boundary_stones;
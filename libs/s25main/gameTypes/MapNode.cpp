@@ -71,7 +71,11 @@ void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, co
     for(unsigned z = 0; z < numPlayers; ++z)
         fow[z].Deserialize(sgd);
     obj = sgd.PopObject<noBase>();
-    sgd.PopObjectContainer(figures);
+    std::vector<std::unique_ptr<noBase>> figuresTmp;
+    sgd.PopObjectContainer(figuresTmp);
+    figures.clear();
+    for(auto& figure : figuresTmp)
+        figures.push_back(std::move(figure));
     seaId = sgd.PopUnsignedShort();
     harborId = sgd.PopUnsignedInt();
 }
@@ -11,8 +11,8 @@
 #include "gameTypes/MapTypes.h"
 #include "gameData/DescIdx.h"
 #include "gameData/MaxPlayers.h"
+#include "nodeObjs/FigureList.h"
 #include <array>
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -52,7 +52,7 @@ struct MapNode
     /// Objekt, welches sich dort befindet
     noBase* obj;
     /// Figures or fights on this node
-    std::list<std::unique_ptr<noBase>> figures;
+    FigureList figures;
 
     MapNode();
     MapNode(const MapNode&) = delete;
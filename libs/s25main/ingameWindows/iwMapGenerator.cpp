@@ -23,13 +23,13 @@ iwMapGenerator::iwMapGenerator(MapSettings& settings)
                    LOADER.GetImageN("resource", 41), true, CloseBehavior::Custom),
       mapSettings(settings)
 {
-    WorldDescription desc;
-    GameDataLoader gdLoader(desc);
-    if(!gdLoader.Load())
+    const auto gameData = loadSharedGameData();
+    if(!gameData)
     {
         Close();
         return;
     }
+    const WorldDescription& desc = *gameData;
 
     DrawPoint curPos(20, 0);
 
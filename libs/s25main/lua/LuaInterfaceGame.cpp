@@ -5,9 +5,11 @@
 #include "LuaInterfaceGame.h"
 #include "EventManager.h"
 #include "Game.h"
+#include "SerializedGameData.h"
 #include "WindowManager.h"
 #include "ai/AIInterface.h"
 #include "ai/AIPlayer.h"
+#include "helpers/serializePoint.h"
 #include "ingameWindows/iwMissionStatement.h"
 #include "lua/LuaHelpers.h"
 #include "lua/LuaPlayer.h"
@@ -19,7 +21,8 @@
 #include "s25util/strAlgos.h"
 
 LuaInterfaceGame::LuaInterfaceGame(Game& gameInstance, ILocalGameState& localGameState)
-    : LuaInterfaceGameBase(localGameState), localGameState(localGameState), gw(gameInstance.world_), game(gameInstance)
+    : LuaInterfaceGameBase(localGameState), localGameState(localGameState), gw(gameInstance.world_), game(gameInstance),
+      gameFrameInterval_(1)
 {
 #pragma region ConstDefs
 #define ADD_LUA_CONST(name) lua["BLD_" + s25util::toUpper(#name)] = BuildingType::name
@@ -193,6 +196,7 @@ void LuaInterfaceGame::Register(kaguya::State& state)
                                  .addFunction("GetGF", &LuaInterfaceGame::GetGF)
                                  .addFunction("FormatNumGFs", &LuaInterfaceGame::FormatNumGFs)
                                  .addFunction("GetGameFrame", &LuaInterfaceGame::GetGF)
+                                 .addFunction("SetGameFrameInterval", &LuaInterfaceGame::SetGameFrameInterval)
                                  .addFunction("GetNumPlayers", &LuaInterfaceGame::GetNumPlayers)
                                  .addFunction("Chat", &LuaInterfaceGame::Chat)
                                  .addOverloadedFunctions("MissionStatement", &LuaInterfaceGame::MissionStatement,
@@ -242,6 +246,52 @@ bool LuaInterfaceGame::Deserialize(Serializer& luaSaveState)
         return true;
 }
 
+void LuaInterfaceGame::SerializeEventState(SerializedGameData& sgd) const
+{
+    sgd.PushUnsignedInt(gameFrameInterval_);
+    sgd.PushVarSize(exploredBatch_.size());
+    for(const auto& points : exploredBatch_)
+    {
+        sgd.PushVarSize(points.size());
+        for(const ExploredPoint& explPt : points)
+        {
+            helpers::pushPoint(sgd, explPt.pt);
+            sgd.PushUnsignedChar(explPt.owner);
+        }
+    }
+    sgd.PushVarSize(occupiedBatch_.size());
+    for(const auto& points : occupiedBatch_)
+    {
+        sgd.PushVarSize(points.size());
+        for(const MapPoint pt : points)
+            helpers::pushPoint(sgd, pt);
+    }
+}
+
+void LuaInterfaceGame::DeserializeEventState(SerializedGameData& sgd)
+{
+    gameFrameInterval_ = sgd.PopUnsignedInt();
+    if(gameFrameInterval_ == 0)
+        throw SerializedGameData::Error("Invalid game frame interval for lua");
+    exploredBatch_.resize(sgd.PopVarSize());
+    for(auto& points : exploredBatch_)
+    {
+        points.resize(sgd.PopVarSize());
+        for(ExploredPoint& explPt : points)
+        {
+            explPt.pt = sgd.PopMapPoint();
+            explPt.owner = sgd.PopUnsignedChar();
+        }
+    }
+    occupiedBatch_.resize(sgd.PopVarSize());
+    for(auto& points : occupiedBatch_)
+    {
+        points.resize(sgd.PopVarSize());
+        for(MapPoint& pt : points)
+            pt = sgd.PopMapPoint();
+    }
+}
+
 void LuaInterfaceGame::ClearResources()
 {
     for(unsigned p = 0; p < gw.GetNumPlayers(); p++)
@@ -253,6 +303,12 @@ unsigned LuaInterfaceGame::GetGF() const
     return gw.GetEvMgr().GetCurrentGF();
 }
 
+void LuaInterfaceGame::SetGameFrameInterval(unsigned interval)
+{
+    lua::assertTrue(interval > 0u, "Interval must be positive");
+    gameFrameInterval_ = interval;
+}
+
 std::string LuaInterfaceGame::FormatNumGFs(unsigned numGFs) const
 {
     return localGameState.FormatGFTime(numGFs);
@@ -326,9 +382,9 @@ LuaWorld LuaInterfaceGame::GetWorld()
 
 void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigned char owner)
 {
-    kaguya::LuaRef onExplored = lua["onExplored"];
-    if(onExplored.type() == LUA_TFUNCTION)
+    if(isFunctionDefined("onExplored"))
     {
+        kaguya::LuaRef onExplored = lua["onExplored"];
         if(owner == 0)
         {
             // No owner? Pass nil value to Lua.
@@ -339,13 +395,27 @@ void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigne
             onExplored.call<void>(player, pt.x, pt.y, owner - 1);
         }
     }
+    if(isFunctionDefined("onExploredBatch"))
+    {
+        if(player >= exploredBatch_.size())
+            exploredBatch_.resize(player + 1);
+        exploredBatch_[player].push_back(ExploredPoint{pt, owner});
+    }
 }
 
 void LuaInterfaceGame::EventOccupied(unsigned player, const MapPoint pt)
 {
-    kaguya::LuaRef onOccupied = lua["onOccupied"];
-    if(onOccupied.type() == LUA_TFUNCTION)
+    if(isFunctionDefined("onOccupied"))
+    {
+        kaguya::LuaRef onOccupied = lua["onOccupied"];
         onOccupied.call<void>(player, pt.x, pt.y);
+    }
+    if(isFunctionDefined("onOccupiedBatch"))
+    {
+        if(player >= occupiedBatch_.size())
+            occupiedBatch_.resize(player + 1);
+        occupiedBatch_[player].push_back(pt);
+    }
 }
 
 void LuaInterfaceGame::EventStart(bool isFirstStart)
@@ -357,9 +427,66 @@ void LuaInterfaceGame::EventStart(bool isFirstStart)
 
 void LuaInterfaceGame::EventGameFrame(unsigned nr)
 {
-    kaguya::LuaRef onGameFrame = lua["onGameFrame"];
-    if(onGameFrame.type() == LUA_TFUNCTION)
+    FlushEventBatches();
+    if(nr % gameFrameInterval_ == 0 && isFunctionDefined("onGameFrame"))
+    {
+        kaguya::LuaRef onGameFrame = lua["onGameFrame"];
         onGameFrame.call<void>(nr);
+    }
+}
+
+bool LuaInterfaceGame::isFunctionDefined(const char* name)
+{
+    lua_State* state = lua.state();
+    lua_getglobal(state, name);
+    const bool result = lua_type(state, -1) == LUA_TFUNCTION;
+    lua_pop(state, 1);
+    return result;
+}
+
+void LuaInterfaceGame::FlushEventBatches()
+{
+    // Swap out first as the handlers might trigger new events
+    std::vector<std::vector<ExploredPoint>> explored;
+    std::vector<std::vector<MapPoint>> occupied;
+    std::swap(explored, exploredBatch_);
+    std::swap(occupied, occupiedBatch_);
+
+    for(unsigned player = 0; player < explored.size(); player++)
+    {
+        if(explored[player].empty() || !isFunctionDefined("onExploredBatch"))
+            continue;
+        kaguya::LuaTable points = lua.newTable();
+        int idx = 1;
+        for(const ExploredPoint& explPt : explored[player])
+        {
+            kaguya::LuaTable point = lua.newTable();
+            point["x"] = explPt.pt.x;
+            point["y"] = explPt.pt.y;
+            // Owner is nil if the point is not owned, else the player index
+            if(explPt.owner != 0)
+                point["owner"] = explPt.owner - 1;
+            points[idx++] = point;
+        }
+        kaguya::LuaRef onExploredBatch = lua["onExploredBatch"];
+        onExploredBatch.call<void>(player, points);
+    }
+    for(unsigned player = 0; player < occupied.size(); player++)
+    {
+        if(occupied[player].empty() || !isFunctionDefined("onOccupiedBatch"))
+            continue;
+        kaguya::LuaTable points = lua.newTable();
+        int idx = 1;
+        for(const MapPoint pt : occupied[player])
+        {
+            kaguya::LuaTable point = lua.newTable();
+            point["x"] = pt.x;
+            point["y"] = pt.y;
+            points[idx++] = point;
+        }
+        kaguya::LuaRef onOccupiedBatch = lua["onOccupiedBatch"];
+        onOccupiedBatch.call<void>(player, points);
+    }
 }
 
 void LuaInterfaceGame::EventResourceFound(unsigned char player, const MapPoint pt, ResourceType type,
@@ -9,11 +9,13 @@
 #include "gameTypes/PactTypes.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 class GameWorld;
 class LuaPlayer;
 class LuaWorld;
 class Serializer;
+class SerializedGameData;
 class Game;
 enum class ResourceType : uint8_t;
 
@@ -28,10 +30,16 @@ public:
 
     bool Serialize(Serializer& luaSaveState);
     bool Deserialize(Serializer& luaSaveState);
+    /// Save/Load the state kept on the C++ side (GF interval and the not yet delivered batches)
+    void SerializeEventState(SerializedGameData& sgd) const;
+    void DeserializeEventState(SerializedGameData& sgd);
 
+    /// Call onExplored and/or collect the point for onExploredBatch
     void EventExplored(unsigned player, MapPoint pt, unsigned char owner);
+    /// Call onOccupied and/or collect the point for onOccupiedBatch
     void EventOccupied(unsigned player, MapPoint pt);
     void EventStart(bool isFirstStart);
+    /// Deliver the collected batches and call onGameFrame (if the GF matches the requested interval)
     void EventGameFrame(unsigned nr);
     void EventResourceFound(unsigned char player, MapPoint pt, ResourceType type, unsigned char quantity);
     // Called if player wants to cancel a pact
@@ -47,6 +55,7 @@ public:
     // Callable from Lua
     void ClearResources();
     unsigned GetGF() const;
+    void SetGameFrameInterval(unsigned interval);
     std::string FormatNumGFs(unsigned numGFs) const;
     unsigned GetNumPlayers() const;
     void Chat(int playerIdx, const std::string& msg);
@@ -62,6 +71,21 @@ private:
     ILocalGameState& localGameState;
     GameWorld& gw;
     Game& game;
+
+    struct ExploredPoint
+    {
+        MapPoint pt;
+        unsigned char owner;
+    };
+    /// onGameFrame is only called every n-th GF
+    unsigned gameFrameInterval_;
+    /// Points per player collected for the batch handlers since the last GF
+    std::vector<std::vector<ExploredPoint>> exploredBatch_;
+    std::vector<std::vector<MapPoint>> occupiedBatch_;
+
+    /// Check if a global function with the given name exists without creating a LuaRef
+    bool isFunctionDefined(const char* name);
+    void FlushEventBatches();
     LuaPlayer GetPlayer(int playerIdx);
     LuaWorld GetWorld();
 };
@@ -4,33 +4,64 @@
 
 #include "mapGenerator/Algorithms.h"
 #include "helpers/mathFuncs.h"
+#include <cstdlib>
 
 namespace rttr { namespace mapGenerator {
 
     void UpdateDistances(NodeMapBase<unsigned>& distances, std::queue<MapPoint>& queue)
     {
-        while(!queue.empty())
+        std::vector<MapPoint> queuedPoints;
+        queuedPoints.reserve(queue.size());
+        for(; !queue.empty(); queue.pop())
+            queuedPoints.push_back(queue.front());
+        UpdateDistances(distances, queuedPoints);
+    }
+
+    void UpdateDistances(NodeMapBase<unsigned>& distances, std::vector<MapPoint>& queue)
+    {
+        // Every point is added at most once after the initial ones (when its distance is set for the first time)
+        queue.reserve(queue.size() + prodOfComponents(distances.GetSize()));
+        for(size_t i = 0; i < queue.size(); ++i)
         {
-            const auto currentPoint = queue.front();
+            const auto currentPoint = queue[i];
             const auto currentDistance = distances[currentPoint];
 
-            queue.pop();
-
-            const auto& neighbors = distances.GetNeighbours(currentPoint);
-
-            for(const MapPoint& neighbor : neighbors)
+            for(const MapPoint& neighbor : distances.GetNeighbours(currentPoint))
             {
                 if(distances[neighbor] > 0)
                 {
                     if(distances[neighbor] == unsigned(-1))
                     {
-                        queue.push(neighbor);
+                        queue.push_back(neighbor);
                     }
 
                     distances[neighbor] = std::min(distances[neighbor], currentDistance + 1);
                 }
             }
         }
+        queue.clear();
+    }
+
+    std::vector<KernelRow> GetKernelRows(unsigned radius, bool isOddRow)
+    {
+        std::vector<KernelRow> rows;
+        rows.reserve(2 * radius + 1);
+        const int r = static_cast<int>(radius);
+        for(int rowOffset = -r; rowOffset <= r; rowOffset++)
+        {
+            // The left most node is reached by going diagonally to the row (NW or SW) and then west for the remaining
+            // steps. Diagonal steps only move left when starting in an even row.
+            const int numDiagonalSteps = std::abs(rowOffset);
+            const int numEvenRowSteps = isOddRow ? numDiagonalSteps / 2 : (numDiagonalSteps + 1) / 2;
+            const int startOffset = -(r - numDiagonalSteps) - numEvenRowSteps;
+            rows.push_back(KernelRow{rowOffset, startOffset, static_cast<unsigned>(2 * r + 1 - numDiagonalSteps)});
+        }
+        return rows;
+    }
+
+    bool CanUseKernelRows(const MapExtent& size, unsigned radius)
+    {
+        return size.x > 2 * radius && size.y > 2 * radius;
     }
 
     void FlattenForCastleBuilding(NodeMapBase<uint8_t>& heightMap, MapPoint pos)
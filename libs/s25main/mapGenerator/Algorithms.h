@@ -6,12 +6,16 @@
 
 #include "RttrForeachPt.h"
 #include "helpers/containerUtils.h"
+#include "helpers/parallelFor.h"
 #include "mapGenerator/NodeMapUtilities.h"
 #include "world/NodeMapBase.h"
+#include <array>
 #include <cmath>
 #include <queue>
 #include <set>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace rttr { namespace mapGenerator {
 
@@ -27,8 +31,68 @@ namespace rttr { namespace mapGenerator {
         return joined;
     }
 
+    /// One row of the hexagonal smoothing kernel: All nodes in row y + rowOffset from x + startOffset on
+    struct KernelRow
+    {
+        int rowOffset;
+        int startOffset;
+        unsigned width;
+    };
+
+    /**
+     * Returns the rows of the nodes within the radius around a node (the node itself included), which is the same set
+     * of nodes as returned by GetPointsInRadius. The rows depend on whether the node is in an odd or even row.
+     */
+    std::vector<KernelRow> GetKernelRows(unsigned radius, bool isOddRow);
+
+    /// Whether the kernel rows match GetPointsInRadius for every node, i.e. the kernel does not overlap itself due to
+    /// wrapping around the map borders
+    bool CanUseKernelRows(const MapExtent& size, unsigned radius);
+
+    namespace detail {
+        /// Sum of the values of the kernel around the start of the row, reading the values from src
+        template<typename T>
+        int GetKernelSum(const NodeMapBase<T>& src, const std::vector<KernelRow>& kernel, MapCoord y)
+        {
+            const MapExtent& size = src.GetSize();
+            int sum = 0;
+            for(const KernelRow& row : kernel)
+            {
+                const auto curY = static_cast<MapCoord>((y + row.rowOffset + size.y) % size.y);
+                for(unsigned i = 0; i < row.width; i++)
+                {
+                    const auto curX = static_cast<MapCoord>((row.startOffset + static_cast<int>(i) + size.x) % size.x);
+                    sum += static_cast<int>(src[MapPoint(curX, curY)]);
+                }
+            }
+            return sum;
+        }
+
+        /// Move the kernel sum from x to x + 1 by removing the left most and adding the next right column
+        template<typename T>
+        int MoveKernelSum(int sum, const NodeMapBase<T>& src, const std::vector<KernelRow>& kernel, MapPoint pt)
+        {
+            const MapExtent& size = src.GetSize();
+            for(const KernelRow& row : kernel)
+            {
+                const auto curY = static_cast<MapCoord>((pt.y + row.rowOffset + size.y) % size.y);
+                const int firstX = pt.x + row.startOffset + size.x;
+                sum -= static_cast<int>(src[MapPoint(static_cast<MapCoord>(firstX % size.x), curY)]);
+                sum += static_cast<int>(src[MapPoint(static_cast<MapCoord>((firstX + row.width) % size.x), curY)]);
+            }
+            return sum;
+        }
+
+        template<typename T>
+        T GetSmoothedValue(int sum, unsigned numValues)
+        {
+            return static_cast<T>(round(static_cast<double>(sum) / numValues));
+        }
+    } // namespace detail
+
     /**
      * Smoothes the specified nodes with a smoothing kernel of the specified extent (radius).
+     * Nodes are updated in place in row order, so already smoothed values are used for the following nodes.
      *
      * @param iteration number of times to apply smoothing kernel to every node
      * @param radius extent of the smoothing kernel
@@ -38,27 +102,97 @@ namespace rttr { namespace mapGenerator {
     void Smooth(unsigned iterations, unsigned radius, NodeMapBase<T>& nodes)
     {
         const MapExtent& size = nodes.GetSize();
-        std::vector<std::vector<MapPoint>> neighbors(size.x * size.y);
-
-        RTTR_FOREACH_PT(MapPoint, size)
+        if(!CanUseKernelRows(size, radius))
         {
-            neighbors[nodes.GetIdx(pt)] = nodes.GetPointsInRadius(pt, radius);
+            // Small map where the kernel wraps onto itself, so use the points exactly as returned
+            for(unsigned i = 0; i < iterations; ++i)
+            {
+                RTTR_FOREACH_PT(MapPoint, size)
+                {
+                    int sum = static_cast<int>(nodes[pt]);
+                    const auto neighborPoints = nodes.GetPointsInRadius(pt, radius);
+                    for(const MapPoint& p : neighborPoints)
+                        sum += static_cast<int>(nodes[p]);
+                    nodes[pt] = detail::GetSmoothedValue<T>(sum, neighborPoints.size() + 1);
+                }
+            }
+            return;
         }
 
+        // Running sum over the kernel rows which is adjusted for every value changed inside the kernel
+        const std::array<std::vector<KernelRow>, 2> kernels = {
+          {GetKernelRows(radius, false), GetKernelRows(radius, true)}};
+        const unsigned numValues = 3 * radius * (radius + 1) + 1;
         for(unsigned i = 0; i < iterations; ++i)
         {
-            RTTR_FOREACH_PT(MapPoint, size)
+            for(MapPoint pt(0, 0); pt.y < size.y; pt.y++)
             {
-                int sum = static_cast<int>(nodes[pt]);
-                const auto& neighborPoints = neighbors[nodes.GetIdx(pt)];
-
-                for(const MapPoint& p : neighborPoints)
+                const std::vector<KernelRow>& kernel = kernels[pt.y & 1];
+                int sum = detail::GetKernelSum(nodes, kernel, pt.y);
+                for(pt.x = 0; pt.x < size.x; pt.x++)
                 {
-                    sum += static_cast<int>(nodes[p]);
+                    const T oldValue = nodes[pt];
+                    nodes[pt] = detail::GetSmoothedValue<T>(sum, numValues);
+                    sum += static_cast<int>(nodes[pt]) - static_cast<int>(oldValue);
+                    if(pt.x + 1u < size.x)
+                        sum = detail::MoveKernelSum(sum, nodes, kernel, pt);
                 }
+            }
+        }
+    }
 
-                nodes[pt] = static_cast<T>(round(static_cast<double>(sum) / (neighborPoints.size() + 1)));
+    /**
+     * Same as Smooth but reads all values of an iteration from a copy of the previous iteration (double buffer).
+     * Rows are processed in parallel using up to numThreads threads (0 = all cores) and the result does not depend on
+     * the number of threads. It differs from the result of Smooth which uses the values smoothed in place, so it is
+     * only used where maps don't need to match those generated by Smooth for the same seed.
+     */
+    template<typename T>
+    void SmoothParallel(unsigned iterations, unsigned radius, NodeMapBase<T>& nodes, unsigned numThreads = 0)
+    {
+        const MapExtent size = nodes.GetSize();
+        NodeMapBase<T> src = nodes;
+        if(!CanUseKernelRows(size, radius))
+        {
+            for(unsigned i = 0; i < iterations; ++i)
+            {
+                std::swap(src, nodes);
+                helpers::parallelFor(
+                  size.y,
+                  [&src, &nodes, radius, size](unsigned y) {
+                      for(MapPoint pt(0, y); pt.x < size.x; pt.x++)
+                      {
+                          int sum = static_cast<int>(src[pt]);
+                          const auto neighborPoints = src.GetPointsInRadius(pt, radius);
+                          for(const MapPoint& p : neighborPoints)
+                              sum += static_cast<int>(src[p]);
+                          nodes[pt] = detail::GetSmoothedValue<T>(sum, neighborPoints.size() + 1);
+                      }
+                  },
+                  numThreads);
             }
+            return;
+        }
+
+        const std::array<std::vector<KernelRow>, 2> kernels = {
+          {GetKernelRows(radius, false), GetKernelRows(radius, true)}};
+        const unsigned numValues = 3 * radius * (radius + 1) + 1;
+        for(unsigned i = 0; i < iterations; ++i)
+        {
+            std::swap(src, nodes);
+            helpers::parallelFor(
+              size.y,
+              [&src, &nodes, &kernels, numValues, size](unsigned y) {
+                  const std::vector<KernelRow>& kernel = kernels[y & 1];
+                  int sum = detail::GetKernelSum(src, kernel, static_cast<MapCoord>(y));
+                  for(MapPoint pt(0, y); pt.x < size.x; pt.x++)
+                  {
+                      nodes[pt] = detail::GetSmoothedValue<T>(sum, numValues);
+                      if(pt.x + 1u < size.x)
+                          sum = detail::MoveKernelSum(sum, src, kernel, pt);
+                  }
+              },
+              numThreads);
         }
     }
 
@@ -104,42 +238,40 @@ namespace rttr { namespace mapGenerator {
      * @param map reference to the map to collect map points from
      * @param pt starting point which has to be evaluated with 'true' or and empty vector will be returned
      * @param evaluator evaluator function which returns 'true' or 'false' for any map point
+     * @param visited all evaluated points are added to it and points already contained are skipped. Can be reused for
+     * multiple calls with the same evaluator to find all connected areas without evaluating points more than once.
      *
      * @returns a list of map points where every point is connected to at least one other point of the least which
      * has also been evaluated positively.
      */
     template<typename T>
-    std::vector<MapPoint> Collect(const MapBase& map, const MapPoint& pt, T&& evaluator)
+    std::vector<MapPoint> Collect(const MapBase& map, const MapPoint& pt, T&& evaluator, NodeSet& visited)
     {
-        std::set<MapPoint, MapPointLess> visited;
         std::vector<MapPoint> body;
-        std::queue<MapPoint> searchSpace;
-
-        searchSpace.push(pt);
+        if(!visited.insert(pt) || !evaluator(pt))
+            return body;
+        body.push_back(pt);
 
-        while(!searchSpace.empty())
+        // The body is also the queue of the search as only positively evaluated points are expanded
+        for(size_t i = 0; i < body.size(); ++i)
         {
-            MapPoint currentPoint = searchSpace.front();
-            searchSpace.pop();
-
-            if(evaluator(currentPoint))
+            for(const MapPoint neighbor : map.GetNeighbours(body[i]))
             {
-                if(visited.insert(currentPoint).second)
-                {
-                    body.push_back(currentPoint);
-
-                    const auto& neighbors = map.GetNeighbours(currentPoint);
-                    for(MapPoint neighbor : neighbors)
-                    {
-                        searchSpace.push(neighbor);
-                    }
-                }
+                if(visited.insert(neighbor) && evaluator(neighbor))
+                    body.push_back(neighbor);
             }
         }
 
         return body;
     }
 
+    template<typename T>
+    std::vector<MapPoint> Collect(const MapBase& map, const MapPoint& pt, T&& evaluator)
+    {
+        NodeSet visited(map.GetSize());
+        return Collect(map, pt, std::forward<T>(evaluator), visited);
+    }
+
     /**
      * Updates the specified distance values to the values initially contained by the queue. The queue is being
      * modified throughout the process for performance reasons.
@@ -149,6 +281,16 @@ namespace rttr { namespace mapGenerator {
      */
     void UpdateDistances(NodeMapBase<unsigned>& distances, std::queue<MapPoint>& queue);
 
+    /**
+     * Multi-source breadth-first distance transform: Updates the distance values starting at the specified points.
+     * Points with a distance of unsigned(-1) are reached and expanded, points with a distance of 0 are never changed.
+     * The vector is used as the queue of the search and is cleared afterwards.
+     *
+     * @param distances distance map which is being updated
+     * @param queue initial elements used for the distance computation
+     */
+    void UpdateDistances(NodeMapBase<unsigned>& distances, std::vector<MapPoint>& queue);
+
     /**
      * Computes a map of distance values describing the distance of each grid position to the closest flagged point.
      *
@@ -160,15 +302,12 @@ namespace rttr { namespace mapGenerator {
     template<class T_Container>
     NodeMapBase<unsigned> DistancesTo(const T_Container& flaggedPoints, const MapExtent& size)
     {
-        std::queue<MapPoint> queue;
+        std::vector<MapPoint> queue(flaggedPoints.begin(), flaggedPoints.end());
         NodeMapBase<unsigned> distances;
         distances.Resize(size, unsigned(-1));
 
-        for(const MapPoint& pt : flaggedPoints)
-        {
+        for(const MapPoint& pt : queue)
             distances[pt] = 0;
-            queue.push(pt);
-        }
 
         UpdateDistances(distances, queue);
 
@@ -197,7 +336,7 @@ namespace rttr { namespace mapGenerator {
     NodeMapBase<unsigned> Distances(const MapExtent& size, const T_Container& area, const unsigned defaultValue,
                                     T&& evaluator)
     {
-        std::queue<MapPoint> queue;
+        std::vector<MapPoint> queue;
         NodeMapBase<unsigned> distances;
         distances.Resize(size, defaultValue);
 
@@ -206,7 +345,7 @@ namespace rttr { namespace mapGenerator {
             if(evaluator(pt))
             {
                 distances[pt] = 0;
-                queue.push(pt);
+                queue.push_back(pt);
             } else
             {
                 distances[pt] = unsigned(-1);
@@ -38,7 +38,7 @@ namespace rttr { namespace mapGenerator {
     std::vector<std::vector<MapPoint>> FindCoastlines(const Map& map, const std::vector<River>& rivers)
     {
         std::vector<std::vector<MapPoint>> coasts;
-        std::set<MapPoint, MapPointLess> visited;
+        NodeSet visited(map.size);
 
         const auto isCoast = [&map](const MapPoint& pt) {
             const auto allWater = [&map](const MapPoint& p) { return map.textureMap.All(p, IsWater); };
@@ -48,14 +48,11 @@ namespace rttr { namespace mapGenerator {
 
         RTTR_FOREACH_PT(MapPoint, map.size)
         {
-            if(visited.insert(pt).second)
+            if(!visited.contains(pt))
             {
-                if(isCoast(pt))
-                {
-                    const auto coast = Collect(map.getTextures(), pt, isCoast);
-                    coasts.push_back(coast);
-                    visited.insert(coast.begin(), coast.end());
-                }
+                auto coast = Collect(map.getTextures(), pt, isCoast, visited);
+                if(!coast.empty())
+                    coasts.push_back(std::move(coast));
             }
         }
 
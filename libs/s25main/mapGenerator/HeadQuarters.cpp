@@ -11,7 +11,7 @@ namespace rttr { namespace mapGenerator {
 
     std::vector<MapPoint> FindLargestConnectedArea(const Map& map)
     {
-        std::set<MapPoint, MapPointLess> visited;
+        NodeSet visited(map.size);
         std::vector<MapPoint> connectedArea;
 
         auto partiallyBuildable = [&map](const MapPoint& pt) { return map.textureMap.Any(pt, IsBuildableLand); };
@@ -22,11 +22,9 @@ namespace rttr { namespace mapGenerator {
 
         RTTR_FOREACH_PT(MapPoint, map.size)
         {
-            if(visited.insert(pt).second)
+            if(!visited.contains(pt))
             {
-                auto area = Collect(map.getTextures(), pt, partiallyConnected);
-
-                visited.insert(area.begin(), area.end());
+                auto area = Collect(map.getTextures(), pt, partiallyConnected, visited);
 
                 if(area.size() > connectedArea.size())
                     connectedArea = area;
@@ -0,0 +1,62 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mapGenerator/MapStatistics.h"
+#include "mapGenerator/Algorithms.h"
+#include "mapGenerator/TextureHelper.h"
+#include <algorithm>
+
+namespace rttr { namespace mapGenerator {
+
+    double MapStatistics::GetLandRatio() const
+    {
+        const unsigned numNodes = numLandNodes + numWaterNodes;
+        return numNodes == 0 ? 0. : static_cast<double>(numLandNodes) / numNodes;
+    }
+
+    MapStatistics GetMapStatistics(const Map& map)
+    {
+        MapStatistics stats;
+
+        RTTR_FOREACH_PT(MapPoint, map.size)
+        {
+            if(map.textureMap.All(pt, IsWater))
+                stats.numWaterNodes++;
+            else
+                stats.numLandNodes++;
+        }
+
+        stats.numHarbors = static_cast<unsigned>(map.harbors.size());
+
+        const auto& hqs = map.hqPositions;
+        for(unsigned i = 0; i < hqs.size(); i++)
+        {
+            for(unsigned j = i + 1; j < hqs.size(); j++)
+            {
+                const unsigned distance = map.z.CalcDistance(hqs[i], hqs[j]);
+                stats.minHqDistance = (stats.minHqDistance == 0) ? distance : std::min(stats.minHqDistance, distance);
+                stats.maxHqDistance = std::max(stats.maxHqDistance, distance);
+            }
+        }
+
+        const auto isWalkable = [](const TerrainDesc& terrain) { return terrain.Is(ETerrain::Walkable); };
+        const auto walkable = [&map, &isWalkable](const MapPoint& pt) { return map.textureMap.Any(pt, isWalkable); };
+        // HQs in the same area share the result
+        NodeMapBase<unsigned> areaSizes;
+        areaSizes.Resize(map.size, 0u);
+        for(const MapPoint hq : hqs)
+        {
+            if(areaSizes[hq] == 0u)
+            {
+                const auto area = Collect(map.z, hq, walkable);
+                for(const MapPoint pt : area)
+                    areaSizes[pt] = static_cast<unsigned>(area.size());
+            }
+            stats.reachableNodes.push_back(areaSizes[hq]);
+        }
+
+        return stats;
+    }
+
+}} // namespace rttr::mapGenerator
@@ -0,0 +1,42 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "mapGenerator/Map.h"
+#include <vector>
+
+namespace rttr { namespace mapGenerator {
+
+    /**
+     * Metrics of a generated map used to judge its quality, e.g. for vetting a pool of maps.
+     */
+    struct MapStatistics
+    {
+        /// Number of nodes with at least one non-water texture around them
+        unsigned numLandNodes = 0;
+        /// Number of nodes fully surrounded by water
+        unsigned numWaterNodes = 0;
+        /// Number of harbor positions
+        unsigned numHarbors = 0;
+        /// Smallest and largest distance between the headquarters of two players (0 for less than 2 players)
+        unsigned minHqDistance = 0;
+        unsigned maxHqDistance = 0;
+        /// Number of walkable nodes connected to the headquarters of each player
+        std::vector<unsigned> reachableNodes;
+
+        /// Ratio of land nodes to all nodes of the map
+        double GetLandRatio() const;
+    };
+
+    /**
+     * Computes quality metrics for the specified (fully generated) map.
+     *
+     * @param map map to analyse
+     *
+     * @returns the statistics of the map.
+     */
+    MapStatistics GetMapStatistics(const Map& map);
+
+}} // namespace rttr::mapGenerator
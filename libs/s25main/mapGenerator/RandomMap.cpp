@@ -285,14 +285,27 @@ namespace rttr { namespace mapGenerator {
         return map;
     }
 
+    namespace {
+        void WriteRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings, RandomUtility& rnd)
+        {
+            WorldDescription worldDesc;
+            loadGameData(worldDesc);
+
+            Map map = GenerateRandomMap(rnd, worldDesc, settings);
+            libsiedler2::Write(filePath, map.CreateArchiv());
+        }
+    } // namespace
+
     void CreateRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings)
     {
         RandomUtility rnd;
-        WorldDescription worldDesc;
-        loadGameData(worldDesc);
+        WriteRandomMap(filePath, settings, rnd);
+    }
 
-        Map map = GenerateRandomMap(rnd, worldDesc, settings);
-        libsiedler2::Write(filePath, map.CreateArchiv());
+    void CreateRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings, uint64_t seed)
+    {
+        RandomUtility rnd(seed);
+        WriteRandomMap(filePath, settings, rnd);
     }
 
 }} // namespace rttr::mapGenerator
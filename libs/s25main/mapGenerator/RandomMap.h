@@ -43,5 +43,7 @@ namespace rttr { namespace mapGenerator {
 
     Map GenerateRandomMap(RandomUtility& rnd, const WorldDescription& worldDesc, const MapSettings& settings);
     void CreateRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings);
+    /// Create a random map from the given seed. The same seed and settings always produce the same map.
+    void CreateRandomMap(const boost::filesystem::path& filePath, const MapSettings& settings, uint64_t seed);
 
 }} // namespace rttr::mapGenerator
@@ -48,7 +48,7 @@ namespace rttr { namespace mapGenerator {
 
     void AddObjects(Map& map, RandomUtility& rnd, const MapSettings& settings)
     {
-        std::set<MapPoint, MapPointLess> excludedArea;
+        NodeSet excludedArea(map.size);
         NodeMapBase<unsigned> probabilities;
         probabilities.Resize(map.size, 0u);
 
@@ -64,8 +64,7 @@ namespace rttr { namespace mapGenerator {
         {
             if(harborOrHeadquarter(pt))
             {
-                auto suroundingArea = map.getTextures().GetPointsInRadiusWithCenter(pt, 5);
-                excludedArea.insert(suroundingArea.begin(), suroundingArea.end());
+                excludedArea.insert(map.getTextures().GetPointsInRadiusWithCenter(pt, 5));
             } else if(map.textureMap.Any(pt, IsSnowOrLava))
             {
                 excludedArea.insert(pt);
@@ -108,8 +108,8 @@ namespace rttr { namespace mapGenerator {
 
     void Texturizer::ApplyCoastTexturing(const std::vector<MapPoint>& coast, unsigned width)
     {
-        std::set<MapPoint, MapPointLess> visited;
-        std::copy(coast.begin(), coast.end(), std::inserter(visited, visited.begin()));
+        NodeSet visited(textures_.GetSize());
+        visited.insert(coast);
 
         // setup transition textures from water to land
         auto sand = textureMap_.Find(IsCoastTerrain);
@@ -156,8 +156,8 @@ namespace rttr { namespace mapGenerator {
 
     void Texturizer::ApplyMountainWaterTransitions(const std::vector<MapPoint>& transitions)
     {
-        std::set<MapPoint, MapPointLess> nodes;
-        nodes.insert(transitions.begin(), transitions.end());
+        NodeSet nodes(textures_.GetSize());
+        nodes.insert(transitions);
         const auto water = textureMap_.Find(IsWater);
         const auto boulder = textureMap_.Find(IsBuildableMountain);
         const auto swamp = textureMap_.Find(IsSwamp);
@@ -219,7 +219,7 @@ namespace rttr { namespace mapGenerator {
         }
     }
 
-    void ReplaceTextures(NodeMapBase<TexturePair>& textures, unsigned radius, std::set<MapPoint, MapPointLess>& nodes,
+    void ReplaceTextures(NodeMapBase<TexturePair>& textures, unsigned radius, NodeSet& nodes,
                          DescIdx<TerrainDesc> texture, const std::set<DescIdx<TerrainDesc>>& excluded)
     {
         if(radius == 0)
@@ -232,11 +232,12 @@ namespace rttr { namespace mapGenerator {
             return;
         }
 
-        std::set<MapPoint, MapPointLess> initialNodes(nodes);
+        // Only the initial nodes are extended, the added ones are appended to the end
+        const size_t numInitialNodes = nodes.size();
 
-        for(const MapPoint& pt : initialNodes)
+        for(size_t i = 0; i < numInitialNodes; ++i)
         {
-            auto points = textures.GetPointsInRadius(pt, radius);
+            auto points = textures.GetPointsInRadius(nodes.points()[i], radius);
 
             for(const MapPoint& p : points)
             {
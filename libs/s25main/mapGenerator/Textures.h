@@ -237,7 +237,7 @@ namespace rttr { namespace mapGenerator {
      * @param texture texture to apply to nodes' triangles
      * @param excluded set of texture which shouldn't get replaced
      */
-    void ReplaceTextures(NodeMapBase<TexturePair>& textures, unsigned radius, std::set<MapPoint, MapPointLess>& nodes,
+    void ReplaceTextures(NodeMapBase<TexturePair>& textures, unsigned radius, NodeSet& nodes,
                          DescIdx<TerrainDesc> texture, const std::set<DescIdx<TerrainDesc>>& excluded);
 
 }} // namespace rttr::mapGenerator
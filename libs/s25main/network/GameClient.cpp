@@ -31,6 +31,8 @@
 #include "network/ClientInterface.h"
 #include "network/GameMessages.h"
 #include "network/GameServer.h"
+#include "network/MapCache.h"
+#include "network/NetworkThread.h"
 #include "ogl/FontStyle.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "ogl/glFont.h"
@@ -51,6 +53,7 @@
 #include "s25util/strFuncs.h"
 #include "s25util/utf8.h"
 #include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <helpers/chronoIO.h>
 #include <memory>
 
@@ -63,7 +66,10 @@ void GameClient::ClientConfig::Clear()
     isHost = false;
 }
 
-GameClient::GameClient() : skiptogf(0), mainPlayer(0), state(ClientState::Stopped), ci(nullptr), replayMode(false) {}
+GameClient::GameClient()
+    : skiptogf(0), useNetworkThread(false), useSimulationThread(false), stopSimulation(false), mainPlayer(0),
+      state(ClientState::Stopped), ci(nullptr), replayMode(false)
+{}
 
 GameClient::~GameClient()
 {
@@ -103,6 +109,12 @@ bool GameClient::Connect(const std::string& server, const std::string& password,
             GAMESERVER.Stop();
         return false;
     }
+    if(useNetworkThread)
+    {
+        if(!networkThread)
+            networkThread = std::make_unique<NetworkThread>();
+        mainPlayer.attachToNetworkThread(*networkThread);
+    }
 
     state = ClientState::Connect;
     AdvanceState(ConnectState::Initiated);
@@ -141,37 +153,51 @@ void GameClient::Run()
     if(state == ClientState::Stopped)
         return;
 
-    SocketSet set;
+    // Messages and the game commands they contain must not be handled while the simulation thread runs a GF
+    const auto worldLock = LockWorld();
 
-    // erstmal auf Daten überprüfen
-    set.Clear();
-
-    // zum set hinzufügen
-    set.Add(mainPlayer.socket);
-    if(set.Select(0, 0) > 0)
+    if(mainPlayer.usesNetworkThread())
     {
-        // nachricht empfangen
+        // Messages are already received and decoded, socket errors are reported here too
         if(!mainPlayer.receiveMsgs())
         {
             LOG.write("Receiving Message from server failed\n");
             ServerLost();
         }
-    }
+    } else
+    {
+        SocketSet set;
 
-    // nun auf Fehler prüfen
-    set.Clear();
+        // erstmal auf Daten überprüfen
+        set.Clear();
 
-    // zum set hinzufügen
-    set.Add(mainPlayer.socket);
+        // zum set hinzufügen
+        set.Add(mainPlayer.socket);
+        if(set.Select(0, 0) > 0)
+        {
+            // nachricht empfangen
+            if(!mainPlayer.receiveMsgs())
+            {
+                LOG.write("Receiving Message from server failed\n");
+                ServerLost();
+            }
+        }
 
-    // auf fehler prüfen
-    if(set.Select(0, 2) > 0)
-    {
-        if(set.InSet(mainPlayer.socket))
+        // nun auf Fehler prüfen
+        set.Clear();
+
+        // zum set hinzufügen
+        set.Add(mainPlayer.socket);
+
+        // auf fehler prüfen
+        if(set.Select(0, 2) > 0)
         {
-            // Server ist weg
-            LOG.write("Error on socket to server\n");
-            ServerLost();
+            if(set.InSet(mainPlayer.socket))
+            {
+                // Server ist weg
+                LOG.write("Error on socket to server\n");
+                ServerLost();
+            }
         }
     }
 
@@ -181,7 +207,18 @@ void GameClient::Run()
         if(nwfInfo->isReady())
             OnGameStart();
     } else if(state == ClientState::Game)
-        ExecuteGameFrame();
+    {
+        if(!simulationThread.joinable())
+            ExecuteGameFrame();
+        else if(simulationError)
+        {
+            // Stopping the game joins the simulation thread, so it cannot do that itself
+            const std::string error = *simulationError;
+            simulationError.reset();
+            OnLuaError(error);
+        } else if(!framesinfo.isPaused && !framesinfo.forcePauseLen.count())
+            framesinfo.frameTime = framesinfo.GetFrameTimeAt(FramesInfo::UsedClock::now());
+    }
 
     // maximal 10 Pakete verschicken
     mainPlayer.sendMsgs(10);
@@ -197,6 +234,8 @@ void GameClient::Stop()
     if(state == ClientState::Stopped)
         return;
 
+    StopSimulationThread();
+
     if(game)
         ExitGame();
     else if(state == ClientState::Connect || state == ClientState::Config)
@@ -218,6 +257,7 @@ void GameClient::Stop()
     }
 
     mainPlayer.closeConnection();
+    networkThread.reset();
 
     // clear jump target
     skiptogf = 0;
@@ -269,8 +309,10 @@ void GameClient::StartGame(const unsigned random_init)
 
     // Random-Generator initialisieren
     RANDOM.Init(random_init);
+    gcProfiler.Clear();
 
-    if(!IsReplayModeOn() && mapinfo.savegame && !mapinfo.savegame->Load(mapinfo.filepath, SaveGameDataToLoad::All))
+    // Header and settings of the savegame were already loaded with the map info
+    if(!IsReplayModeOn() && mapinfo.savegame && !mapinfo.savegame->LoadGameData())
     {
         OnError(ClientError::InvalidMap);
         return;
@@ -366,12 +408,26 @@ void GameClient::GameLoaded()
 void GameClient::ExitGame()
 {
     RTTR_Assert(state == ClientState::Game || state == ClientState::Loaded || state == ClientState::Loading);
+    StopSimulationThread();
+    if(SETTINGS.global.debugMode && gcProfiler.GetTotal().count > 0)
+        SaveGCProfile();
     game.reset();
     nwfInfo.reset();
     // Clear remaining commands
     gameCommands_.clear();
 }
 
+void GameClient::SaveGCProfile() const
+{
+    const bfs::path filePath = RTTRCONFIG.ExpandPath(s25::folders::logs)
+                               / (s25util::Time::FormatTime("gcProfile_%Y-%m-%d_%H-%i-%s") + ".csv");
+    bnw::ofstream file(filePath);
+    if(!file)
+        return;
+    gcProfiler.WriteCSV(file);
+    LOG.write(_("GameCommand profile saved at %1%\n")) % filePath;
+}
+
 unsigned GameClient::GetGFNumber() const
 {
     return game->em_->GetCurrentGF();
@@ -903,29 +959,13 @@ bool GameClient::OnGameMessage(const GameMessage_Map_Info& msg)
     else
         mapinfo.luaFilepath.clear();
 
-    // We have the map locally already, so prepare and ask if this is the same as the one on the server
-    if(bfs::exists(mapinfo.filepath) && (mapinfo.luaFilepath.empty() || bfs::exists(mapinfo.luaFilepath))
-       && CreateLobby())
+    // We have the map locally already (with the same name or in the cache of received maps),
+    // so prepare and ask if this is the same as the one on the server
+    if(UseLocalMap(msg) || (RestoreMapFromCache(msg) && UseLocalMap(msg)))
     {
-        mapinfo.mapData.CompressFromFile(mapinfo.filepath, &mapinfo.mapChecksum);
-        if(mapinfo.mapData.data.size() == msg.mapCompressedLen && mapinfo.mapData.uncompressedLength == msg.mapLen)
-        {
-            bool ok = true;
-            if(!mapinfo.luaFilepath.empty())
-            {
-                mapinfo.luaData.CompressFromFile(mapinfo.luaFilepath, &mapinfo.luaChecksum);
-                ok = (mapinfo.luaData.data.size() == msg.luaCompressedLen
-                      && mapinfo.luaData.uncompressedLength == msg.luaLen);
-            }
-
-            if(ok)
-            {
-                mainPlayer.sendMsgAsync(new GameMessage_Map_Checksum(mapinfo.mapChecksum, mapinfo.luaChecksum));
-                AdvanceState(ConnectState::VerifyMap);
-                return true;
-            }
-        }
-        gameLobby.reset();
+        mainPlayer.sendMsgAsync(new GameMessage_Map_Checksum(mapinfo.mapChecksum, mapinfo.luaChecksum));
+        AdvanceState(ConnectState::VerifyMap);
+        return true;
     }
     mapinfo.mapData.uncompressedLength = msg.mapLen;
     mapinfo.luaData.uncompressedLength = msg.luaLen;
@@ -936,6 +976,34 @@ bool GameClient::OnGameMessage(const GameMessage_Map_Info& msg)
     return true;
 }
 
+bool GameClient::UseLocalMap(const GameMessage_Map_Info& msg)
+{
+    if(!bfs::exists(mapinfo.filepath) || (!mapinfo.luaFilepath.empty() && !bfs::exists(mapinfo.luaFilepath))
+       || !CreateLobby())
+        return false;
+    mapinfo.mapData.CompressFromFile(mapinfo.filepath, &mapinfo.mapChecksum);
+    bool ok = mapinfo.mapData.data.size() == msg.mapCompressedLen && mapinfo.mapData.uncompressedLength == msg.mapLen
+              && mapinfo.mapChecksum == msg.mapChecksum;
+    if(ok && !mapinfo.luaFilepath.empty())
+    {
+        mapinfo.luaData.CompressFromFile(mapinfo.luaFilepath, &mapinfo.luaChecksum);
+        ok = mapinfo.luaData.data.size() == msg.luaCompressedLen && mapinfo.luaData.uncompressedLength == msg.luaLen
+             && mapinfo.luaChecksum == msg.luaChecksum;
+    }
+    if(!ok)
+        gameLobby.reset();
+    return ok;
+}
+
+bool GameClient::RestoreMapFromCache(const GameMessage_Map_Info& msg)
+{
+    const MapCache cache(RTTRCONFIG.ExpandPath(s25::folders::cache) / "maps");
+    if(!cache.restore(MapCache::Key{msg.mapLen, msg.mapCompressedLen, msg.mapChecksum}, mapinfo.filepath))
+        return false;
+    return mapinfo.luaFilepath.empty()
+           || cache.restore(MapCache::Key{msg.luaLen, msg.luaCompressedLen, msg.luaChecksum}, mapinfo.luaFilepath);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Kartendaten
 /// @param message  Nachricht, welche ausgeführt wird
@@ -944,17 +1012,17 @@ bool GameClient::OnGameMessage(const GameMessage_Map_Data& msg)
     if(!VerifyState(ConnectState::ReceiveMap))
         return true;
 
-    LOG.writeToFile("<<< NMS_MAP_DATA(%u)\n") % msg.data.size();
+    LOG.writeToFile("<<< NMS_MAP_DATA(%u)\n") % msg.length;
     std::vector<char>& targetData = (msg.isMapData) ? mapinfo.mapData.data : mapinfo.luaData.data;
-    if(msg.data.size() > targetData.size() || msg.offset > targetData.size() - msg.data.size())
+    if(msg.length > targetData.size() || msg.offset > targetData.size() - msg.length)
     {
         OnError(ClientError::MapTransmission);
         return true;
     }
-    std::copy(msg.data.begin(), msg.data.end(), targetData.begin() + msg.offset);
+    std::copy(msg.getData(), msg.getData() + msg.length, targetData.begin() + msg.offset);
 
     uint32_t totalSize = mapinfo.mapData.data.size();
-    uint32_t receivedSize = msg.offset + msg.data.size();
+    uint32_t receivedSize = msg.offset + msg.length;
     if(!mapinfo.luaFilepath.empty())
     {
         totalSize += mapinfo.luaData.data.size();
@@ -979,6 +1047,18 @@ bool GameClient::OnGameMessage(const GameMessage_Map_Data& msg)
         }
         RTTR_Assert(!mapinfo.luaFilepath.empty() || mapinfo.luaChecksum == 0);
 
+        // Keep the map so it does not need to be transferred again, even if the server uses a different name
+        MapCache cache(RTTRCONFIG.ExpandPath(s25::folders::cache) / "maps");
+        cache.add(MapCache::Key{mapinfo.mapData.uncompressedLength, static_cast<unsigned>(mapinfo.mapData.data.size()),
+                                mapinfo.mapChecksum},
+                  mapinfo.filepath);
+        if(!mapinfo.luaFilepath.empty())
+        {
+            cache.add(MapCache::Key{mapinfo.luaData.uncompressedLength,
+                                    static_cast<unsigned>(mapinfo.luaData.data.size()), mapinfo.luaChecksum},
+                      mapinfo.luaFilepath);
+        }
+
         if(!CreateLobby())
         {
             OnError(ClientError::MapTransmission);
@@ -1005,6 +1085,12 @@ void GameClient::OnError(ClientError error)
     Stop();
 }
 
+void GameClient::OnLuaError(const std::string& error)
+{
+    SystemChat((boost::format(_("Error during execution of lua script: %1\nGame stopped!")) % error).str());
+    OnError(ClientError::InvalidMap);
+}
+
 void GameClient::AdvanceState(ConnectState newState)
 {
     connectState = newState;
@@ -1269,84 +1355,31 @@ void GameClient::ExecuteGameFrame()
             return; // Pause
     }
 
-    const unsigned curGF = GetGFNumber();
-    const bool isSkipping = skiptogf > curGF;
-    // Is it time for the next GF? If we are skipping, it is always time for the next GF
-    if(isSkipping || (currentTime - framesinfo.lastTime) >= framesinfo.gf_length)
+    bool isLagging = false;
+    try
     {
-        try
-        {
-            if(isSkipping)
-            {
-                // We are always in realtime
-                framesinfo.lastTime = currentTime;
-            } else
-            {
-                // Advance simulation time (lastTime) by 1 GF
-                framesinfo.lastTime += framesinfo.gf_length;
-            }
-            if(replayMode)
-            {
-                // In replay mode we have all commands in the file -> Execute them
-                ExecuteGameFrame_Replay();
-            } else
-            {
-                RTTR_Assert(curGF <= nwfInfo->getNextNWF());
-                bool isNWF = (curGF == nwfInfo->getNextNWF());
-                // Is it time for a NWF, handle that first
-                if(isNWF)
-                {
-                    // If a player is lagging (we did not got his commands) "pause" the game by skipping the rest of
-                    // this function
-                    // -> Don't execute GF, don't autosave etc.
-                    if(!nwfInfo->isReady())
-                    {
-                        // If a player is a few GFs behind, he will never catch up and always lag
-                        // Hence, pause up to 4 GFs randomly before trying again to execute this NWF
-                        // Do not reset frameTime or lastTime as this will mess up interpolation for drawing
-                        framesinfo.forcePauseStart = currentTime;
-                        framesinfo.forcePauseLen = (rand() * 4 * framesinfo.gf_length) / RAND_MAX;
-                        return;
-                    }
-
-                    RTTR_Assert(nwfInfo->getServerInfo().gf == curGF);
-
-                    ExecuteNWF();
-
-                    FramesInfo::milliseconds32_t oldGFLen = framesinfo.gf_length;
-                    nwfInfo->execute(framesinfo);
-                    if(oldGFLen != framesinfo.gf_length)
-                    {
-                        LOG.write("Client: Speed changed at %1% from %2% to %3% (NWF: %4%)\n") % curGF
-                          % helpers::withUnit(oldGFLen) % helpers::withUnit(framesinfo.gf_length)
-                          % framesinfo.nwf_length;
-                    }
-                }
-
-                NextGF(isNWF);
-                RTTR_Assert(curGF <= nwfInfo->getNextNWF());
-                HandleAutosave();
-
-                // GF-Ende im Replay aktualisieren
-                if(replayinfo && replayinfo->replay.IsRecording())
-                    replayinfo->replay.UpdateLastGF(curGF);
-            }
-
-        } catch(LuaExecutionError& e)
-        {
-            SystemChat((boost::format(_("Error during execution of lua script: %1\nGame stopped!")) % e.what()).str());
-            OnError(ClientError::InvalidMap);
-        }
-        if(skiptogf == GetGFNumber())
-            skiptogf = 0;
+        isLagging = !framesinfo.RunDueGFs(
+          currentTime, [this]() { return skiptogf > GetGFNumber(); },
+          [this, currentTime](bool isSkipping) { return ExecuteNextGF(currentTime, isSkipping); });
+    } catch(LuaExecutionError& e)
+    {
+        // The simulation thread is assigned while the world is locked, so reading it here is safe
+        if(std::this_thread::get_id() == simulationThread.get_id())
+            simulationError = e.what();
+        else
+            OnLuaError(e.what());
     }
+    // Outside of the try block so this is also done when a GF failed. The game is gone if that stopped the client
+    if(game && skiptogf == GetGFNumber())
+        skiptogf = 0;
+    if(isLagging)
+        return;
     framesinfo.frameTime = std::chrono::duration_cast<FramesInfo::milliseconds32_t>(currentTime - framesinfo.lastTime);
     // Check remaining time until next GF
     if(framesinfo.frameTime >= framesinfo.gf_length)
     {
-        // This can happen, if we don't call this method in intervalls less than gf_length or gf_length has changed
-        // TODO: Run multiple GFs per call.
-        // For now just make sure it is less than gf_length by skipping some simulation time,
+        // This can happen, if the GFs took too long to run them all in the last call or gf_length has changed
+        // Make sure it is less than gf_length by skipping some simulation time,
         // until we are only a bit less than 1 GF behind
         // However we allow the simulation to lack behind for a few frames, so if there was a single spike we can still
         // catch up in the next visual frames
@@ -1364,6 +1397,109 @@ void GameClient::ExecuteGameFrame()
     RTTR_Assert(framesinfo.frameTime < framesinfo.gf_length);
 }
 
+void GameClient::RunSimulation()
+{
+    // Wake up regularly even if no GF is due to notice e.g. unpausing or stopping
+    constexpr std::chrono::milliseconds maxWait(10);
+    while(!stopSimulation)
+    {
+        FramesInfo::UsedClock::time_point nextGFTime;
+        {
+            std::unique_lock<std::recursive_timed_mutex> worldLock(worldMutex, std::defer_lock);
+            // Don't block forever as the main thread may hold the lock while waiting for us to stop
+            if(!worldLock.try_lock_for(std::chrono::milliseconds(1)))
+                continue;
+            ExecuteGameFrame();
+            if(simulationError)
+                break;
+            // Run the next GF right away when jumping, releasing the lock in between
+            if(skiptogf > GetGFNumber())
+                continue;
+            nextGFTime = framesinfo.GetNextGFTime(FramesInfo::UsedClock::now(), maxWait);
+        }
+        std::this_thread::sleep_until(nextGFTime);
+    }
+}
+
+void GameClient::StartSimulationThread()
+{
+    RTTR_Assert(!simulationThread.joinable());
+    // Hold the lock until the thread object is set, as it is used by the thread when running the GFs
+    const auto worldLock = LockWorld();
+    stopSimulation = false;
+    simulationError.reset();
+    simulationThread = std::thread(&GameClient::RunSimulation, this);
+}
+
+void GameClient::StopSimulationThread()
+{
+    if(!simulationThread.joinable())
+        return;
+    stopSimulation = true;
+    simulationThread.join();
+}
+
+bool GameClient::ExecuteNextGF(FramesInfo::UsedClock::time_point currentTime, bool isSkipping)
+{
+    const unsigned curGF = GetGFNumber();
+    if(isSkipping)
+    {
+        // We are always in realtime
+        framesinfo.lastTime = currentTime;
+    } else
+    {
+        // Advance simulation time (lastTime) by 1 GF
+        framesinfo.lastTime += framesinfo.gf_length;
+    }
+    if(replayMode)
+    {
+        // In replay mode we have all commands in the file -> Execute them
+        ExecuteGameFrame_Replay();
+    } else
+    {
+        RTTR_Assert(curGF <= nwfInfo->getNextNWF());
+        bool isNWF = (curGF == nwfInfo->getNextNWF());
+        // Is it time for a NWF, handle that first
+        if(isNWF)
+        {
+            // If a player is lagging (we did not got his commands) "pause" the game by skipping the rest of
+            // this function
+            // -> Don't execute GF, don't autosave etc.
+            if(!nwfInfo->isReady())
+            {
+                // If a player is a few GFs behind, he will never catch up and always lag
+                // Hence, pause up to 4 GFs randomly before trying again to execute this NWF
+                // Do not reset frameTime or lastTime as this will mess up interpolation for drawing
+                framesinfo.forcePauseStart = currentTime;
+                framesinfo.forcePauseLen = (rand() * 4 * framesinfo.gf_length) / RAND_MAX;
+                return false;
+            }
+
+            RTTR_Assert(nwfInfo->getServerInfo().gf == curGF);
+
+            ExecuteNWF();
+
+            FramesInfo::milliseconds32_t oldGFLen = framesinfo.gf_length;
+            nwfInfo->execute(framesinfo);
+            if(oldGFLen != framesinfo.gf_length)
+            {
+                LOG.write("Client: Speed changed at %1% from %2% to %3% (NWF: %4%)\n") % curGF
+                  % helpers::withUnit(oldGFLen) % helpers::withUnit(framesinfo.gf_length)
+                  % framesinfo.nwf_length;
+            }
+        }
+
+        NextGF(isNWF);
+        RTTR_Assert(curGF <= nwfInfo->getNextNWF());
+        HandleAutosave();
+
+        // GF-Ende im Replay aktualisieren
+        if(replayinfo && replayinfo->replay.IsRecording())
+            replayinfo->replay.UpdateLastGF(curGF);
+    }
+    return true;
+}
+
 void GameClient::HandleAutosave()
 {
     // If inactive or during replay -> no autosave
@@ -1394,7 +1530,7 @@ void GameClient::NextGF(bool wasNWF)
 void GameClient::ExecuteAllGCs(uint8_t playerId, const PlayerGameCommands& gcs)
 {
     for(const gc::GameCommandPtr& gc : gcs.gcs)
-        gc->Execute(game->world_, playerId);
+        gcProfiler.Execute(*gc, game->world_, playerId);
 }
 
 void GameClient::SendNothingNC(uint8_t player)
@@ -1418,6 +1554,8 @@ void GameClient::OnGameStart()
         GAMEMANAGER.ResetAverageGFPS();
         framesinfo.lastTime = FramesInfo::UsedClock::now();
         state = ClientState::Game;
+        if(useSimulationThread)
+            StartSimulationThread();
         if(ci)
             ci->CI_GameStarted();
     } else if(state == ClientState::Game && !game->IsStarted())
@@ -7,6 +7,7 @@
 #include "ClientError.h"
 #include "FramesInfo.h"
 #include "GameCommand.h"
+#include "GameCommandProfiler.h"
 #include "GameMessageInterface.h"
 #include "ILocalGameState.h"
 #include "NetworkPlayer.h"
@@ -19,7 +20,11 @@
 #include "gameTypes/TeamTypes.h"
 #include "gameTypes/VisualSettings.h"
 #include "s25util/Singleton.h"
+#include <boost/optional.hpp>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace AI {
@@ -83,6 +88,17 @@ public:
     bool HostGame(const CreateServerInfo& csi, const boost::filesystem::path& map_path, MapType map_type);
     void Run();
     void Stop();
+    /// Do the socket I/O in a separate thread, independent of how often Run is called. Takes effect on the next connect
+    void SetUseNetworkThread(bool useNetworkThread) { this->useNetworkThread = useNetworkThread; }
+    /// Run the GFs (including AIs and NWFs) in a separate thread, independent of the frame rate.
+    /// Takes effect on the next game start
+    void SetUseSimulationThread(bool useSimulationThread) { this->useSimulationThread = useSimulationThread; }
+    /// Keep the simulation thread from running GFs while the lock is held, so the game state is that of a single GF.
+    /// Required for everything accessing the game while the simulation thread may run. Can be nested.
+    std::unique_lock<std::recursive_timed_mutex> LockWorld()
+    {
+        return std::unique_lock<std::recursive_timed_mutex>(worldMutex);
+    }
 
     /// Gibt Map-Titel zurück
     const std::string& GetMapTitle() const { return mapinfo.title; }
@@ -103,6 +119,8 @@ public:
     ClientState GetState() const { return state; }
     Replay* GetReplay();
     std::shared_ptr<const NWFInfo> GetNWFInfo() const;
+    /// Cost of the GameCommands executed in the current game
+    const GameCommandProfiler& GetGCProfiler() const { return gcProfiler; }
     std::shared_ptr<GameLobby> GetGameLobby();
     const AIPlayer* GetAIPlayer(unsigned id) const;
 
@@ -187,8 +205,14 @@ private:
     /// Liefert einen Player zurück
     GamePlayer& GetPlayer(unsigned id);
 
-    /// Versucht einen neuen GameFrame auszuführen, falls die Zeit dafür gekommen ist
+    /// Run all GFs that are due, catching up (limited) if the simulation fell behind
     void ExecuteGameFrame();
+    /// Main loop of the simulation thread: Run the due GFs and wait for the next one
+    void RunSimulation();
+    void StartSimulationThread();
+    void StopSimulationThread();
+    /// Execute the next GF (including the NWF if required). Return false if it could not be run due to a lagging player
+    bool ExecuteNextGF(FramesInfo::UsedClock::time_point currentTime, bool isSkipping);
     void ExecuteGameFrame_Replay();
     void ExecuteNWF();
     /// Filtert aus einem Network-Command-Paket alle Commands aus und führt sie aus, falls ein Spielerwechsel-Command
@@ -196,6 +220,8 @@ private:
     void ExecuteAllGCs(uint8_t playerId, const PlayerGameCommands& gcs);
     /// Sendet ein NC-Paket ohne Befehle
     void SendNothingNC(uint8_t player = 0xFF);
+    /// Write the GameCommand profile of the current game to the log folder
+    void SaveGCProfile() const;
 
     /// Führt notwendige Dinge für nächsten GF aus
     void NextGF(bool wasNWF);
@@ -245,6 +271,8 @@ private:
 
     /// Report the error and stop
     void OnError(ClientError error);
+    /// Report an error of the lua script and stop
+    void OnLuaError(const std::string& error);
     /// Advance to new connect state
     void AdvanceState(ConnectState newState);
     /// Verifies that the current connect state matches the expected one
@@ -252,6 +280,10 @@ private:
     bool VerifyState(ConnectState expectedState);
 
     bool CreateLobby();
+    /// Check if the map (and lua script) from the map info exist locally and prepare the lobby if they do
+    bool UseLocalMap(const GameMessage_Map_Info& msg);
+    /// Copy the map (and lua script) from the cache of received maps to their paths in the map info
+    bool RestoreMapFromCache(const GameMessage_Map_Info& msg);
 
     /// Wird aufgerufen, wenn der Server gegangen ist (Verbindung verloren, ungültige Nachricht etc.)
     void ServerLost();
@@ -271,6 +303,17 @@ public:
     unsigned skiptogf;
 
 private:
+    bool useNetworkThread;
+    /// Thread doing the socket I/O for the connection to the server, if enabled
+    std::unique_ptr<NetworkThread> networkThread;
+    bool useSimulationThread;
+    /// Thread running the GFs, if enabled. Only active in the GAME state
+    std::thread simulationThread;
+    std::atomic<bool> stopSimulation;
+    /// Held by the simulation thread while running GFs and by the main thread while accessing the game
+    std::recursive_timed_mutex worldMutex;
+    /// Lua error during a GF in the simulation thread. Reported by the main thread as that one can stop the game
+    boost::optional<std::string> simulationError;
     NetworkPlayer mainPlayer;
 
     ClientState state;
@@ -305,6 +348,8 @@ private:
 
     /// GameCommands, die vom Client noch an den Server gesendet werden müssen
     std::vector<gc::GameCommandPtr> gameCommands_;
+    /// Executes the GameCommands of all players and tracks their cost
+    GameCommandProfiler gcProfiler;
 
     std::unique_ptr<ReplayInfo> replayinfo;
     bool replayMode;
@@ -9,6 +9,7 @@
 #include "GameMessage_Chat.h"
 #include "GameProtocol.h"
 #include "GlobalGameSettings.h"
+#include "RTTR_Assert.h"
 #include "helpers/serializeEnums.h"
 #include "random/Random.h"
 #include "gameTypes/AIInfo.h"
@@ -19,7 +20,9 @@
 #include "gameTypes/TeamTypes.h"
 #include "s25util/Log.h"
 #include "s25util/Serializer.h"
+#include <memory>
 #include <utility>
+#include <vector>
 
 struct JoinPlayerInfo;
 class MessageInterface;
@@ -674,12 +677,15 @@ public:
     MapType mt;
     uint32_t mapLen, mapCompressedLen;
     uint32_t luaLen, luaCompressedLen;
+    /// Checksums of the (uncompressed) data, used to find the map in the local cache
+    uint32_t mapChecksum, luaChecksum;
 
     GameMessage_Map_Info() : GameMessage(NMS_MAP_INFO) {} //-V730
     GameMessage_Map_Info(std::string filename, const MapType mt, unsigned mapLen, unsigned mapCompressedLen,
-                         const unsigned luaLen, unsigned luaCompressedLen)
+                         const unsigned luaLen, unsigned luaCompressedLen, unsigned mapChecksum, unsigned luaChecksum)
         : GameMessage(NMS_MAP_INFO), filename(std::move(filename)), mt(mt), mapLen(mapLen),
-          mapCompressedLen(mapCompressedLen), luaLen(luaLen), luaCompressedLen(luaCompressedLen)
+          mapCompressedLen(mapCompressedLen), luaLen(luaLen), luaCompressedLen(luaCompressedLen),
+          mapChecksum(mapChecksum), luaChecksum(luaChecksum)
     {
         LOG.writeToFile(">>> NMS_MAP_INFO\n");
     }
@@ -693,6 +699,8 @@ public:
         ser.PushUnsignedInt(mapCompressedLen);
         ser.PushUnsignedInt(luaLen);
         ser.PushUnsignedInt(luaCompressedLen);
+        ser.PushUnsignedInt(mapChecksum);
+        ser.PushUnsignedInt(luaChecksum);
     }
 
     void Deserialize(Serializer& ser) override
@@ -704,6 +712,8 @@ public:
         mapCompressedLen = ser.PopUnsignedInt();
         luaLen = ser.PopUnsignedInt();
         luaCompressedLen = ser.PopUnsignedInt();
+        mapChecksum = ser.PopUnsignedInt();
+        luaChecksum = ser.PopUnsignedInt();
     }
 
     bool Run(GameMessageInterface* callback) const override
@@ -738,28 +748,45 @@ public:
 
 class GameMessage_Map_Data : public GameMessage
 {
+    /// Buffer containing the data. Shared by all chunks sent from the same map to avoid copying them
+    std::shared_ptr<const std::vector<char>> buffer_;
+    /// Start of the data in the buffer
+    uint32_t bufferOffset_;
+
 public:
+    /// True for map data, false for luaData
     bool isMapData;
     /// Offset into map buffer
     uint32_t offset;
-    /// Kartendaten
-    std::vector<char> data;
-    /// True for map data, false for luaData
+    /// Size of the data
+    uint32_t length;
 
     GameMessage_Map_Data() : GameMessage(NMS_MAP_DATA) {} //-V730
     GameMessage_Map_Data(bool isMapData, const uint32_t offset, const char* const data, unsigned length)
-        : GameMessage(NMS_MAP_DATA), isMapData(isMapData), offset(offset), data(data, data + length)
+        : GameMessage(NMS_MAP_DATA), buffer_(std::make_shared<const std::vector<char>>(data, data + length)),
+          bufferOffset_(0), isMapData(isMapData), offset(offset), length(length)
+    {
+        LOG.writeToFile(">>> NMS_MAP_DATA\n");
+    }
+    /// Send the chunk [offset, offset + length) of the buffer without copying it
+    GameMessage_Map_Data(bool isMapData, std::shared_ptr<const std::vector<char>> buffer, const uint32_t offset,
+                         unsigned length)
+        : GameMessage(NMS_MAP_DATA), buffer_(std::move(buffer)), bufferOffset_(offset), isMapData(isMapData),
+          offset(offset), length(length)
     {
+        RTTR_Assert(bufferOffset_ + length <= buffer_->size());
         LOG.writeToFile(">>> NMS_MAP_DATA\n");
     }
 
+    const char* getData() const { return buffer_->data() + bufferOffset_; }
+
     void Serialize(Serializer& ser) const override
     {
         GameMessage::Serialize(ser);
         ser.PushBool(isMapData);
         ser.PushUnsignedInt(offset);
-        ser.PushUnsignedInt(data.size());
-        ser.PushRawData(&data.front(), data.size());
+        ser.PushUnsignedInt(length);
+        ser.PushRawData(getData(), length);
     }
 
     void Deserialize(Serializer& ser) override
@@ -767,8 +794,11 @@ public:
         GameMessage::Deserialize(ser);
         isMapData = ser.PopBool();
         offset = ser.PopUnsignedInt();
-        data.resize(ser.PopUnsignedInt());
-        ser.PopRawData(&data.front(), data.size());
+        length = ser.PopUnsignedInt();
+        auto data = std::make_shared<std::vector<char>>(length);
+        ser.PopRawData(data->data(), length);
+        buffer_ = std::move(data);
+        bufferOffset_ = 0;
     }
 
     bool Run(GameMessageInterface* callback) const override
@@ -19,6 +19,8 @@
 #include "helpers/random.h"
 #include "network/CreateServerInfo.h"
 #include "network/GameMessages.h"
+#include "network/NetworkThread.h"
+#include "network/SerializedGameMessage.h"
 #include "random/randomIO.h"
 #include "gameTypes/LanGameInfo.h"
 #include "gameTypes/TeamTypes.h"
@@ -41,6 +43,7 @@
 #include <iomanip>
 #include <iterator>
 #include <mygettext/mygettext.h>
+#include <set>
 
 struct GameServer::AsyncLog
 {
@@ -101,7 +104,9 @@ bool GameServer::CountDown::Update()
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-GameServer::GameServer() : skiptogf(0), state(ServerState::Stopped), currentGF(0), lanAnnouncer(LAN_DISCOVERY_CFG) {}
+GameServer::GameServer()
+    : skiptogf(0), state(ServerState::Stopped), currentGF(0), useNetworkThread(false), lanAnnouncer(LAN_DISCOVERY_CFG)
+{}
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -199,6 +204,8 @@ bool GameServer::Start(const CreateServerInfo& csi, const boost::filesystem::pat
         LOG.write("Map %1% is to large!\n") % mapinfo.filepath;
         return false;
     }
+    sharedMapData = std::make_shared<const std::vector<char>>(std::move(mapinfo.mapData.data));
+    sharedLuaData = std::make_shared<const std::vector<char>>(std::move(mapinfo.luaData.data));
 
     // ab in die Konfiguration
     state = ServerState::Config;
@@ -210,6 +217,8 @@ bool GameServer::Start(const CreateServerInfo& csi, const boost::filesystem::pat
         LOG.writeLastError("Fehler");
         return false;
     }
+    if(useNetworkThread)
+        networkThread = std::make_unique<NetworkThread>();
 
     if(config.servertype == ServerType::LAN)
         lanAnnouncer.Start();
@@ -397,11 +406,14 @@ void GameServer::Stop()
     // player verabschieden
     playerInfos.clear();
     networkPlayers.clear();
+    networkThread.reset();
 
     // aufräumen
     framesinfo.Clear();
     config.Clear();
     mapinfo.Clear();
+    sharedMapData.reset();
+    sharedLuaData.reset();
     countdown.Stop();
 
     // laden dicht machen
@@ -607,11 +619,13 @@ void GameServer::SendNWFDone(const NWFServerInfo& info)
  */
 void GameServer::SendToAll(const GameMessage& msg)
 {
+    // Serialize only once, all players share the data (e.g. relayed game commands)
+    const SerializedGameMessage serializedMsg(msg);
     for(GameServerPlayer& player : networkPlayers)
     {
         // ist der Slot Belegt, dann Nachricht senden
         if(player.isActive())
-            player.sendMsgAsync(msg.clone());
+            player.sendMsgAsync(serializedMsg.copy());
     }
 }
 
@@ -650,9 +664,12 @@ void GameServer::ClientWatchDog()
     SocketSet set;
     set.Clear();
 
-    // sockets zum set hinzufügen
+    // sockets zum set hinzufügen. Errors on sockets handled by the network thread are reported on receive
     for(GameServerPlayer& player : networkPlayers)
-        set.Add(player.socket);
+    {
+        if(!player.usesNetworkThread())
+            set.Add(player.socket);
+    }
 
     // auf fehler prüfen
     if(set.Select(0, 2) > 0)
@@ -849,6 +866,8 @@ void GameServer::WaitForClients()
         // war kein platz mehr frei, wenn ja dann verbindung trennen?
         if(newPlayerId == 0xFFFFFFFF)
             socket.Close();
+        else if(networkThread)
+            GetNetworkPlayer(newPlayerId)->attachToNetworkThread(*networkThread);
     }
 }
 
@@ -856,6 +875,16 @@ void GameServer::WaitForClients()
 // füllt die warteschlangen mit "paketen"
 void GameServer::FillPlayerQueues()
 {
+    // Messages of players handled by the network thread are already decoded and only need to be fetched
+    for(GameServerPlayer& player : networkPlayers)
+    {
+        if(player.usesNetworkThread() && !player.receiveMsgs())
+        {
+            LOG.write(_("SERVER: Receiving Message for player %1% failed, kicking...\n")) % player.playerId;
+            KickPlayer(player.playerId, KickReason::ConnectionLost, __LINE__);
+        }
+    }
+
     SocketSet set;
     bool msgReceived = false;
 
@@ -864,7 +893,10 @@ void GameServer::FillPlayerQueues()
     {
         // sockets zum set hinzufügen
         for(const GameServerPlayer& player : networkPlayers)
-            set.Add(player.socket);
+        {
+            if(!player.usesNetworkThread())
+                set.Add(player.socket);
+        }
 
         msgReceived = false;
 
@@ -873,7 +905,7 @@ void GameServer::FillPlayerQueues()
         {
             for(GameServerPlayer& player : networkPlayers)
             {
-                if(set.InSet(player.socket))
+                if(!player.usesNetworkThread() && set.InSet(player.socket))
                 {
                     // nachricht empfangen
                     if(!player.receiveMsgs())
@@ -1155,41 +1187,30 @@ bool GameServer::OnGameMessage(const GameMessage_MapRequest& msg)
     if(msg.requestInfo)
     {
         player->sendMsgAsync(new GameMessage_Map_Info(mapinfo.filepath.filename().string(), mapinfo.type,
-                                                      mapinfo.mapData.uncompressedLength, mapinfo.mapData.data.size(),
-                                                      mapinfo.luaData.uncompressedLength, mapinfo.luaData.data.size()));
+                                                      mapinfo.mapData.uncompressedLength, sharedMapData->size(),
+                                                      mapinfo.luaData.uncompressedLength, sharedLuaData->size(),
+                                                      mapinfo.mapChecksum, mapinfo.luaChecksum));
     } else if(player->isMapSending())
     {
         // Don't send again
         KickPlayer(msg.senderPlayerID, KickReason::InvalidMsg, __LINE__);
     } else
     {
-        // Send map data
-        unsigned curPos = 0;
-        unsigned remainingSize = mapinfo.mapData.data.size();
-        while(remainingSize)
-        {
-            unsigned chunkSize = std::min(MAP_PART_SIZE, remainingSize);
-
-            player->sendMsgAsync(new GameMessage_Map_Data(true, curPos, &mapinfo.mapData.data[curPos], chunkSize));
-            curPos += chunkSize;
-            remainingSize -= chunkSize;
-        }
-
-        // And lua data (if there is any)
-        RTTR_Assert(mapinfo.luaFilepath.empty() == mapinfo.luaData.data.empty());
-        RTTR_Assert(mapinfo.luaData.data.empty() == (mapinfo.luaData.uncompressedLength == 0));
-        curPos = 0;
-        remainingSize = mapinfo.luaData.data.size();
-        while(remainingSize)
-        {
-            unsigned chunkSize = std::min(MAP_PART_SIZE, remainingSize);
-
-            player->sendMsgAsync(new GameMessage_Map_Data(false, curPos, &mapinfo.luaData.data[curPos], chunkSize));
-            curPos += chunkSize;
-            remainingSize -= chunkSize;
-        }
+        // Send map data and lua data (if there is any) as views into the shared buffers
+        RTTR_Assert(mapinfo.luaFilepath.empty() == sharedLuaData->empty());
+        RTTR_Assert(sharedLuaData->empty() == (mapinfo.luaData.uncompressedLength == 0));
+        const auto sendChunks = [player](bool isMapData, const std::shared_ptr<const std::vector<char>>& data) {
+            const auto size = static_cast<unsigned>(data->size());
+            for(unsigned curPos = 0; curPos < size; curPos += MAP_PART_SIZE)
+            {
+                const unsigned chunkSize = std::min(MAP_PART_SIZE, size - curPos);
+                player->sendMsgAsync(new GameMessage_Map_Data(isMapData, data, curPos, chunkSize));
+            }
+        };
+        sendChunks(true, sharedMapData);
+        sendChunks(false, sharedLuaData);
         // estimate time. max 60 chunks/s (currently limited by framerate), assume 50 (~25kb/s)
-        auto numChunks = (mapinfo.mapData.data.size() + mapinfo.luaData.data.size()) / MAP_PART_SIZE;
+        auto numChunks = (sharedMapData->size() + sharedLuaData->size()) / MAP_PART_SIZE;
         player->setMapSending(std::chrono::seconds(numChunks / 50 + 1));
     }
     return true;
@@ -1354,6 +1375,7 @@ bool GameServer::OnGameMessage(const GameMessage_RemoveLua& msg)
     mapinfo.luaFilepath.clear();
     mapinfo.luaData.Clear();
     mapinfo.luaChecksum = 0;
+    sharedLuaData = std::make_shared<const std::vector<char>>();
     SendToAll(msg);
     CancelCountdown();
     return true;
@@ -16,6 +16,7 @@
 #include "s25util/LANDiscoveryService.h"
 #include "s25util/Singleton.h"
 #include <chrono>
+#include <memory>
 #include <vector>
 
 struct CreateServerInfo;
@@ -23,6 +24,7 @@ class GameMessage;
 class GameMessageWithPlayer;
 class GameMessage_GameCommand;
 class GameServerPlayer;
+class NetworkThread;
 struct AIServerPlayer;
 
 class GameServer :
@@ -49,6 +51,10 @@ public:
 
     void Stop();
 
+    /// Do the socket I/O of the players in a separate thread, independent of how often Run is called.
+    /// Takes effect on the next start
+    void SetUseNetworkThread(bool useNetworkThread) { this->useNetworkThread = useNetworkThread; }
+
     /// Assign players that do not have a fixed team, return true if any player was assigned.
     static bool assignPlayersOfRandomTeams(std::vector<JoinPlayerInfo>& playerInfos);
 
@@ -158,10 +164,16 @@ private:
     } config;
 
     MapInfo mapinfo;
+    /// Compressed map and lua data sent to the clients, shared by all messages to avoid copying it for each chunk.
+    /// The data is moved out of mapinfo, so only the sizes and checksums there are valid
+    std::shared_ptr<const std::vector<char>> sharedMapData, sharedLuaData;
 
     Socket serversocket;
     std::vector<JoinPlayerInfo> playerInfos;
     std::vector<GameServerPlayer> networkPlayers;
+    bool useNetworkThread;
+    /// Thread doing the socket I/O for all players, if enabled
+    std::unique_ptr<NetworkThread> networkThread;
     NWFInfo nwfInfo;
     GlobalGameSettings ggs_;
 
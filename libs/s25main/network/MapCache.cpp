@@ -0,0 +1,84 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "MapCache.h"
+#include "s25util/Log.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <ctime>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace bfs = boost::filesystem;
+
+namespace {
+void copyFile(const bfs::path& from, const bfs::path& to, boost::system::error_code& ec)
+{
+    constexpr auto overwrite_existing =
+#if BOOST_VERSION >= 107400
+      bfs::copy_options::overwrite_existing;
+#else
+      bfs::copy_option::overwrite_if_exists;
+#endif
+    bfs::copy_file(from, to, overwrite_existing, ec);
+}
+} // namespace
+
+MapCache::MapCache(bfs::path cacheDir) : cacheDir_(std::move(cacheDir)) {}
+
+bfs::path MapCache::getPath(const Key& key) const
+{
+    std::ostringstream name;
+    name << std::hex << key.checksum << '_' << key.length << '_' << key.compressedLength << ".dat";
+    return cacheDir_ / name.str();
+}
+
+bool MapCache::restore(const Key& key, const bfs::path& targetPath) const
+{
+    const bfs::path cachedPath = getPath(key);
+    boost::system::error_code ec;
+    if(!bfs::exists(cachedPath, ec) || bfs::file_size(cachedPath, ec) != key.length || ec)
+        return false;
+    copyFile(cachedPath, targetPath, ec);
+    if(ec)
+    {
+        LOG.write("Failed to copy cached map %1% to %2%: %3%\n") % cachedPath % targetPath % ec.message();
+        return false;
+    }
+    // Mark as recently used
+    bfs::last_write_time(cachedPath, std::time(nullptr), ec);
+    return true;
+}
+
+bool MapCache::add(const Key& key, const bfs::path& filePath)
+{
+    boost::system::error_code ec;
+    bfs::create_directories(cacheDir_, ec);
+    if(!ec)
+        copyFile(filePath, getPath(key), ec);
+    if(ec)
+    {
+        LOG.write("Failed to add %1% to the map cache: %2%\n") % filePath % ec.message();
+        return false;
+    }
+    removeOldFiles();
+    return true;
+}
+
+void MapCache::removeOldFiles()
+{
+    std::vector<std::pair<std::time_t, bfs::path>> files;
+    boost::system::error_code ec;
+    for(const auto& entry : bfs::directory_iterator(cacheDir_, ec))
+    {
+        if(bfs::is_regular_file(entry.status()))
+            files.emplace_back(bfs::last_write_time(entry.path(), ec), entry.path());
+    }
+    if(files.size() <= maxNumFiles)
+        return;
+    std::sort(files.begin(), files.end());
+    for(unsigned i = 0; i < files.size() - maxNumFiles; i++)
+        bfs::remove(files[i].second, ec);
+}
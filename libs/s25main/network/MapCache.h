@@ -0,0 +1,37 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+
+/// Local store of map and script files received from servers.
+/// Files are addressed by their content (sizes and checksum as sent by the server), not by their name,
+/// so a map already received once does not need to be transferred again even if it was renamed.
+class MapCache
+{
+public:
+    struct Key
+    {
+        unsigned length;
+        unsigned compressedLength;
+        unsigned checksum;
+    };
+
+    /// Maximum number of files kept. The least recently used ones are removed first.
+    static constexpr unsigned maxNumFiles = 100;
+
+    explicit MapCache(boost::filesystem::path cacheDir);
+
+    /// Copy the cached file with the given key to targetPath. Return false if there is no such file
+    bool restore(const Key& key, const boost::filesystem::path& targetPath) const;
+    /// Copy the file to the cache
+    bool add(const Key& key, const boost::filesystem::path& filePath);
+
+private:
+    boost::filesystem::path cacheDir_;
+
+    boost::filesystem::path getPath(const Key& key) const;
+    void removeOldFiles();
+};
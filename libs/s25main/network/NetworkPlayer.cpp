@@ -4,27 +4,51 @@
 
 #include "NetworkPlayer.h"
 #include "GameMessage.h"
+#include "RTTR_Assert.h"
 
 NetworkPlayer::NetworkPlayer(unsigned playerId)
-    : playerId(playerId), recvQueue(GameMessage::create_game), sendQueue(GameMessage::create_game)
+    : playerId(playerId), recvQueue(GameMessage::create_game), sendQueue(GameMessage::create_game),
+      networkThread_(nullptr)
 {}
 
 void NetworkPlayer::closeConnection()
 {
+    // Make sure the network thread is done with the socket before closing it
+    if(connection_)
+    {
+        networkThread_->remove(connection_);
+        connection_.reset();
+        networkThread_ = nullptr;
+    }
     // Close socket and clear queues
     socket.Close();
     sendQueue.clear();
     recvQueue.clear();
 }
 
+void NetworkPlayer::attachToNetworkThread(NetworkThread& networkThread)
+{
+    RTTR_Assert(!connection_);
+    networkThread_ = &networkThread;
+    connection_ = networkThread.add(socket, GameMessage::create_game);
+}
+
 bool NetworkPlayer::receiveMsgs()
 {
-    return recvQueue.recvAll(socket) >= 0;
+    if(!connection_)
+        return recvQueue.recvAll(socket) >= 0;
+    while(auto msg = connection_->pop())
+        recvQueue.push(msg.release());
+    return !connection_->hasFailed();
 }
 
 bool NetworkPlayer::sendMsgs(int maxNumMsgs)
 {
-    return sendQueue.send(socket, maxNumMsgs);
+    if(!connection_)
+        return sendQueue.send(socket, maxNumMsgs);
+    while(!sendQueue.empty() && !connection_->isOutQueueFull())
+        connection_->push(sendQueue.pop());
+    return !connection_->hasFailed();
 }
 
 void NetworkPlayer::sendMsgAsync(Message* msg)
@@ -34,7 +58,10 @@ void NetworkPlayer::sendMsgAsync(Message* msg)
 
 void NetworkPlayer::sendMsg(const Message& msg)
 {
-    MessageQueue::sendMessage(socket, msg);
+    if(connection_)
+        connection_->sendNow(msg);
+    else
+        MessageQueue::sendMessage(socket, msg);
 }
 
 void NetworkPlayer::executeMsgs(MessageInterface& msgHandler)
@@ -50,4 +77,6 @@ void swap(NetworkPlayer& lhs, NetworkPlayer& rhs)
     swap(lhs.recvQueue, rhs.recvQueue);
     swap(lhs.sendQueue, rhs.sendQueue);
     swap(lhs.socket, rhs.socket);
+    swap(lhs.networkThread_, rhs.networkThread_);
+    swap(lhs.connection_, rhs.connection_);
 }
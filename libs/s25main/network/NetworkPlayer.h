@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include "NetworkThread.h"
 #include "s25util/MessageQueue.h"
 #include "s25util/Socket.h"
+#include <memory>
 
 class Message;
 class MessageInterface;
@@ -18,9 +20,14 @@ public:
     virtual ~NetworkPlayer() = default;
     /// Close the socket and clear queues
     virtual void closeConnection();
-    /// Receive all waiting messages from the socket. Return false on error
+    /// Let the network thread do all I/O on the socket from now on.
+    /// The send/recv queues then only hold messages not yet passed to/retrieved from the network thread
+    void attachToNetworkThread(NetworkThread& networkThread);
+    bool usesNetworkThread() const { return connection_ != nullptr; }
+    /// Receive all waiting messages from the socket (or the network thread). Return false on error
     bool receiveMsgs();
-    /// Send at most maxNumMsgs (if non-negative). Return false on error
+    /// Send at most maxNumMsgs (if non-negative). With a network thread all messages are passed to it
+    /// (as long as its queue is not full). Return false on error
     bool sendMsgs(int maxNumMsgs);
     /// Enqueue a message to be send later
     void sendMsgAsync(Message* msg);
@@ -33,6 +40,11 @@ public:
     unsigned playerId;
     MessageQueue recvQueue, sendQueue;
     Socket socket;
+
+private:
+    friend void swap(NetworkPlayer& lhs, NetworkPlayer& rhs);
+    NetworkThread* networkThread_;
+    std::shared_ptr<NetworkThread::Connection> connection_;
 };
 
 void swap(NetworkPlayer& lhs, NetworkPlayer& rhs);
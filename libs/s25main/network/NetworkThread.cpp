@@ -0,0 +1,258 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "NetworkThread.h"
+#include "helpers/containerUtils.h"
+#include "s25util/Message.h"
+#include "s25util/SocketSet.h"
+#include <chrono>
+#ifdef _WIN32
+#    include <winsock2.h>
+#else
+#    include <sys/socket.h>
+#endif
+
+namespace {
+/// Number of decoded messages buffered per direction before the producer has to wait
+constexpr size_t MSG_QUEUE_SIZE = 256;
+/// Max. time in ms to wait for socket events. Bounds the delay of changes which don't wake up the thread
+constexpr unsigned MAX_WAIT_TIME = 100;
+/// Time in ms to wait if there is still I/O pending or the thread cannot be woken up
+constexpr unsigned POLL_WAIT_TIME = 1;
+
+#ifdef _WIN32
+/// Create 2 connected sockets. Windows has no socketpair, so connect them via a listener on the loopback interface.
+/// Another local process could connect to it first, so the connection is only used if it comes from our socket
+bool createSocketPair(SOCKET& sender, SOCKET& receiver)
+{
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0; // Any free port
+    int addrLen = sizeof(addr);
+    const SOCKET listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    bool isConnected = listener != INVALID_SOCKET
+                       && bind(listener, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0
+                       && listen(listener, 1) == 0
+                       && getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addrLen) == 0;
+    sender = receiver = INVALID_SOCKET;
+    if(isConnected)
+    {
+        sender = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        isConnected =
+          sender != INVALID_SOCKET && connect(sender, reinterpret_cast<const sockaddr*>(&addr), addrLen) == 0;
+    }
+    if(isConnected)
+    {
+        sockaddr_in senderAddr = {}, peerAddr = {};
+        int senderAddrLen = sizeof(senderAddr), peerAddrLen = sizeof(peerAddr);
+        receiver = accept(listener, reinterpret_cast<sockaddr*>(&peerAddr), &peerAddrLen);
+        isConnected = receiver != INVALID_SOCKET
+                      && getsockname(sender, reinterpret_cast<sockaddr*>(&senderAddr), &senderAddrLen) == 0
+                      && peerAddr.sin_addr.s_addr == senderAddr.sin_addr.s_addr
+                      && peerAddr.sin_port == senderAddr.sin_port;
+    }
+    if(listener != INVALID_SOCKET)
+        closesocket(listener);
+    if(!isConnected)
+    {
+        if(sender != INVALID_SOCKET)
+            closesocket(sender);
+        if(receiver != INVALID_SOCKET)
+            closesocket(receiver);
+    }
+    return isConnected;
+}
+#else
+/// Create 2 connected sockets which are not reachable from outside the process
+bool createSocketPair(SOCKET& sender, SOCKET& receiver)
+{
+    int sockets[2];
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+        return false;
+    sender = sockets[0];
+    receiver = sockets[1];
+    return true;
+}
+#endif
+} // namespace
+
+NetworkThread::Connection::Connection(NetworkThread& owner, const Socket& socket, CreateMsgFunction createMsg)
+    : owner_(owner), socket_(socket), recvQueue_(createMsg), sendQueue_(createMsg), inQueue_(MSG_QUEUE_SIZE),
+      outQueue_(MSG_QUEUE_SIZE), removed_(false), failed_(false)
+{}
+
+bool NetworkThread::Connection::push(std::unique_ptr<Message>&& msg)
+{
+    if(!outQueue_.push(std::move(msg)))
+        return false;
+    owner_.wakeup();
+    return true;
+}
+
+std::unique_ptr<Message> NetworkThread::Connection::pop()
+{
+    std::unique_ptr<Message> msg;
+    inQueue_.pop(msg);
+    return msg;
+}
+
+void NetworkThread::Connection::sendNow(const Message& msg)
+{
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    MessageQueue::sendMessage(socket_, msg);
+}
+
+bool NetworkThread::Connection::run(bool isReadable, bool hasError)
+{
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    if(removed_)
+        return false;
+    if(hasError || (isReadable && recvQueue_.recvAll(socket_) < 0))
+    {
+        failed_ = true;
+        return false;
+    }
+    // Keep messages in the I/O queue if the game thread is behind
+    while(!recvQueue_.empty() && !inQueue_.full())
+        inQueue_.push(recvQueue_.pop());
+    std::unique_ptr<Message> msg;
+    while(outQueue_.pop(msg))
+        sendQueue_.push(msg.release());
+    if(!sendQueue_.empty() && !sendQueue_.send(socket_, -1))
+        failed_ = true;
+    return !failed_ && !recvQueue_.empty();
+}
+
+NetworkThread::NetworkThread() : wakeupPending_(false), stop_(false)
+{
+    // Without the wakeup sockets the thread falls back to polling
+    if(!createWakeupSockets())
+    {
+        wakeupSender_.Close();
+        wakeupReceiver_.Close();
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+NetworkThread::~NetworkThread()
+{
+    stop_ = true;
+    wakeup();
+    thread_.join();
+    wakeupSender_.Close();
+    wakeupReceiver_.Close();
+}
+
+bool NetworkThread::createWakeupSockets()
+{
+    SOCKET sender, receiver;
+    if(!createSocketPair(sender, receiver))
+        return false;
+    wakeupSender_ = Socket(sender, Socket::Status::Connected);
+    wakeupReceiver_ = Socket(receiver, Socket::Status::Connected);
+    return true;
+}
+
+void NetworkThread::wakeup()
+{
+    // A single unread byte is enough to wake up the thread
+    static constexpr char wakeupSignal = 0;
+    if(wakeupSender_.isValid() && !wakeupPending_.exchange(true))
+        wakeupSender_.Send(&wakeupSignal, sizeof(wakeupSignal));
+}
+
+std::shared_ptr<NetworkThread::Connection> NetworkThread::add(const Socket& socket, CreateMsgFunction createMsg)
+{
+    auto connection = std::make_shared<Connection>(*this, socket, createMsg);
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        connections_.push_back(connection);
+    }
+    // Data might already be waiting on the socket
+    wakeup();
+    return connection;
+}
+
+void NetworkThread::remove(const std::shared_ptr<Connection>& connection)
+{
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        helpers::erase(connections_, connection);
+    }
+    // The network thread might currently do I/O on a copy of the connection list, so wait for that to finish
+    std::lock_guard<std::mutex> lock(connection->ioMutex_);
+    connection->removed_ = true;
+}
+
+size_t NetworkThread::getNumConnections()
+{
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    return connections_.size();
+}
+
+void NetworkThread::run()
+{
+    bool ioPending = false;
+    while(!stop_)
+    {
+        // Block until there are socket events or we are woken up unless there is still something to do
+        const bool canBlock = !ioPending && wakeupReceiver_.isValid();
+        ioPending = runConnections(canBlock ? MAX_WAIT_TIME : POLL_WAIT_TIME);
+    }
+}
+
+bool NetworkThread::runConnections(unsigned timeout)
+{
+    std::vector<std::shared_ptr<Connection>> connections;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        // Connections only referenced by us belong to players that are gone
+        helpers::erase_if(connections_, [](const auto& connection) { return connection.use_count() == 1; });
+        // Work on a copy so the lock is not held while waiting for or doing I/O
+        connections = connections_;
+    }
+
+    SocketSet readSet, errorSet;
+    bool hasSockets = false;
+    if(wakeupReceiver_.isValid())
+    {
+        readSet.Add(wakeupReceiver_);
+        hasSockets = true;
+    }
+    for(const auto& connection : connections)
+    {
+        if(connection->hasFailed())
+            continue;
+        readSet.Add(connection->socket_);
+        errorSet.Add(connection->socket_);
+        hasSockets = true;
+    }
+    if(!hasSockets)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+        return false;
+    }
+    const bool anyReadable = readSet.Select(timeout, 0) > 0;
+    const bool anyError = errorSet.Select(0, 2) > 0;
+
+    if(anyReadable && wakeupReceiver_.isValid() && readSet.InSet(wakeupReceiver_))
+    {
+        // Reset first so a wakeup during the following I/O is not lost
+        wakeupPending_ = false;
+        char buffer[16];
+        wakeupReceiver_.Recv(buffer, sizeof(buffer));
+    }
+
+    bool ioPending = false;
+    for(const auto& connection : connections)
+    {
+        if(connection->hasFailed())
+            continue;
+        const bool isReadable = anyReadable && readSet.InSet(connection->socket_);
+        const bool hasError = anyError && errorSet.InSet(connection->socket_);
+        ioPending |= connection->run(isReadable, hasError);
+    }
+    return ioPending;
+}
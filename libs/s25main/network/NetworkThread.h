@@ -0,0 +1,84 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "helpers/SPSCQueue.h"
+#include "s25util/MessageQueue.h"
+#include "s25util/Socket.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Message;
+
+/// Thread doing the socket I/O and message (de)serialization for a set of connections,
+/// so the network keeps running independent of the frame rate of the game thread.
+/// Each connection exchanges decoded messages with the game thread via lock-free single-producer single-consumer queues
+class NetworkThread
+{
+public:
+    class Connection
+    {
+    public:
+        Connection(NetworkThread& owner, const Socket& socket, CreateMsgFunction createMsg);
+
+        /// Game thread: Queue a message for sending. Return false (and keep the message) if the queue is full
+        bool push(std::unique_ptr<Message>&& msg);
+        /// Game thread: True if push would fail
+        bool isOutQueueFull() const { return outQueue_.full(); }
+        /// Game thread: Get the next received message or nullptr if there is none
+        std::unique_ptr<Message> pop();
+        /// Game thread: Send a message directly, bypassing the queue
+        void sendNow(const Message& msg);
+        /// True if an error occurred on the socket. No further I/O is done in that case
+        bool hasFailed() const { return failed_; }
+
+    private:
+        friend class NetworkThread;
+        /// Do the I/O for this connection. Called from the network thread only.
+        /// Return true if there is still I/O pending which could not be done yet
+        bool run(bool isReadable, bool hasError);
+
+        NetworkThread& owner_;
+        Socket socket_;
+        /// Queues used for the actual socket I/O, only accessed by the network thread
+        MessageQueue recvQueue_, sendQueue_;
+        helpers::SPSCQueue<std::unique_ptr<Message>> inQueue_, outQueue_;
+        /// Guards all socket I/O as sendNow is called from the game thread and remove must wait for running I/O
+        std::mutex ioMutex_;
+        /// Set when removed from the thread. No socket I/O is done afterwards
+        bool removed_;
+        std::atomic<bool> failed_;
+    };
+
+    NetworkThread();
+    ~NetworkThread();
+
+    /// Start handling I/O for the given socket. The socket must not be used for I/O by the caller afterwards
+    std::shared_ptr<Connection> add(const Socket& socket, CreateMsgFunction createMsg);
+    /// Stop handling the connection. When this returns the network thread does not access the socket anymore
+    void remove(const std::shared_ptr<Connection>& connection);
+    size_t getNumConnections();
+
+private:
+    /// Create the connected sockets used by wakeup. Return false if that is not possible
+    bool createWakeupSockets();
+    /// Make the network thread return from waiting for socket events
+    void wakeup();
+    void run();
+    /// Wait at most timeout ms for socket events and do the I/O for all connections.
+    /// Return true if there is still I/O pending which could not be done yet
+    bool runConnections(unsigned timeout);
+
+    std::mutex connectionsMutex_;
+    std::vector<std::shared_ptr<Connection>> connections_;
+    /// Connected socket pair: Sending a byte to wakeupSender_ interrupts the select on wakeupReceiver_
+    Socket wakeupSender_, wakeupReceiver_;
+    std::atomic<bool> wakeupPending_;
+    std::atomic<bool> stop_;
+    std::thread thread_;
+};
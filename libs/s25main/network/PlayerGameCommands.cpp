@@ -8,16 +8,24 @@
 void PlayerGameCommands::Serialize(Serializer& ser) const
 {
     checksum.Serialize(ser);
+    SerializeCommands(ser);
+}
+
+void PlayerGameCommands::Deserialize(Serializer& ser)
+{
+    checksum.Deserialize(ser);
+    DeserializeCommands(ser);
+}
 
+void PlayerGameCommands::SerializeCommands(Serializer& ser) const
+{
     ser.PushUnsignedInt(gcs.size());
     for(const gc::GameCommandPtr& gc : gcs)
         gc->Serialize(ser);
 }
 
-void PlayerGameCommands::Deserialize(Serializer& ser)
+void PlayerGameCommands::DeserializeCommands(Serializer& ser)
 {
-    checksum.Deserialize(ser);
-
     gcs.resize(ser.PopUnsignedInt());
     for(gc::GameCommandPtr& gc : gcs)
         gc = gc::GameCommand::Deserialize(ser);
@@ -23,4 +23,7 @@ struct PlayerGameCommands
     {}
     void Serialize(Serializer& ser) const;
     void Deserialize(Serializer& ser);
+    /// Only the game commands, for formats storing the checksum differently (e.g. replays)
+    void SerializeCommands(Serializer& ser) const;
+    void DeserializeCommands(Serializer& ser);
 };
@@ -0,0 +1,30 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "SerializedGameMessage.h"
+#include "RTTR_Assert.h"
+#include "s25util/Serializer.h"
+
+namespace {
+std::shared_ptr<const Serializer> serialize(const GameMessage& msg)
+{
+    auto data = std::make_shared<Serializer>();
+    msg.Serialize(*data);
+    return data;
+}
+} // namespace
+
+SerializedGameMessage::SerializedGameMessage(const GameMessage& msg) : GameMessage(msg.getId()), data_(serialize(msg))
+{}
+
+void SerializedGameMessage::Serialize(Serializer& ser) const
+{
+    ser.PushRawData(data_->GetData(), data_->GetLength());
+}
+
+bool SerializedGameMessage::Run(GameMessageInterface* /*callback*/) const
+{
+    RTTR_Assert(false); // LCOV_EXCL_LINE
+    return false;       // LCOV_EXCL_LINE
+}
@@ -0,0 +1,31 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "GameMessage.h"
+#include <memory>
+#include <utility>
+
+/// A game message that is serialized once on construction and can only be sent.
+/// Copies share the serialized data, so sending the same message to many players needs neither a (deep) copy
+/// of the message nor serializing it again for each of them.
+/// The receiver gets the original message type.
+class SerializedGameMessage : public GameMessage
+{
+public:
+    explicit SerializedGameMessage(const GameMessage& msg);
+    /// Create a new message sharing the serialized data
+    SerializedGameMessage* copy() const { return new SerializedGameMessage(getId(), data_); }
+
+    void Serialize(Serializer& ser) const override;
+    /// Not meant to be executed
+    bool Run(GameMessageInterface* callback) const override;
+
+private:
+    SerializedGameMessage(uint16_t id, std::shared_ptr<const Serializer> data) : GameMessage(id), data_(std::move(data))
+    {}
+
+    std::shared_ptr<const Serializer> data_;
+};
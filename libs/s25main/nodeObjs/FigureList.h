@@ -0,0 +1,59 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "RTTR_Assert.h"
+#include "helpers/IntrusiveList.h"
+#include "nodeObjs/noBase.h"
+#include <cstddef>
+#include <memory>
+
+/// List of the figures (and fights) on a map node which owns the contained objects.
+/// Based on helpers::IntrusiveList, so adding, removing and checking if an object is contained are O(1) and don't
+/// allocate. Iterates in insertion order and yields (non-null) pointers like a std::list<noBase*>
+class FigureList
+{
+    using List = helpers::IntrusiveList<noBase>;
+
+public:
+    using iterator = List::iterator;
+    using const_iterator = List::const_iterator;
+    using value_type = List::value_type;
+
+    FigureList() = default;
+    FigureList(FigureList&&) noexcept = default;
+    FigureList& operator=(FigureList&& other) noexcept
+    {
+        clear();
+        list_ = std::move(other.list_);
+        return *this;
+    }
+    ~FigureList() { clear(); }
+
+    iterator begin() const { return list_.begin(); }
+    iterator end() const { return list_.end(); }
+    bool empty() const { return list_.empty(); }
+    size_t size() const { return list_.size(); }
+
+    /// Append the object to the list taking ownership
+    void push_back(std::unique_ptr<noBase> fig) { list_.push_back(fig.release()); }
+    /// Remove the object (which must be in this list) and return ownership
+    std::unique_ptr<noBase> remove(noBase& fig)
+    {
+        RTTR_Assert(contains(fig));
+        list_.remove(&fig);
+        return std::unique_ptr<noBase>(&fig);
+    }
+    bool contains(const noBase& fig) const { return list_.contains(&fig); }
+    /// Remove and delete all objects
+    void clear()
+    {
+        while(!list_.empty())
+            delete remove(**list_.begin()).release();
+    }
+
+private:
+    List list_;
+};
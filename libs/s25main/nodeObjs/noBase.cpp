@@ -15,7 +15,7 @@ void noBase::Serialize(SerializedGameData& sgd) const
     sgd.PushEnum<uint8_t>(nop);
 }
 
-std::unique_ptr<FOWObject> noBase::CreateFOWObject() const
+const FOWObject* noBase::CreateFOWObject() const
 {
     return nullptr;
 }
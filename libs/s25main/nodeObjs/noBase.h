@@ -7,6 +7,7 @@
 #include "DrawPoint.h"
 #include "GameObject.h"
 #include "NodalObjectTypes.h"
+#include "helpers/IntrusiveList.h"
 #include <memory>
 
 class FOWObject;
@@ -24,7 +25,8 @@ enum class BlockingManner
     NothingAround /// Allow nothing around
 };
 
-class noBase : public GameObject
+/// Figures are stored in the FigureList of their map node, so every object has the hook for it
+class noBase : public GameObject, public helpers::IntrusiveListHook<noBase>
 {
 public:
     noBase(const NodalObjectType nop) : nop(nop) {}
@@ -38,8 +40,8 @@ public:
 
     void Serialize(SerializedGameData& sgd) const override;
 
-    /// Erzeugt von ihnen selbst ein FOW Objekt als visuelle "Erinnerung" für den Fog of War
-    virtual std::unique_ptr<FOWObject> CreateFOWObject() const;
+    /// Liefert von ihnen selbst ein (geteiltes) FOW Objekt als visuelle "Erinnerung" für den Fog of War
+    virtual const FOWObject* CreateFOWObject() const;
 
     virtual BlockingManner GetBM() const;
     /// Gibt zurück, ob sich das angegebene Objekt zwischen zwei Punkten bewegt
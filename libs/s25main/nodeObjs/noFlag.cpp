@@ -126,10 +126,10 @@ void noFlag::Draw(DrawPoint drawPt)
  *  Erzeugt von ihnen selbst ein FOW Objekt als visuelle "Erinnerung"
  *  für den Fog of War.
  */
-std::unique_ptr<FOWObject> noFlag::CreateFOWObject() const
+const FOWObject* noFlag::CreateFOWObject() const
 {
     const GamePlayer& owner = world->GetPlayer(player);
-    return std::make_unique<fowFlag>(owner.color, owner.nation, flagtype);
+    return fowFlag::Get(owner.color, owner.nation, flagtype);
 }
 
 /**
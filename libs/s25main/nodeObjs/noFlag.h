@@ -36,7 +36,7 @@ public:
     BlockingManner GetBM() const override { return BlockingManner::Flag; }
 
     /// Erzeugt von ihnen selbst ein FOW Objekt als visuelle "Erinnerung" für den Fog of War.
-    std::unique_ptr<FOWObject> CreateFOWObject() const override;
+    const FOWObject* CreateFOWObject() const override;
     /// Legt eine Ware an der Flagge ab.
     void AddWare(std::unique_ptr<Ware> ware) override;
     /// Gibt die Anzahl der Waren zurück, die an der Flagge liegen.
@@ -31,9 +31,9 @@ void noGranite::Draw(DrawPoint drawPt)
     LOADER.granite_cache[type][state].draw(drawPt);
 }
 
-std::unique_ptr<FOWObject> noGranite::CreateFOWObject() const
+const FOWObject* noGranite::CreateFOWObject() const
 {
-    return std::make_unique<fowGranite>(type, state);
+    return fowGranite::Get(type, state);
 }
 
 void noGranite::Hew()
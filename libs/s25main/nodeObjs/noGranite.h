@@ -28,7 +28,7 @@ public:
     BlockingManner GetBM() const override { return BlockingManner::FlagsAround; }
 
     /// Erzeugt von ihnen selbst ein FOW Objekt als visuelle "Erinnerung" für den Fog of War
-    std::unique_ptr<FOWObject> CreateFOWObject() const override;
+    const FOWObject* CreateFOWObject() const override;
 
     /// "Bearbeitet" den Granitglotz --> haut ein Stein ab
     void Hew();
@@ -7,6 +7,7 @@
 #include "GamePlayer.h"
 #include "RoadSegment.h"
 #include "SerializedGameData.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "world/GameWorld.h"
 #include "s25util/warningSuppression.h"
 
@@ -16,6 +17,7 @@ noRoadNode::noRoadNode(const NodalObjectType nop, const MapPoint pos, const unsi
     for(const auto dir : helpers::EnumRange<Direction>{})
         routes[dir] = nullptr;
     last_visit = 0;
+    componentGeneration = 0;
 }
 
 noRoadNode::~noRoadNode() = default;
@@ -61,6 +63,13 @@ noRoadNode::noRoadNode(SerializedGameData& sgd, const unsigned obj_id)
     }
 
     last_visit = 0;
+    componentGeneration = 0;
+}
+
+void noRoadNode::SetRoute(const Direction dir, RoadSegment* route)
+{
+    routes[dir] = route;
+    world->GetRoadPathFinder().InvalidateConnectivity();
 }
 
 void noRoadNode::UpgradeRoad(const Direction dir) const
@@ -74,12 +83,15 @@ void noRoadNode::DestroyRoad(const Direction dir)
     RoadSegment* route = GetRoute(dir);
     if(!route)
         return;
-    MapPoint t = route->GetF1()->GetPos();
-    for(unsigned z = 0; z < route->GetLength(); ++z)
     {
-        world->SetPointRoad(t, route->GetRoute(z), PointRoad::None);
-        world->RecalcBQForRoad(t);
-        t = world->GetNeighbour(t, route->GetRoute(z));
+        GameWorld::BQUpdateBatch bqBatch(*world);
+        MapPoint t = route->GetF1()->GetPos();
+        for(unsigned z = 0; z < route->GetLength(); ++z)
+        {
+            world->SetPointRoad(t, route->GetRoute(z), PointRoad::None);
+            world->RecalcBQForRoad(t);
+            t = world->GetNeighbour(t, route->GetRoute(z));
+        }
     }
 
     noRoadNode* otherFlag;
@@ -34,6 +34,10 @@ public:
     mutable const noRoadNode* prev; //-V730_NOINIT
     /// Direction to previous node, includes SHIP_DIR
     mutable RoadPathDirection dir_; //-V730_NOINIT
+    // For connectivity checks: Component of the road network this node belongs to, valid if componentGeneration is
+    // the current connectivity generation of the RoadPathFinder
+    mutable unsigned componentId; //-V730_NOINIT
+    mutable unsigned componentGeneration;
 
     noRoadNode(NodalObjectType nop, MapPoint pos, unsigned char player);
     noRoadNode(SerializedGameData& sgd, unsigned obj_id);
@@ -43,7 +47,7 @@ public:
     void Serialize(SerializedGameData& sgd) const override;
 
     RoadSegment* GetRoute(const Direction dir) const { return routes[dir]; }
-    void SetRoute(const Direction dir, RoadSegment* route) { routes[dir] = route; }
+    void SetRoute(Direction dir, RoadSegment* route);
     const auto& getRoutes() const { return routes; }
     noRoadNode* GetNeighbour(Direction dir) const;
 
@@ -200,9 +200,9 @@ void noTree::HandleEvent(const unsigned id)
     }
 }
 
-std::unique_ptr<FOWObject> noTree::CreateFOWObject() const
+const FOWObject* noTree::CreateFOWObject() const
 {
-    return std::make_unique<fowTree>(type, size);
+    return fowTree::Get(type, size);
 }
 
 void noTree::FallSoon()
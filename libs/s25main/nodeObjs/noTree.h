@@ -82,7 +82,7 @@ public:
     BlockingManner GetBM() const override { return BlockingManner::Tree; }
 
     /// Erzeugt von ihnen selbst ein FOW Objekt als visuelle "Erinnerung" für den Fog of War
-    std::unique_ptr<FOWObject> CreateFOWObject() const override;
+    const FOWObject* CreateFOWObject() const override;
     /// Can this tree(type) produce wood?
     bool ProducesWood() const { return type != 5; }
     /// Return if this tree is fully grown
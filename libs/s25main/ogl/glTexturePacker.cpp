@@ -8,11 +8,23 @@
 #include "ogl/glTexturePackerNode.h"
 #include "ogl/saveBitmap.h"
 #include "libsiedler2/PixelBufferBGRA.h"
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <glad/glad.h>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
 #include <utility>
 
+namespace {
+/// Identifies the cache file. Increase the version when changing the format
+constexpr std::array<char, 8> cacheSignature = {{'R', 'T', 'T', 'R', 'T', 'E', 'X', 'C'}};
+constexpr uint32_t cacheVersion = 1;
+/// Page index for items not placed on any texture
+constexpr uint32_t noPage = 0xFFFFFFFF;
+} // namespace
+
 static bool isSizeGreater(glSmartBitmap* a, glSmartBitmap* b)
 {
     const Extent sizeA = a->getRequiredTexSize();
@@ -20,7 +32,7 @@ static bool isSizeGreater(glSmartBitmap* a, glSmartBitmap* b)
     return (sizeA.x * sizeA.y) > (sizeB.x * sizeB.y);
 }
 
-bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
+bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list, bool keepData)
 {
     glTexture texture;
 
@@ -89,15 +101,22 @@ bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
             if(!texture.uploadData(buffer))
                 return false;
 
-            if(left.empty()) // nothing left, just generate texture and return success
+            if(left.empty() || maxTex)
             {
+                if(keepData)
+                {
+                    const auto* pixels = reinterpret_cast<const uint8_t*>(buffer.getPixelPtr());
+                    const size_t dataSize = static_cast<size_t>(curSize.x) * curSize.y * 4u;
+                    texturesData.push_back(TextureData{curSize, std::vector<uint8_t>(pixels, pixels + dataSize)});
+                }
                 textures.emplace_back(std::move(texture));
+            }
+            if(left.empty()) // nothing left, just generate texture and return success
                 return true;
-            } else if(maxTex) // maximum texture size reached and something still left
+            else if(maxTex) // maximum texture size reached and something still left
             {
-                textures.emplace_back(std::move(texture));
                 // recursively generate textures for what is left
-                return packHelper(left);
+                return packHelper(left, keepData);
             }
 
             // our pre-estimated size if the big texture was not enough for the algorithm to fit all textures in
@@ -115,11 +134,14 @@ bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
     } while(true);
 }
 
-bool glTexturePacker::pack()
+bool glTexturePacker::pack(bool keepData)
 {
-    std::sort(items.begin(), items.end(), isSizeGreater);
+    // Keep the items in the order they were added so the cache can refer to them by index
+    std::vector<glSmartBitmap*> sortedItems = items;
+    std::sort(sortedItems.begin(), sortedItems.end(), isSizeGreater);
 
-    if(packHelper(items))
+    texturesData.clear();
+    if(packHelper(sortedItems, keepData))
         return true;
 
     // reset glSmartBitmap textures
@@ -127,10 +149,146 @@ bool glTexturePacker::pack()
         bmp->setSharedTexture(0);
 
     textures.clear();
+    texturesData.clear();
 
     return false;
 }
 
+/* Cache format (native endianess as the cache is only used on the machine where it was created):
+ * signature, version, key
+ * numItems, per item: page index, required texture size, texture coordinates
+ * numPages, per page: size, BGRA pixel data
+ */
+bool glTexturePacker::saveCache(const boost::filesystem::path& filepath, uint64_t key)
+{
+    const std::vector<TextureData> data = std::move(texturesData);
+    texturesData.clear();
+    if(textures.empty() || data.size() != textures.size())
+        return false;
+
+    boost::nowide::ofstream file(filepath, std::ios::binary);
+    if(!file)
+        return false;
+    const auto write = [&file](const auto& value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+    file.write(cacheSignature.data(), cacheSignature.size());
+    write(cacheVersion);
+    write(key);
+    write(static_cast<uint32_t>(items.size()));
+    for(const glSmartBitmap* bmp : items)
+    {
+        const auto itTex = std::find_if(textures.begin(), textures.end(),
+                                        [bmp](const glTexture& tex) { return tex.get() == bmp->getTexture(); });
+        write(itTex == textures.end() ? noPage : static_cast<uint32_t>(itTex - textures.begin()));
+        write(bmp->getRequiredTexSize());
+        write(bmp->texCoords);
+    }
+    write(static_cast<uint32_t>(data.size()));
+    for(const TextureData& texData : data)
+    {
+        write(texData.size);
+        file.write(reinterpret_cast<const char*>(texData.pixels.data()), texData.pixels.size());
+    }
+    return static_cast<bool>(file);
+}
+
+bool glTexturePacker::loadCache(const boost::filesystem::path& filepath, uint64_t key)
+{
+    if(!boost::filesystem::exists(filepath))
+        return false;
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(filepath);
+    } catch(const std::exception&)
+    {
+        return false;
+    }
+    if(!file.is_open())
+        return false;
+
+    // Read directly from the mapped memory. Any read past the end marks the file as invalid
+    const char* curPos = file.data();
+    const char* const endPos = file.data() + file.size();
+    bool valid = true;
+    const auto read = [&](auto& value) {
+        if(static_cast<size_t>(endPos - curPos) < sizeof(value))
+        {
+            valid = false;
+            return;
+        }
+        std::memcpy(&value, curPos, sizeof(value));
+        curPos += sizeof(value);
+    };
+
+    std::array<char, cacheSignature.size()> signature;
+    uint32_t version = 0, numItems = 0;
+    uint64_t readKey = 0;
+    read(signature);
+    read(version);
+    read(readKey);
+    read(numItems);
+    if(!valid || signature != cacheSignature || version != cacheVersion || readKey != key || numItems != items.size())
+        return false;
+
+    struct ItemPlacement
+    {
+        uint32_t page;
+        std::array<Point<float>, 8> texCoords;
+    };
+    std::vector<ItemPlacement> placements(numItems);
+    for(unsigned i = 0; i < numItems && valid; i++)
+    {
+        Extent requiredSize;
+        read(placements[i].page);
+        read(requiredSize);
+        read(placements[i].texCoords);
+        // Items have changed -> Cache is outdated
+        if(requiredSize != items[i]->getRequiredTexSize())
+            return false;
+    }
+    uint32_t numPages = 0;
+    read(numPages);
+    if(!valid)
+        return false;
+
+    std::vector<glTexture> newTextures;
+    for(unsigned i = 0; i < numPages; i++)
+    {
+        Extent size;
+        read(size);
+        const size_t dataSize = static_cast<size_t>(size.x) * size.y * 4u;
+        if(!valid || static_cast<size_t>(endPos - curPos) < dataSize)
+            return false;
+        glTexture texture;
+        // Texture might be to big for the current graphics card
+        if(!texture.checkSize(size) || !texture.uploadData(size, curPos))
+            return false;
+        curPos += dataSize;
+        newTextures.emplace_back(std::move(texture));
+    }
+
+    for(unsigned i = 0; i < numItems; i++)
+    {
+        if(placements[i].page >= newTextures.size())
+        {
+            if(placements[i].page == noPage)
+                continue;
+            return false;
+        }
+    }
+    for(unsigned i = 0; i < numItems; i++)
+    {
+        if(placements[i].page == noPage)
+            continue;
+        items[i]->setSharedTexture(newTextures[placements[i].page].get());
+        items[i]->texCoords = placements[i].texCoords;
+    }
+    textures = std::move(newTextures);
+    texturesData.clear();
+    return true;
+}
+
 glTexture::glTexture() : handle(VIDEODRIVER.GenerateTexture()), size(0, 0)
 {
     if(!handle)
@@ -175,13 +333,17 @@ bool glTexture::checkSize(const Extent& size) const
 }
 
 bool glTexture::uploadData(const libsiedler2::PixelBufferBGRA& buffer)
+{
+    return uploadData(Extent(buffer.getWidth(), buffer.getHeight()), buffer.getPixelPtr());
+}
+
+bool glTexture::uploadData(const Extent& texSize, const void* pixels)
 {
     if(!handle)
         return false;
     VIDEODRIVER.BindTexture(handle);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, buffer.getWidth(), buffer.getHeight(), 0, GL_BGRA, GL_UNSIGNED_BYTE,
-                 buffer.getPixelPtr());
-    size = Extent(buffer.getWidth(), buffer.getHeight());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texSize.x, texSize.y, 0, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+    size = texSize;
     int resultWidth;
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &resultWidth);
     return resultWidth > 0;
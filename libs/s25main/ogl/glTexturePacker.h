@@ -5,6 +5,8 @@
 #pragma once
 
 #include "Point.h"
+#include <boost/filesystem/path.hpp>
+#include <cstdint>
 #include <vector>
 
 class glSmartBitmap;
@@ -33,18 +35,38 @@ public:
     void bind() const;
     bool checkSize(const Extent&) const;
     bool uploadData(const libsiedler2::PixelBufferBGRA&);
+    /// Upload BGRA data of the given size
+    bool uploadData(const Extent& texSize, const void* pixels);
 };
 
 class glTexturePacker
 {
-private:
+    struct TextureData
+    {
+        Extent size;
+        std::vector<uint8_t> pixels;
+    };
+
     std::vector<glTexture> textures;
+    /// Items in the order they were added
     std::vector<glSmartBitmap*> items;
+    /// Copy of the pixel data of the textures. Only filled if requested by pack
+    std::vector<TextureData> texturesData;
 
-    bool packHelper(std::vector<glSmartBitmap*>& list);
+    bool packHelper(std::vector<glSmartBitmap*>& list, bool keepData);
 
 public:
-    bool pack();
+    /// Pack all items into as few textures as possible.
+    /// If keepData is true the pixel data is kept so it can be written by saveCache
+    bool pack(bool keepData = false);
     void add(glSmartBitmap& bmp) { items.push_back(&bmp); }
     const auto& getTextures() const { return textures; }
+
+    /// Write the packed textures and the placement of all items to the given file tagged with the given key.
+    /// Requires a successful call to pack with keepData=true. Releases the kept pixel data.
+    bool saveCache(const boost::filesystem::path& filepath, uint64_t key);
+    /// Restore the textures from a file written by saveCache instead of packing the items.
+    /// The same items must have been added in the same order and the key must match.
+    /// Returns false if the file is missing or does not match the current items
+    bool loadCache(const boost::filesystem::path& filepath, uint64_t key);
 };
@@ -124,6 +124,11 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
         return true;
     }
 
+    // Skip the search (which would visit every reachable node) if the goal cannot be reached at all.
+    // Bounded searches stop early anyway, so don't (re)determine the components for them
+    if(max == std::numeric_limits<unsigned>::max() && !MightBeConnected(start, goal))
+        return false;
+
     // increase current_visit_on_roads, so we don't have to clear the visited-states at every run
     currentVisit++;
 
@@ -287,6 +292,60 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
     return false;
 }
 
+void RoadPathFinder::InvalidateConnectivity()
+{
+    ++connectivityGeneration_;
+}
+
+bool RoadPathFinder::MightBeConnected(const noRoadNode& start, const noRoadNode& goal)
+{
+    const unsigned startComponent = GetComponent(start);
+    const unsigned goalComponent = GetComponent(goal);
+    if(startComponent == goalComponent)
+        return true;
+    // Ship connections only exist between harbors
+    return componentHasHarbor_[startComponent] && componentHasHarbor_[goalComponent];
+}
+
+unsigned RoadPathFinder::GetComponent(const noRoadNode& node)
+{
+    if(componentsGeneration_ != connectivityGeneration_)
+    {
+        componentsGeneration_ = connectivityGeneration_;
+        componentHasHarbor_.clear();
+    }
+    if(node.componentGeneration == connectivityGeneration_)
+        return node.componentId;
+
+    // Flood fill over all roads. This ignores restrictions like not passing through buildings so it only ever joins
+    // more nodes than the pathfinding could reach
+    const auto componentId = static_cast<unsigned>(componentHasHarbor_.size());
+    bool hasHarbor = false;
+    componentTodo_.clear();
+    node.componentGeneration = connectivityGeneration_;
+    node.componentId = componentId;
+    componentTodo_.push_back(&node);
+    while(!componentTodo_.empty())
+    {
+        const noRoadNode& curNode = *componentTodo_.back();
+        componentTodo_.pop_back();
+        if(curNode.GetGOT() == GO_Type::NobHarborbuilding)
+            hasHarbor = true;
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            const noRoadNode* neighbour = curNode.GetNeighbour(dir);
+            if(neighbour && neighbour->componentGeneration != connectivityGeneration_)
+            {
+                neighbour->componentGeneration = connectivityGeneration_;
+                neighbour->componentId = componentId;
+                componentTodo_.push_back(neighbour);
+            }
+        }
+    }
+    componentHasHarbor_.push_back(hasHarbor);
+    return componentId;
+}
+
 bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, const bool wareMode, const unsigned max,
                               const RoadSegment* const forbidden, unsigned* const length,
                               RoadPathDirection* const firstDir, MapPoint* const firstNodePos)
@@ -7,6 +7,7 @@
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/RoadPathDirection.h"
 #include <limits>
+#include <vector>
 
 class GameWorldBase;
 class noRoadNode;
@@ -16,9 +17,27 @@ class RoadPathFinder
 {
     GameWorldBase& gwb_;
     unsigned currentVisit;
+    /// Incremented on every change of the road network. Starts at 1 so default initialized nodes are never up to date.
+    /// Overflows only after billions of road changes, which does not happen in a single game
+    unsigned connectivityGeneration_;
+    /// Connectivity generation for which the components in componentHasHarbor_ were determined
+    unsigned componentsGeneration_;
+    /// For each component of the current generation: Does it contain a harbor (may have ship connections)?
+    std::vector<bool> componentHasHarbor_;
+    std::vector<const noRoadNode*> componentTodo_;
 
 public:
-    RoadPathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0) {}
+    RoadPathFinder(GameWorldBase& gwb)
+        : gwb_(gwb), currentVisit(0), connectivityGeneration_(1), componentsGeneration_(0)
+    {}
+
+    /// Must be called whenever a road is added, removed or reconnected.
+    /// Invalidates the connected components of the road network which are then recalculated on demand
+    void InvalidateConnectivity();
+
+    /// Return false if there is certainly no path between the 2 nodes, i.e. they are in different components of the
+    /// road network (including boat roads) which are not possibly connected by ships
+    bool MightBeConnected(const noRoadNode& start, const noRoadNode& goal);
 
     /// Calculates the best path from start to goal
     /// Outputs are only valid if true is returned!
@@ -44,6 +63,9 @@ public:
                     unsigned max = std::numeric_limits<unsigned>::max(), const RoadSegment* forbidden = nullptr);
 
 private:
+    /// Get the component of the node, determining it for all nodes reachable from it if required
+    unsigned GetComponent(const noRoadNode& node);
+
     template<class T_AdditionalCosts, class T_SegmentConstraints>
     bool FindPathImpl(const noRoadNode& start, const noRoadNode& goal, unsigned max, T_AdditionalCosts addCosts,
                       T_SegmentConstraints isSegmentAllowed, unsigned* length = nullptr,
@@ -69,8 +69,6 @@ std::map<uint16_t, uint16_t> extractBobMapping(libsiedler2::Archiv& archive, con
 libsiedler2::Archiv ArchiveLoader::loadFile(const fs::path& filePath,
                                             const libsiedler2::ArchivItem_Palette* palette) const
 {
-    logger_.write(_("Loading %1%: ")) % filePath;
-
     libsiedler2::Archiv archive;
     if(int ec = libsiedler2::Load(filePath, archive, palette))
         throw LoadError(libsiedler2::getErrorString(ec));
@@ -79,11 +77,11 @@ libsiedler2::Archiv ArchiveLoader::loadFile(const fs::path& filePath,
 }
 
 libsiedler2::Archiv ArchiveLoader::loadDirectory(const fs::path& filePath,
-                                                 const libsiedler2::ArchivItem_Palette* palette) const
+                                                 const libsiedler2::ArchivItem_Palette* palette,
+                                                 size_t& numEntries) const
 {
-    logger_.write(_("Loading directory %s\n")) % filePath;
     std::vector<libsiedler2::FileEntry> files = libsiedler2::ReadFolderInfo(filePath);
-    logger_.write(_("  Loading %1% entries: ")) % files.size();
+    numEntries = files.size();
 
     libsiedler2::Archiv archive;
 
@@ -102,23 +100,37 @@ libsiedler2::Archiv ArchiveLoader::loadFileOrDir(const fs::path& filePath,
     if(!is_regular_file(fileStatus) && !is_directory(fileStatus))
         throw LoadError(_("Could not determine type of path %s\n"), filePath);
 
+    const bool isDirectory = is_directory(fileStatus);
+    size_t numEntries = 0;
+    const auto logStart = [&]() {
+        if(isDirectory)
+        {
+            logger_.write(_("Loading directory %s\n")) % filePath;
+            logger_.write(_("  Loading %1% entries: ")) % numEntries;
+        } else
+            logger_.write(_("Loading %1%: ")) % filePath;
+    };
     try
     {
         const Timer timer(true);
 
         libsiedler2::Archiv result;
-        if(is_directory(fileStatus))
-            result = loadDirectory(filePath, palette);
+        if(isDirectory)
+            result = loadDirectory(filePath, palette, numEntries);
         else
             result = loadFile(filePath, palette);
 
         using namespace std::chrono;
+        std::lock_guard<std::mutex> lock(logMutex_);
+        logStart();
         // TODO: Change translations and use chronoIO
         logger_.write(_("done in %ums\n")) % duration_cast<milliseconds>(timer.getElapsed()).count();
 
         return result;
     } catch(const LoadError& e)
     {
+        std::lock_guard<std::mutex> lock(logMutex_);
+        logStart();
         logger_.write(_("failed: %1%\n")) % e.what();
         throw LoadError();
     }
@@ -177,7 +189,10 @@ libsiedler2::Archiv ArchiveLoader::load(const ResolvedFile& file, const libsiedl
         } catch(const LoadError& e)
         {
             if(e.what() != std::string())
+            {
+                std::lock_guard<std::mutex> lock(logMutex_);
                 logger_.write("Exception caught: %1%\n") % e.what();
+            }
             throw LoadError();
         }
     }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <boost/filesystem/path.hpp>
+#include <mutex>
 #include <stdexcept>
 
 class Log;
@@ -24,6 +25,8 @@ public:
     explicit LoadError(T&&... args);
 };
 
+/// Loads archives from files or directories.
+/// Loading is thread-safe, i.e. multiple archives can be loaded at once from different threads.
 class ArchiveLoader
 {
 public:
@@ -37,12 +40,14 @@ public:
     static void mergeArchives(libsiedler2::Archiv& targetArchiv, libsiedler2::Archiv& otherArchiv);
 
 private:
-    /// Load a single file, logs a message without trailing newline on start and throws a LoadError on error.
+    /// Load a single file, throws a LoadError on error.
     libsiedler2::Archiv loadFile(const boost::filesystem::path& filePath,
                                  const libsiedler2::ArchivItem_Palette* palette) const;
-    /// Load a single file, logs a message without trailing newline on start and throws a LoadError on error.
+    /// Load all files in a directory, throws a LoadError on error. Sets numEntries to the number of files found
     libsiedler2::Archiv loadDirectory(const boost::filesystem::path& filePath,
-                                      const libsiedler2::ArchivItem_Palette* palette) const;
+                                      const libsiedler2::ArchivItem_Palette* palette, size_t& numEntries) const;
 
     Log& logger_;
+    /// Log messages of one load operation are written at once while holding this to avoid interleaving them
+    mutable std::mutex logMutex_;
 };
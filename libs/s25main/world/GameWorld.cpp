@@ -218,41 +218,47 @@ void GameWorld::BuildRoad(const unsigned char playerId, const bool boat_road, co
 
     curPt = GetNeighbour(curPt, route.back());
 
-    // Prüfen, ob am Ende auch eine Flagge steht oder eine gebaut werden kann
-    if(GetNO(curPt)->GetGOT() == GO_Type::Flag)
+    // The flag and all road points overlap in the BQ area they influence, so recalculate it only once at the end.
+    // Only the check before placing the flag reads the BQ, but nothing is pending then.
+    MapPoint end(start);
     {
-        // Falscher Spieler?
-        if(GetSpecObj<noFlag>(curPt)->GetPlayer() != playerId)
+        BQUpdateBatch bqBatch(*this);
+
+        // Prüfen, ob am Ende auch eine Flagge steht oder eine gebaut werden kann
+        if(GetNO(curPt)->GetGOT() == GO_Type::Flag)
         {
-            GetNotifications().publish(RoadNote(RoadNote::ConstructionFailed, playerId, start, route));
-            return;
-        }
-    } else
-    {
-        // Check if we can build a flag there
-        if(GetBQ(curPt, playerId) == BuildingQuality::Nothing || IsFlagAround(curPt))
+            // Falscher Spieler?
+            if(GetSpecObj<noFlag>(curPt)->GetPlayer() != playerId)
+            {
+                GetNotifications().publish(RoadNote(RoadNote::ConstructionFailed, playerId, start, route));
+                return;
+            }
+        } else
         {
-            GetNotifications().publish(RoadNote(RoadNote::ConstructionFailed, playerId, start, route));
-            return;
+            // Check if we can build a flag there
+            if(GetBQ(curPt, playerId) == BuildingQuality::Nothing || IsFlagAround(curPt))
+            {
+                GetNotifications().publish(RoadNote(RoadNote::ConstructionFailed, playerId, start, route));
+                return;
+            }
+            // keine Flagge bisher aber spricht auch nix gegen ne neue Flagge -> Flagge aufstellen!
+            SetFlag(curPt, playerId);
         }
-        // keine Flagge bisher aber spricht auch nix gegen ne neue Flagge -> Flagge aufstellen!
-        SetFlag(curPt, playerId);
-    }
 
-    // Evtl Zierobjekte abreißen (Anfangspunkt)
-    if(HasRemovableObjForRoad(start))
-        DestroyNO(start);
+        // Evtl Zierobjekte abreißen (Anfangspunkt)
+        if(HasRemovableObjForRoad(start))
+            DestroyNO(start);
 
-    MapPoint end(start);
-    for(auto i : route)
-    {
-        SetPointRoad(end, i, boat_road ? PointRoad::Boat : PointRoad::Normal);
-        RecalcBQForRoad(end);
-        end = GetNeighbour(end, i);
+        for(auto i : route)
+        {
+            SetPointRoad(end, i, boat_road ? PointRoad::Boat : PointRoad::Normal);
+            RecalcBQForRoad(end);
+            end = GetNeighbour(end, i);
 
-        // Evtl Zierobjekte abreißen
-        if(HasRemovableObjForRoad(end))
-            DestroyNO(end);
+            // Evtl Zierobjekte abreißen
+            if(HasRemovableObjForRoad(end))
+                DestroyNO(end);
+        }
     }
 
     auto* rs = new RoadSegment(boat_road ? RoadType::Water : RoadType::Normal, GetSpecObj<noFlag>(start),
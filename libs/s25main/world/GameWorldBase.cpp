@@ -16,6 +16,7 @@
 #include "figures/nofPassiveSoldier.h"
 #include "helpers/EnumRange.h"
 #include "helpers/containerUtils.h"
+#include "helpers/parallelFor.h"
 #include "lua/LuaInterfaceGame.h"
 #include "notifications/NodeNote.h"
 #include "notifications/PlayerNodeNote.h"
@@ -25,11 +26,13 @@
 #include "gameData/BuildingProperties.h"
 #include "gameData/GameConsts.h"
 #include "gameData/TerrainDesc.h"
+#include <algorithm>
 #include <utility>
 
 GameWorldBase::GameWorldBase(std::vector<GamePlayer> players, const GlobalGameSettings& gameSettings, EventManager& em)
     : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)), players(std::move(players)),
-      gameSettings(gameSettings), em(em), soundManager(std::make_unique<SoundManager>()), lua(nullptr), gi(nullptr)
+      gameSettings(gameSettings), em(em), soundManager(std::make_unique<SoundManager>()), lua(nullptr),
+      bqBatchDepth_(0), gi(nullptr)
 {}
 
 GameWorldBase::~GameWorldBase() = default;
@@ -39,12 +42,39 @@ void GameWorldBase::Init(const MapExtent& mapSize, DescIdx<LandscapeDesc> lt)
     RTTR_Assert(GetDescription().terrain.size() > 0); // Must have game data initialized
     World::Init(mapSize, lt);
     freePathFinder->Init(mapSize);
-}
-
-void GameWorldBase::InitAfterLoad()
-{
-    RTTR_FOREACH_PT(MapPoint, GetSize())
-        RecalcBQ(pt);
+    bqDirtyPts_.clear();
+    isBQDirty_.assign(prodOfComponents(mapSize), false);
+}
+
+void GameWorldBase::InitAfterLoad(unsigned numThreads)
+{
+    RTTR_Assert(bqBatchDepth_ == 0);
+    // The BQ of a node only depends on other data of the surrounding nodes, but not their BQ.
+    // So stripes of rows can be calculated independently and only the notifications need to be sent in order
+    constexpr unsigned stripeHeight = 8;
+    const unsigned numStripes = (GetSize().y + stripeHeight - 1) / stripeHeight;
+    std::vector<std::vector<MapPoint>> changedPts(numStripes);
+    const BQCalculator calcBQ(*this);
+    helpers::parallelFor(
+      numStripes,
+      [this, &calcBQ, &changedPts](unsigned stripe) {
+          const auto isOnRoad = [this](auto pt) { return this->IsOnRoad(pt); };
+          const unsigned endY = std::min<unsigned>((stripe + 1) * stripeHeight, GetSize().y);
+          for(unsigned y = stripe * stripeHeight; y < endY; y++)
+          {
+              for(MapPoint pt(0, y); pt.x < GetSize().x; pt.x++)
+              {
+                  if(SetBQ(pt, calcBQ(pt, isOnRoad)))
+                      changedPts[stripe].push_back(pt);
+              }
+          }
+      },
+      numThreads);
+    for(const auto& stripePts : changedPts)
+    {
+        for(const MapPoint pt : stripePts)
+            GetNotifications().publish(NodeNote(NodeNote::BQ, pt));
+    }
 }
 
 GamePlayer& GameWorldBase::GetPlayer(const unsigned id)
@@ -691,9 +721,47 @@ GameWorldBase::GetSoldiersForSeaAttack(const unsigned char player_attacker, cons
 
 void GameWorldBase::RecalcBQ(const MapPoint pt)
 {
+    if(bqBatchDepth_ > 0)
+    {
+        const unsigned idx = GetIdx(pt);
+        if(!isBQDirty_[idx])
+        {
+            isBQDirty_[idx] = true;
+            bqDirtyPts_.push_back(pt);
+        }
+        return;
+    }
     BQCalculator calcBQ(*this);
     if(SetBQ(pt, calcBQ(pt, [this](auto pt) { return this->IsOnRoad(pt); })))
     {
         GetNotifications().publish(NodeNote(NodeNote::BQ, pt));
     }
 }
+
+void GameWorldBase::RecalcDirtyBQs()
+{
+    BQCalculator calcBQ(*this);
+    const auto isOnRoad = [this](auto pt) { return this->IsOnRoad(pt); };
+    std::vector<MapPoint> changedPts;
+    for(const MapPoint pt : bqDirtyPts_)
+    {
+        isBQDirty_[GetIdx(pt)] = false;
+        if(SetBQ(pt, calcBQ(pt, isOnRoad)))
+            changedPts.push_back(pt);
+    }
+    bqDirtyPts_.clear();
+    for(const MapPoint pt : changedPts)
+        GetNotifications().publish(NodeNote(NodeNote::BQ, pt));
+}
+
+GameWorldBase::BQUpdateBatch::BQUpdateBatch(GameWorldBase& world) : world_(world)
+{
+    ++world_.bqBatchDepth_;
+}
+
+GameWorldBase::BQUpdateBatch::~BQUpdateBatch()
+{
+    RTTR_Assert(world_.bqBatchDepth_ > 0);
+    if(--world_.bqBatchDepth_ == 0)
+        world_.RecalcDirtyBQs();
+}
@@ -59,6 +59,11 @@ class GameWorldBase : public World
     EventManager& em;
     std::unique_ptr<SoundManager> soundManager;
     LuaInterfaceGame* lua;
+    /// Number of active BQUpdateBatch instances
+    unsigned bqBatchDepth_;
+    /// Nodes which need a BQ recalculation once the batch ends, without duplicates
+    std::vector<MapPoint> bqDirtyPts_;
+    std::vector<bool> isBQDirty_;
 
 protected:
     /// Interface zum GUI
@@ -74,8 +79,9 @@ public:
     void Init(const MapExtent& mapSize, DescIdx<LandscapeDesc> lt = DescIdx<LandscapeDesc>(0)) override;
     /// Create Trade graphs
     virtual void CreateTradeGraphs() = 0;
-    // Remaining initialization after loading (BQ...)
-    void InitAfterLoad();
+    /// Remaining initialization after loading (BQ...). Uses up to numThreads threads (0 = all cores) with the same
+    /// result as a serial calculation
+    void InitAfterLoad(unsigned numThreads = 0);
 
     /// Setzt GameInterface
     void SetGameInterface(GameInterface* const gi) { this->gi = gi; }
@@ -206,9 +212,23 @@ public:
     unsigned GetNumSoldiersForSeaAttackAtSea(unsigned char player_attacker, unsigned short seaid,
                                              bool returnCount = true) const;
 
-    /// Recalculates the BQ for the given point
+    /// Recalculates the BQ for the given point (deferred if a BQUpdateBatch is active)
     void RecalcBQ(MapPoint pt);
 
+    /// Defers all BQ recalculations until the outermost batch is destroyed.
+    /// Then every affected node is recalculated only once and the notifications are sent together.
+    /// The BQ must not be read while a batch is active.
+    class BQUpdateBatch
+    {
+        GameWorldBase& world_;
+
+    public:
+        explicit BQUpdateBatch(GameWorldBase& world);
+        ~BQUpdateBatch();
+        BQUpdateBatch(const BQUpdateBatch&) = delete;
+        BQUpdateBatch& operator=(const BQUpdateBatch&) = delete;
+    };
+
     bool HasLua() const { return lua != nullptr; }
     LuaInterfaceGame& GetLua() const { return *lua; }
     void SetLua(LuaInterfaceGame* newLua) { lua = newLua; }
@@ -220,6 +240,8 @@ protected:
     void AltitudeChanged(MapPoint pt) override;
 
 private:
+    /// Recalculate the BQ of all nodes marked during a batch and send the notifications
+    void RecalcDirtyBQs();
     /// Returns the harbor ID of the next matching harbor in the given direction (0 = None)
     /// T_IsHarborOk must be a predicate taking a harbor Id and returning a bool if the harbor is valid to return
     template<typename T_IsHarborOk>
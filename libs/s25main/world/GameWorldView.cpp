@@ -18,6 +18,7 @@
 #include "helpers/EnumArray.h"
 #include "helpers/containerUtils.h"
 #include "helpers/toString.h"
+#include "network/GameClient.h"
 #include "ogl/FontStyle.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "ogl/glFont.h"
@@ -115,6 +116,8 @@ struct ObjectBetweenLines
 
 void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool drawMouse, unsigned* water)
 {
+    // Draw the state of a single GF, even if the simulation runs in a separate thread
+    const auto worldLock = GAMECLIENT.LockWorld();
     SetNextZoomFactor();
 
     int shortestDistToMouse = 100000;
@@ -298,7 +298,7 @@ bool GameWorldViewer::IsRoadAvailable(bool isWaterRoad, const MapPoint& pt) cons
 /// Get the "youngest" FOWObject of all players who share the view with the local player
 const FOWObject* GameWorldViewer::GetYoungestFOWObject(const MapPoint pos) const
 {
-    return GetYoungestFOWNode(pos).object.get();
+    return GetYoungestFOWNode(pos).object;
 }
 
 /// Gets the youngest fow node of all visible objects of all players who are connected
@@ -10,9 +10,11 @@
 #include "PointOutput.h"
 #include "RttrForeachPt.h"
 #include "factories/BuildingFactory.h"
+#include "helpers/parallelFor.h"
 #include "lua/GameDataLoader.h"
 #include "pathfinding/PathConditionShip.h"
 #include "random/Random.h"
+#include "world/MapTemplate.h"
 #include "world/World.h"
 #include "nodeObjs/noAnimal.h"
 #include "nodeObjs/noEnvObject.h"
@@ -20,6 +22,7 @@
 #include "nodeObjs/noStaticObject.h"
 #include "nodeObjs/noTree.h"
 #include "gameTypes/ShipDirection.h"
+#include "gameData/LandscapeDesc.h"
 #include "gameData/MaxPlayers.h"
 #include "gameData/TerrainDesc.h"
 #include "libsiedler2/Archiv.h"
@@ -34,27 +37,41 @@
 
 class noBase;
 
+namespace {
+/// World used only for analysing a map when creating a template
+class TemplateWorld : public World
+{
+protected:
+    void AltitudeChanged(MapPoint) override {}
+    void VisibilityChanged(MapPoint, unsigned, Visibility, Visibility) override {}
+};
+
+Visibility getInitialVisibility(Exploration exploration)
+{
+    switch(exploration)
+    {
+        case Exploration::Disabled: return Visibility::Visible;
+        case Exploration::Classic:
+        case Exploration::FogOfWar: return Visibility::Invisible;
+        case Exploration::FogOfWarExplored: return Visibility::FogOfWar;
+    }
+    throw std::invalid_argument("Visibility for FoW");
+}
+} // namespace
+
 MapLoader::MapLoader(GameWorldBase& world) : world_(world) {}
 
 bool MapLoader::Load(const libsiedler2::ArchivItem_Map& map, Exploration exploration)
 {
-    GameDataLoader gdLoader(world_.GetDescriptionWriteable());
-    if(!gdLoader.Load())
+    const auto gameData = loadSharedGameData();
+    if(!gameData)
         return false;
+    world_.GetDescriptionWriteable() = *gameData;
 
-    uint8_t gfxSet = map.getHeader().getGfxSet();
-    DescIdx<LandscapeDesc> lt(0);
-    for(DescIdx<LandscapeDesc> i(0); i.value < world_.GetDescription().landscapes.size(); i.value++)
-    {
-        if(world_.GetDescription().get(i).s2Id == gfxSet)
-        {
-            lt = i;
-            break;
-        }
-    }
+    const DescIdx<LandscapeDesc> lt = getLandscapeFromS2(world_.GetDescription(), map.getHeader().getGfxSet());
     world_.Init(MapExtent(map.getHeader().getWidth(), map.getHeader().getHeight()), lt); //-V807
 
-    if(!InitNodes(map, exploration))
+    if(!InitNodes(world_, map, exploration))
         return false;
     PlaceObjects(map);
     PlaceAnimals(map);
@@ -92,6 +109,97 @@ bool MapLoader::Load(const boost::filesystem::path& mapFilePath)
     return true;
 }
 
+bool MapLoader::Load(const MapTemplate& mapTemplate, Exploration exploration)
+{
+    world_.GetDescriptionWriteable() = mapTemplate.description;
+    world_.Init(mapTemplate.size, mapTemplate.landscape);
+
+    // Bulk copy of the static node data, everything else is reset as in InitNodes
+    const Visibility fowVisibility = getInitialVisibility(exploration);
+    RTTR_FOREACH_PT(MapPoint, world_.GetSize())
+    {
+        MapNode& node = world_.GetNodeInt(pt);
+        const MapTemplate::Node& templateNode = mapTemplate.nodes[world_.GetIdx(pt)];
+
+        std::fill(node.roads.begin(), node.roads.end(), PointRoad::None);
+        node.altitude = templateNode.altitude;
+        node.shadow = templateNode.shadow;
+        node.t1 = templateNode.t1;
+        node.t2 = templateNode.t2;
+        node.resources = templateNode.resources;
+        node.reserved = false;
+        node.owner = 0;
+        std::fill(node.boundary_stones.begin(), node.boundary_stones.end(), 0);
+        node.seaId = templateNode.seaId;
+        node.harborId = templateNode.harborId;
+        for(auto& fow : node.fow)
+        {
+            fow = FoWNode();
+            fow.visibility = fowVisibility;
+        }
+        RTTR_Assert(node.figures.empty());
+    }
+    world_.seas.assign(mapTemplate.seaSizes.begin(), mapTemplate.seaSizes.end());
+    world_.harbor_pos = mapTemplate.harborPositions;
+
+    const libsiedler2::ArchivItem_Map& map = mapTemplate.getMap();
+    PlaceObjects(map);
+    PlaceAnimals(map);
+
+    if(exploration == Exploration::FogOfWarExplored)
+        SetMapExplored(world_);
+
+    return true;
+}
+
+bool MapLoader::Load(const MapTemplate& mapTemplate)
+{
+    if(!Load(mapTemplate, world_.GetGGS().exploration))
+        return false;
+    if(!PlaceHQs(world_.GetGGS().randomStartPosition))
+        return false;
+
+    world_.CreateTradeGraphs();
+
+    return true;
+}
+
+std::shared_ptr<const MapTemplate> MapLoader::CreateTemplate(const boost::filesystem::path& mapFilePath)
+{
+    auto result = std::make_shared<MapTemplate>();
+    result->mapArchive = std::make_unique<libsiedler2::Archiv>();
+    if(libsiedler2::loader::LoadMAP(mapFilePath, *result->mapArchive) != 0)
+        return nullptr;
+    const libsiedler2::ArchivItem_Map& map = result->getMap();
+
+    TemplateWorld world;
+    const auto gameData = loadSharedGameData();
+    if(!gameData)
+        return nullptr;
+    world.GetDescriptionWriteable() = *gameData;
+    result->description = world.GetDescription();
+    result->size = MapExtent(map.getHeader().getWidth(), map.getHeader().getHeight());
+    result->landscape = getLandscapeFromS2(world.GetDescription(), map.getHeader().getGfxSet());
+    world.Init(result->size, result->landscape);
+
+    // Same steps as for loading a map, except everything related to objects
+    if(!InitNodes(world, map, Exploration::Disabled) || !InitSeasAndHarbors(world))
+        return nullptr;
+    InitShadows(world);
+
+    result->nodes.reserve(world.nodes.size());
+    for(const MapNode& node : world.nodes)
+    {
+        result->nodes.push_back(
+          MapTemplate::Node{node.altitude, node.shadow, node.t1, node.t2, node.resources, node.seaId, node.harborId});
+    }
+    for(const World::Sea& sea : world.seas)
+        result->seaSizes.push_back(sea.nodes_count);
+    result->harborPositions = world.harbor_pos;
+
+    return result;
+}
+
 bool MapLoader::LoadLuaScript(Game& game, ILocalGameState& localgameState, const boost::filesystem::path& luaFilePath)
 {
     if(!bfs::exists(luaFilePath))
@@ -110,8 +218,11 @@ bool MapLoader::PlaceHQs(bool randomStartPos)
 
 void MapLoader::InitShadows(World& world)
 {
-    RTTR_FOREACH_PT(MapPoint, world.GetSize())
-        world.RecalcShadow(pt);
+    // Shadows only depend on the altitudes, so rows can be processed independently
+    helpers::parallelFor(world.GetSize().y, [&world](unsigned y) {
+        for(MapPoint pt(0, y); pt.x < world.GetSize().x; pt.x++)
+            world.RecalcShadow(pt);
+    });
 }
 
 void MapLoader::SetMapExplored(World& world)
@@ -128,25 +239,36 @@ void MapLoader::SetMapExplored(World& world)
     }
 }
 
-DescIdx<TerrainDesc> MapLoader::getTerrainFromS2(uint8_t s2Id) const
+DescIdx<LandscapeDesc> MapLoader::getLandscapeFromS2(const WorldDescription& desc, uint8_t gfxSet)
 {
-    const WorldDescription& desc = world_.GetDescription();
+    for(DescIdx<LandscapeDesc> i(0); i.value < desc.landscapes.size(); i.value++)
+    {
+        if(desc.get(i).s2Id == gfxSet)
+            return i;
+    }
+    return DescIdx<LandscapeDesc>(0);
+}
+
+DescIdx<TerrainDesc> MapLoader::getTerrainFromS2(const World& world, uint8_t s2Id)
+{
+    const WorldDescription& desc = world.GetDescription();
     for(DescIdx<TerrainDesc> tId(0); tId.value < desc.terrain.size(); tId.value++)
     {
         const TerrainDesc& t = desc.get(tId);
-        if(t.s2Id == s2Id && t.landscape == world_.GetLandscapeType())
+        if(t.s2Id == s2Id && t.landscape == world.GetLandscapeType())
             return tId;
     }
     return DescIdx<TerrainDesc>();
 }
 
-bool MapLoader::InitNodes(const libsiedler2::ArchivItem_Map& map, Exploration exploration)
+bool MapLoader::InitNodes(World& world, const libsiedler2::ArchivItem_Map& map, Exploration exploration)
 {
     using libsiedler2::MapLayer;
+    const Visibility fowVisibility = getInitialVisibility(exploration);
     // Init node data (everything except the objects, figures and BQ)
-    RTTR_FOREACH_PT(MapPoint, world_.GetSize())
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
     {
-        MapNode& node = world_.GetNodeInt(pt);
+        MapNode& node = world.GetNodeInt(pt);
 
         std::fill(node.roads.begin(), node.roads.end(), PointRoad::None);
         node.altitude = map.getMapDataAt(MapLayer::Altitude, pt.x, pt.y);
@@ -155,13 +277,13 @@ bool MapLoader::InitNodes(const libsiedler2::ArchivItem_Map& map, Exploration ex
 
         // Hafenplatz?
         if((t1 & libsiedler2::HARBOR_MASK) != 0)
-            world_.harbor_pos.push_back(HarborPos(pt));
+            world.harbor_pos.push_back(HarborPos(pt));
 
         // Will be set later
         node.harborId = 0;
 
-        node.t1 = getTerrainFromS2(t1 & 0x3F); // Only lower 6 bits
-        node.t2 = getTerrainFromS2(t2 & 0x3F); // Only lower 6 bits
+        node.t1 = getTerrainFromS2(world, t1 & 0x3F); // Only lower 6 bits
+        node.t2 = getTerrainFromS2(world, t2 & 0x3F); // Only lower 6 bits
         if(!node.t1 || !node.t2)
             return false;
 
@@ -187,16 +309,6 @@ bool MapLoader::InitNodes(const libsiedler2::ArchivItem_Map& map, Exploration ex
         std::fill(node.boundary_stones.begin(), node.boundary_stones.end(), 0);
         node.seaId = 0;
 
-        Visibility fowVisibility;
-        switch(exploration)
-        {
-            case Exploration::Disabled: fowVisibility = Visibility::Visible; break;
-            case Exploration::Classic:
-            case Exploration::FogOfWar: fowVisibility = Visibility::Invisible; break;
-            case Exploration::FogOfWarExplored: fowVisibility = Visibility::FogOfWar; break;
-            default: throw std::invalid_argument("Visibility for FoW");
-        }
-
         // FOW-Zeug initialisieren
         for(auto& fow : node.fow)
         {
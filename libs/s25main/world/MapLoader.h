@@ -8,13 +8,17 @@
 #include "gameTypes/MapCoordinates.h"
 #include "gameData/DescIdx.h"
 #include <boost/filesystem/path.hpp>
+#include <memory>
 #include <vector>
 
 class Game;
 class GameWorldBase;
 class ILocalGameState;
+class MapTemplate;
 class World;
+struct LandscapeDesc;
 struct TerrainDesc;
+struct WorldDescription;
 
 namespace libsiedler2 {
 class ArchivItem_Map;
@@ -25,9 +29,10 @@ class MapLoader
     GameWorldBase& world_;
     std::vector<MapPoint> hqPositions_;
 
-    DescIdx<TerrainDesc> getTerrainFromS2(uint8_t s2Id) const;
+    static DescIdx<LandscapeDesc> getLandscapeFromS2(const WorldDescription& desc, uint8_t gfxSet);
+    static DescIdx<TerrainDesc> getTerrainFromS2(const World& world, uint8_t s2Id);
     /// Initialize the nodes according to the map data
-    bool InitNodes(const libsiedler2::ArchivItem_Map& map, Exploration exploration);
+    static bool InitNodes(World& world, const libsiedler2::ArchivItem_Map& map, Exploration exploration);
     /// Place all objects on the nodes according to the map data.
     void PlaceObjects(const libsiedler2::ArchivItem_Map& map);
     void PlaceAnimals(const libsiedler2::ArchivItem_Map& map);
@@ -44,6 +49,14 @@ public:
     bool Load(const libsiedler2::ArchivItem_Map& map, Exploration exploration);
     /// Load the map from the given filepath
     bool Load(const boost::filesystem::path& mapFilePath);
+    /// Load the map from a template, resetting previous state. Same result as loading the map the template was created
+    /// from but without parsing and analysing the map again. Return false on error
+    bool Load(const MapTemplate& mapTemplate, Exploration exploration);
+    /// Load the map from a template and place the HQs. Equivalent to loading from the file
+    bool Load(const MapTemplate& mapTemplate);
+    /// Parse and analyse the map at the given filepath so it can be loaded into multiple worlds.
+    /// Return nullptr on error
+    static std::shared_ptr<const MapTemplate> CreateTemplate(const boost::filesystem::path& mapFilePath);
     bool LoadLuaScript(Game& game, ILocalGameState& localgameState, const boost::filesystem::path& luaFilePath);
     /// Place the HQs on a loaded map (must be loaded first as hqPositions etc. are used)
     bool PlaceHQs(bool randomStartPos);
@@ -74,6 +74,7 @@ void MapSerializer::Serialize(const GameWorldBase& world, SerializedGameData& sg
         sgd.PushUnsignedInt(luaSaveState.GetLength());
         sgd.PushRawData(luaSaveState.GetData(), luaSaveState.GetLength());
         sgd.PushUnsignedInt(0xC001C0DE); // End Lua identifier
+        world.GetLua().SerializeEventState(sgd);
     }
 }
 
@@ -81,9 +82,10 @@ void MapSerializer::Deserialize(GameWorldBase& world, SerializedGameData& sgd, G
                                 ILocalGameState& localgameState)
 {
     // Initialisierungen
-    GameDataLoader gdLoader(world.GetDescriptionWriteable());
-    if(!gdLoader.Load())
+    const auto gameData = loadSharedGameData();
+    if(!gameData)
         throw SerializedGameData::Error(_("Failed to load game data!"));
+    world.GetDescriptionWriteable() = *gameData;
 
     // Headinformationen
     const auto size = helpers::popPoint<MapExtent>(sgd);
@@ -193,6 +195,8 @@ void MapSerializer::Deserialize(GameWorldBase& world, SerializedGameData& sgd, G
             throw SerializedGameData::Error(_("Lua script failed to load."));
         if(!lua->CheckScriptVersion())
             throw SerializedGameData::Error(_("Wrong version for lua script."));
+        if(sgd.GetGameDataVersion() >= 10)
+            lua->DeserializeEventState(sgd);
         try
         {
             if(!lua->Deserialize(luaSaveState))
@@ -0,0 +1,16 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "world/MapTemplate.h"
+#include "libsiedler2/Archiv.h"
+#include "libsiedler2/ArchivItem_Map.h"
+
+MapTemplate::MapTemplate() : size(0, 0) {}
+
+MapTemplate::~MapTemplate() = default;
+
+const libsiedler2::ArchivItem_Map& MapTemplate::getMap() const
+{
+    return *static_cast<const libsiedler2::ArchivItem_Map*>((*mapArchive)[0]);
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/HarborPos.h"
+#include "gameTypes/MapCoordinates.h"
+#include "gameTypes/Resource.h"
+#include "gameData/DescIdx.h"
+#include "gameData/WorldDescription.h"
+#include <memory>
+#include <vector>
+
+struct LandscapeDesc;
+struct TerrainDesc;
+
+namespace libsiedler2 {
+class Archiv;
+class ArchivItem_Map;
+} // namespace libsiedler2
+
+/// A map that has been parsed and analysed once and can be loaded into any number of worlds (see MapLoader).
+/// Holds everything that only depends on the map file: Terrain, altitude, resources, shadows, seas and harbors.
+/// Objects and animals are not included as they are owned by the game and get created from the map data on load.
+/// Immutable after creation, so it can be shared between worlds (also in different threads).
+class MapTemplate
+{
+public:
+    struct Node
+    {
+        unsigned char altitude;
+        unsigned char shadow;
+        DescIdx<TerrainDesc> t1, t2;
+        Resource resources;
+        unsigned short seaId;
+        unsigned harborId;
+    };
+
+    MapTemplate();
+    ~MapTemplate();
+
+    WorldDescription description;
+    MapExtent size;
+    DescIdx<LandscapeDesc> landscape;
+    /// Node data in the same order as the nodes of the world
+    std::vector<Node> nodes;
+    /// Number of nodes per sea
+    std::vector<unsigned> seaSizes;
+    /// Harbor positions including the dummy harbor 0
+    std::vector<HarborPos> harborPositions;
+    /// Archive containing the map, used for placing objects and animals
+    std::unique_ptr<libsiedler2::Archiv> mapArchive;
+
+    const libsiedler2::ArchivItem_Map& getMap() const;
+};
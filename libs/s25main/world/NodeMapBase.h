@@ -6,6 +6,7 @@
 
 #include "MapBase.h"
 #include "gameTypes/MapCoordinates.h"
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -33,6 +34,44 @@ public:
     const_iterator end() const noexcept { return nodes.end(); }
 };
 
+/// Set of map points stored as a flat bitmap over all nodes of a map together with the points in insertion order.
+/// Insertion and lookup are O(1) which makes it much cheaper than a tree set for visited sets and regions.
+class NodeSet
+{
+    NodeMapBase<uint8_t> contained_;
+    std::vector<MapPoint> points_;
+
+public:
+    using const_iterator = std::vector<MapPoint>::const_iterator;
+
+    explicit NodeSet(const MapExtent& size) { contained_.Resize(size, 0); }
+
+    bool contains(const MapPoint& pt) const { return contained_[pt] != 0; }
+    /// Add the point to the set. Return true if it was not contained before
+    bool insert(const MapPoint& pt)
+    {
+        uint8_t& contained = contained_[pt];
+        if(contained)
+            return false;
+        contained = 1;
+        points_.push_back(pt);
+        return true;
+    }
+    template<class T_Container>
+    void insert(const T_Container& points)
+    {
+        for(const MapPoint& pt : points)
+            insert(pt);
+    }
+
+    bool empty() const noexcept { return points_.empty(); }
+    size_t size() const noexcept { return points_.size(); }
+    /// Points in insertion order
+    const std::vector<MapPoint>& points() const noexcept { return points_; }
+    const_iterator begin() const noexcept { return points_.begin(); }
+    const_iterator end() const noexcept { return points_.end(); }
+};
+
 //////////////////////////////////////////////////////////////////////////
 // Implementation
 
@@ -94,9 +94,9 @@ noBase& World::AddFigureImpl(const MapPoint pt, std::unique_ptr<noBase> fig)
 
     auto& figures = GetNodeInt(pt).figures;
 #if RTTR_ENABLE_ASSERTS
-    RTTR_Assert(!helpers::containsPtr(figures, fig.get()));
+    RTTR_Assert(!figures.contains(*fig));
     for(const MapPoint nb : GetNeighbours(pt))
-        RTTR_Assert(!helpers::containsPtr(GetNode(nb).figures, fig.get())); // Added figure that is in surrounding?
+        RTTR_Assert(!GetNode(nb).figures.contains(*fig)); // Added figure that is in surrounding?
 #endif
 
     noBase& result = *fig;
@@ -106,7 +106,11 @@ noBase& World::AddFigureImpl(const MapPoint pt, std::unique_ptr<noBase> fig)
 
 noBase* World::RemoveFigureImpl(const MapPoint pt, noBase& fig)
 {
-    return helpers::extractPtr(GetNodeInt(pt).figures, &fig).release();
+    FigureList& figures = GetNodeInt(pt).figures;
+    // O(1) as the figure knows the list it is in
+    if(!figures.contains(fig))
+        return nullptr;
+    return figures.remove(fig).release();
 }
 
 noBase* World::GetNO(const MapPoint pt)
@@ -180,7 +184,7 @@ void World::SetVisibility(const MapPoint pt, unsigned char player, Visibility vi
 
     node.visibility = vis;
     if(vis == Visibility::Visible)
-        node.object.reset();
+        node.object = nullptr;
     else if(vis == Visibility::FogOfWar)
         SaveFOWNode(pt, player, fowTime);
     VisibilityChanged(pt, player, oldVis, vis);
@@ -241,7 +245,7 @@ BuildingQuality World::AdjustBQ(const MapPoint pt, unsigned char player, Buildin
 
 bool World::HasFigureAt(const MapPoint pt, const noBase& figure) const
 {
-    return helpers::containsPtr(GetNode(pt).figures, &figure);
+    return GetNode(pt).figures.contains(figure);
 }
 
 WalkTerrain World::GetTerrain(MapPoint pt, Direction dir) const
@@ -492,7 +496,7 @@ void World::MakeWholeMapVisibleForAllPlayers()
         for(auto& fowNode : mapNode.fow)
         {
             fowNode.visibility = Visibility::Visible;
-            fowNode.object.reset();
+            fowNode.object = nullptr;
         }
     }
 }
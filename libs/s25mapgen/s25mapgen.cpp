@@ -0,0 +1,217 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "RttrConfig.h"
+#include "helpers/parallelFor.h"
+#include "lua/GameDataLoader.h"
+#include "mapGenerator/MapStatistics.h"
+#include "mapGenerator/RandomMap.h"
+#include "gameData/WorldDescription.h"
+#include "libsiedler2/libsiedler2.h"
+#include <boost/filesystem.hpp>
+#include <boost/nowide/args.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/nowide/iostream.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bfs = boost::filesystem;
+namespace bnw = boost::nowide;
+namespace po = boost::program_options;
+using namespace rttr::mapGenerator;
+
+namespace {
+struct MapResult
+{
+    uint64_t seed;
+    std::string error;
+    MapStatistics stats;
+    double generationTime;
+};
+
+MapStyle parseStyle(const std::string& style)
+{
+    if(style == "water")
+        return MapStyle::Water;
+    if(style == "land")
+        return MapStyle::Land;
+    if(style == "mixed")
+        return MapStyle::Mixed;
+    throw std::invalid_argument("Invalid map style: " + style);
+}
+
+IslandAmount parseIslands(unsigned islands)
+{
+    for(const auto amount : {IslandAmount::Few, IslandAmount::Normal, IslandAmount::Many})
+    {
+        if(islands == static_cast<unsigned>(amount))
+            return amount;
+    }
+    throw std::invalid_argument("Invalid island amount: " + std::to_string(islands));
+}
+
+MountainDistance parseMountainDistance(unsigned distance)
+{
+    for(const auto value :
+        {MountainDistance::Close, MountainDistance::Normal, MountainDistance::Far, MountainDistance::VeryFar})
+    {
+        if(distance == static_cast<unsigned>(value))
+            return value;
+    }
+    throw std::invalid_argument("Invalid mountain distance: " + std::to_string(distance));
+}
+
+MapResult generateMap(const WorldDescription& worldDesc, MapSettings settings, uint64_t seed,
+                      const bfs::path& outputFolder, const std::string& extension)
+{
+    MapResult result;
+    result.seed = seed;
+    const auto startTime = std::chrono::steady_clock::now();
+    try
+    {
+        settings.name = "Random " + std::to_string(seed);
+        RandomUtility rnd(seed);
+        const Map map = GenerateRandomMap(rnd, worldDesc, settings);
+        result.generationTime =
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        result.stats = GetMapStatistics(map);
+        const bfs::path filePath = outputFolder / ("map_" + std::to_string(seed) + extension);
+        if(libsiedler2::Write(filePath, map.CreateArchiv()) != 0)
+            result.error = "Failed to write " + filePath.string();
+    } catch(const std::exception& e)
+    {
+        result.generationTime =
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        result.error = e.what();
+    }
+    return result;
+}
+
+void writeStatistics(std::ostream& out, const std::vector<MapResult>& results)
+{
+    out << "seed,status,time_ms,land_nodes,water_nodes,land_ratio,harbors,min_hq_distance,max_hq_distance,"
+           "min_reachable,reachable_per_player\n";
+    for(const MapResult& result : results)
+    {
+        out << result.seed << ',' << (result.error.empty() ? "ok" : "failed") << ',' << result.generationTime;
+        if(!result.error.empty())
+        {
+            out << ",,,,,,,,\n";
+            continue;
+        }
+        const MapStatistics& stats = result.stats;
+        const auto minReachable = stats.reachableNodes.empty() ?
+                                    0u :
+                                    *std::min_element(stats.reachableNodes.begin(), stats.reachableNodes.end());
+        out << ',' << stats.numLandNodes << ',' << stats.numWaterNodes << ',' << stats.GetLandRatio() << ','
+            << stats.numHarbors << ',' << stats.minHqDistance << ',' << stats.maxHqDistance << ',' << minReachable
+            << ',';
+        for(unsigned i = 0; i < stats.reachableNodes.size(); i++)
+            out << (i ? " " : "") << stats.reachableNodes[i];
+        out << '\n';
+    }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bnw::args _(argc, argv);
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help,h", "Show help")
+        ("output,o", po::value<std::string>()->default_value("."), "Folder to write the maps to")
+        ("seed,s", po::value<uint64_t>()->default_value(0), "Seed of the first map")
+        ("count,n", po::value<unsigned>()->default_value(1), "Number of maps to generate (using consecutive seeds)")
+        ("width", po::value<unsigned>()->default_value(128), "Width of the maps")
+        ("height", po::value<unsigned>()->default_value(128), "Height of the maps")
+        ("players,p", po::value<unsigned>()->default_value(2), "Number of players")
+        ("style", po::value<std::string>()->default_value("mixed"), "Map style: water, land or mixed")
+        ("landscape", po::value<unsigned>()->default_value(0), "Index of the landscape (0 = greenland)")
+        ("islands", po::value<unsigned>()->default_value(0), "Island amount: 0 (few), 10 (normal) or 30 (many)")
+        ("mountain-distance", po::value<unsigned>()->default_value(15), "Mountain distance: 5, 15, 25 or 30")
+        ("wld", "Save maps as .wld instead of .swd")
+        ("threads,j", po::value<unsigned>()->default_value(0), "Number of threads to use (0 = all cores)")
+        ("stats", po::value<std::string>(), "File to write the statistics to (CSV) instead of stdout")
+        ;
+    // clang-format on
+
+    po::variables_map options;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv).options(desc).run(), options);
+        po::notify(options);
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << "Error: " << e.what() << "\n\n";
+        bnw::cerr << desc << "\n";
+        return 1;
+    }
+
+    if(options.count("help"))
+    {
+        bnw::cout << desc << "\n";
+        return 0;
+    }
+
+    try
+    {
+        if(!RTTRCONFIG.Init())
+            return 1;
+
+        WorldDescription worldDesc;
+        loadGameData(worldDesc);
+
+        MapSettings settings;
+        settings.size = MapExtent(options["width"].as<unsigned>(), options["height"].as<unsigned>());
+        settings.numPlayers = options["players"].as<unsigned>();
+        settings.style = parseStyle(options["style"].as<std::string>());
+        settings.islands = parseIslands(options["islands"].as<unsigned>());
+        settings.mountainDistance = parseMountainDistance(options["mountain-distance"].as<unsigned>());
+        settings.type = DescIdx<LandscapeDesc>(options["landscape"].as<unsigned>());
+        if(settings.type.value >= worldDesc.landscapes.size())
+            throw std::invalid_argument("Invalid landscape index");
+        settings.MakeValid();
+
+        const bfs::path outputFolder = options["output"].as<std::string>();
+        bfs::create_directories(outputFolder);
+        const std::string extension = options.count("wld") ? ".wld" : ".swd";
+        const uint64_t firstSeed = options["seed"].as<uint64_t>();
+
+        // Each map uses its own RNG seeded from its index, so results do not depend on the thread count
+        std::vector<MapResult> results(options["count"].as<unsigned>());
+        helpers::parallelFor(
+          static_cast<unsigned>(results.size()),
+          [&](unsigned i) { results[i] = generateMap(worldDesc, settings, firstSeed + i, outputFolder, extension); },
+          options["threads"].as<unsigned>());
+
+        if(options.count("stats"))
+        {
+            bnw::ofstream statsFile(options["stats"].as<std::string>());
+            writeStatistics(statsFile, results);
+        } else
+            writeStatistics(bnw::cout, results);
+
+        unsigned numFailed = 0;
+        for(const MapResult& result : results)
+        {
+            if(!result.error.empty())
+            {
+                bnw::cerr << "Map with seed " << result.seed << " failed: " << result.error << "\n";
+                numFailed++;
+            }
+        }
+        return numFailed == 0 ? 0 : 2;
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
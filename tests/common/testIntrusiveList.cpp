@@ -0,0 +1,85 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/IntrusiveList.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace {
+struct Element : helpers::IntrusiveListHook<Element>
+{
+    int value;
+};
+using ElementList = helpers::IntrusiveList<Element>;
+
+std::vector<int> getValues(const ElementList& list)
+{
+    std::vector<int> result;
+    for(const Element* el : list)
+        result.push_back(el->value);
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(IntrusiveListSuite)
+
+BOOST_AUTO_TEST_CASE(AddRemoveKeepsOrder)
+{
+    std::vector<Element> elements(5);
+    for(unsigned i = 0; i < elements.size(); i++)
+        elements[i].value = i;
+
+    ElementList list;
+    BOOST_TEST(list.empty());
+    for(Element& el : elements)
+        list.push_back(&el);
+    BOOST_TEST(list.size() == 5u);
+    BOOST_TEST(getValues(list) == std::vector<int>({0, 1, 2, 3, 4}), boost::test_tools::per_element());
+    for(const Element& el : elements)
+        BOOST_TEST(list.contains(&el));
+
+    list.remove(&elements[2]);
+    list.remove(&elements[0]);
+    list.remove(&elements[4]);
+    BOOST_TEST(!list.contains(&elements[2]));
+    BOOST_TEST(getValues(list) == std::vector<int>({1, 3}), boost::test_tools::per_element());
+    // Removing an element that is not contained is a no-op
+    list.remove(&elements[2]);
+    ElementList otherList;
+    otherList.push_back(&elements[2]);
+    list.remove(&elements[2]);
+    BOOST_TEST(otherList.contains(&elements[2]));
+    BOOST_TEST(list.size() == 2u);
+
+    // Re-adding appends
+    list.push_back(&elements[0]);
+    BOOST_TEST(getValues(list) == std::vector<int>({1, 3, 0}), boost::test_tools::per_element());
+
+    // Erase while iterating
+    for(auto it = list.begin(); it != list.end();)
+    {
+        if((*it)->value == 3)
+            it = list.erase(it);
+        else
+            ++it;
+    }
+    BOOST_TEST(getValues(list) == std::vector<int>({1, 0}), boost::test_tools::per_element());
+
+    // Moving updates the ownership of the elements
+    ElementList movedList(std::move(list));
+    BOOST_TEST(list.empty()); //-V1001
+    BOOST_TEST(movedList.contains(&elements[1]));
+    BOOST_TEST(!list.contains(&elements[1])); //-V1001
+    BOOST_TEST(getValues(movedList) == std::vector<int>({1, 0}), boost::test_tools::per_element());
+
+    movedList.clear();
+    BOOST_TEST(movedList.empty());
+    BOOST_TEST(movedList.size() == 0u);
+    BOOST_TEST(!movedList.contains(&elements[1]));
+    // Can be added to another list now
+    list.push_back(&elements[1]);
+    BOOST_TEST(list.contains(&elements[1]));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
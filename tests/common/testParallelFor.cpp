@@ -0,0 +1,43 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/parallelFor.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ParallelFor)
+
+BOOST_AUTO_TEST_CASE(ProcessesEachItemOnce)
+{
+    for(unsigned numThreads : {0u, 1u, 2u, 7u})
+    {
+        std::vector<unsigned> counts(1000);
+        helpers::parallelFor(
+          static_cast<unsigned>(counts.size()), [&counts](unsigned i) { counts[i]++; }, numThreads);
+        BOOST_TEST(std::count(counts.begin(), counts.end(), 1u) == static_cast<long>(counts.size()));
+    }
+    // No items -> Nothing to do
+    helpers::parallelFor(0, [](unsigned) { BOOST_FAIL("Should not be called"); });
+}
+
+BOOST_AUTO_TEST_CASE(RethrowsLowestException)
+{
+    const auto func = [](unsigned i) {
+        if(i == 5 || i == 50)
+            throw std::runtime_error(std::to_string(i));
+    };
+    try
+    {
+        helpers::parallelFor(100, func, 4);
+        BOOST_FAIL("No exception thrown");
+    } catch(const std::runtime_error& e)
+    {
+        BOOST_TEST(e.what() == std::string("5"));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
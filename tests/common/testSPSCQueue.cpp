@@ -0,0 +1,66 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/SPSCQueue.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(SPSCQueueSuite)
+
+BOOST_AUTO_TEST_CASE(PushPopInOrder)
+{
+    helpers::SPSCQueue<std::unique_ptr<int>> queue(3);
+    BOOST_TEST(queue.capacity() == 4u);
+    BOOST_TEST(queue.empty());
+    std::unique_ptr<int> item;
+    BOOST_TEST(!queue.pop(item));
+
+    for(int i = 0; i < 4; i++)
+        BOOST_TEST(queue.push(std::make_unique<int>(i)));
+    BOOST_TEST(queue.full());
+    // Full queue leaves the item untouched
+    auto extra = std::make_unique<int>(42);
+    BOOST_TEST(!queue.push(std::move(extra)));
+    BOOST_TEST_REQUIRE(!!extra);
+
+    BOOST_TEST_REQUIRE(queue.pop(item));
+    BOOST_TEST(*item == 0);
+    BOOST_TEST(queue.push(std::move(extra)));
+    for(int expected : {1, 2, 3, 42})
+    {
+        BOOST_TEST_REQUIRE(queue.pop(item));
+        BOOST_TEST(*item == expected);
+    }
+    BOOST_TEST(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(TransfersBetweenThreads)
+{
+    constexpr unsigned numItems = 100000;
+    helpers::SPSCQueue<unsigned> queue(64);
+    std::thread producer([&queue]() {
+        for(unsigned i = 0; i < numItems; i++)
+        {
+            unsigned item = i;
+            while(!queue.push(std::move(item)))
+                std::this_thread::yield();
+        }
+    });
+    unsigned numReceived = 0;
+    bool inOrder = true;
+    while(numReceived < numItems)
+    {
+        unsigned item;
+        if(queue.pop(item))
+            inOrder &= item == numReceived++;
+        else
+            std::this_thread::yield();
+    }
+    producer.join();
+    BOOST_TEST(inOrder);
+    BOOST_TEST(queue.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
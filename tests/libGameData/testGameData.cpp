@@ -15,6 +15,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/nowide/fstream.hpp>
 #include <boost/test/unit_test.hpp>
+#include <ctime>
 #include <sstream>
 
 namespace bfs = boost::filesystem;
@@ -238,4 +239,66 @@ BOOST_AUTO_TEST_CASE(TextureCoords)
     BOOST_TEST_REQUIRE(usdR.right == usdS.left);
 }
 
+BOOST_AUTO_TEST_CASE(SharedGameDataIsCachedUntilScriptsChange)
+{
+    rttr::test::TmpFolder tmp;
+    const auto writeScripts = [&tmp](const std::string& landscapeName) {
+        bnw::ofstream(tmp.get() / "default.lua") << "include(\"landscape.lua\")";
+        bnw::ofstream(tmp.get() / "landscape.lua") << "rttr:AddLandscape{\
+            name = \"" << landscapeName << "\",\
+            mapGfx = \"<RTTR_GAME>/DATA/MAP_0_Z.LST\",\
+            roads = {\
+                normal = { texture = \"<RTTR_GAME>/foo\"},\
+                upgraded = { texture = \"<RTTR_GAME>/foo\"},\
+                boat = { texture = \"<RTTR_GAME>/foo\"},\
+                mountain = { texture = \"<RTTR_GAME>/foo\"}\
+            }}";
+    };
+    writeScripts("land1");
+    const auto desc1 = loadSharedGameData(tmp.get());
+    BOOST_TEST_REQUIRE(desc1);
+    BOOST_TEST(desc1->landscapes.tryGet("land1"));
+    // Unchanged scripts reuse the loaded data
+    BOOST_TEST(loadSharedGameData(tmp.get()) == desc1);
+    // Changing an included file reloads
+    writeScripts("land2");
+    const auto desc2 = loadSharedGameData(tmp.get());
+    BOOST_TEST_REQUIRE(desc2);
+    BOOST_TEST(desc2 != desc1);
+    BOOST_TEST(!desc2->landscapes.tryGet("land1"));
+    BOOST_TEST(desc2->landscapes.tryGet("land2"));
+    // Errors are not cached
+    bnw::ofstream(tmp.get() / "landscape.lua") << "rttr:AddLandscape{}";
+    rttr::test::LogAccessor logAcc;
+    BOOST_TEST(!loadSharedGameData(tmp.get()));
+    RTTR_REQUIRE_LOG_CONTAINS("Failed to load game data", false);
+    writeScripts("land2");
+    BOOST_TEST(loadSharedGameData(tmp.get()) == desc2);
+
+    // Files with unchanged size and modification time are not read again
+    const std::time_t oldTime = std::time(nullptr) - 100;
+    bfs::last_write_time(tmp.get() / "default.lua", oldTime);
+    bfs::last_write_time(tmp.get() / "landscape.lua", oldTime);
+    BOOST_TEST(loadSharedGameData(tmp.get()) == desc2);
+    writeScripts("land3");
+    bfs::last_write_time(tmp.get() / "default.lua", oldTime);
+    bfs::last_write_time(tmp.get() / "landscape.lua", oldTime);
+    BOOST_TEST(loadSharedGameData(tmp.get()) == desc2);
+    // But a changed modification time triggers the check
+    bfs::last_write_time(tmp.get() / "landscape.lua", oldTime + 1);
+    const auto desc3 = loadSharedGameData(tmp.get());
+    BOOST_TEST_REQUIRE(desc3);
+    BOOST_TEST(desc3->landscapes.tryGet("land3"));
+}
+
+BOOST_AUTO_TEST_CASE(DescriptionsCanBeFoundByName)
+{
+    WorldDescription worldDesc;
+    loadGameData(worldDesc);
+    for(DescIdx<TerrainDesc> i(0); i.value < worldDesc.terrain.size(); i.value++)
+        BOOST_TEST((worldDesc.terrain.getIndex(worldDesc.get(i).name) == i));
+    BOOST_TEST(!worldDesc.terrain.getIndex("doesNotExist"));
+    BOOST_TEST(!worldDesc.terrain.getIndex(""));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "MapCatalog.h"
+#include "testConfig.h"
+#include "rttr/test/TmpFolder.hpp"
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace bfs = boost::filesystem;
+namespace bnw = boost::nowide;
+
+namespace {
+/// Wait for the scan to finish and return all entries found
+std::vector<MapCatalog::Entry> getScannedEntries(MapCatalog& catalog)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    std::vector<MapCatalog::Entry> result;
+    bool finished;
+    do
+    {
+        finished = !catalog.isScanning();
+        for(MapCatalog::Entry& entry : catalog.fetchEntries())
+            result.push_back(std::move(entry));
+        if(std::chrono::steady_clock::now() > timeout)
+            break; // LCOV_EXCL_LINE
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } while(!finished);
+    BOOST_TEST_REQUIRE(finished);
+    std::sort(result.begin(), result.end(),
+              [](const MapCatalog::Entry& lhs, const MapCatalog::Entry& rhs) { return lhs.filePath < rhs.filePath; });
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(MapCatalogSuite)
+
+BOOST_AUTO_TEST_CASE(ScansAndCachesMapHeaders)
+{
+    rttr::test::TmpFolder tmp;
+    const bfs::path mapFolder = tmp.get() / "maps";
+    const bfs::path catalogPath = tmp.get() / "cache" / "mapCatalog.dat";
+    bfs::create_directories(mapFolder);
+    const bfs::path mapPath = (mapFolder / "map.swd").make_preferred();
+    bfs::copy_file(rttr::test::rttrBaseDir / "tests" / "testData" / "maps" / "LuaFunctions.SWD", mapPath);
+    bnw::ofstream(mapFolder / "broken.wld") << "Not a map";
+    bnw::ofstream(mapFolder / "other.txt") << "Not a map either";
+
+    MapCatalog::Entry mapEntry;
+    {
+        MapCatalog catalog(catalogPath);
+        catalog.startScan({mapFolder});
+        const auto entries = getScannedEntries(catalog);
+        BOOST_TEST_REQUIRE(entries.size() == 2u);
+        BOOST_TEST(entries[0].filePath.filename() == "broken.wld");
+        BOOST_TEST(!entries[0].error.empty());
+        mapEntry = entries[1];
+        BOOST_TEST(mapEntry.filePath == mapPath);
+        BOOST_TEST(mapEntry.error.empty());
+        BOOST_TEST(!mapEntry.name.empty());
+        BOOST_TEST(mapEntry.numPlayers > 0u);
+        BOOST_TEST(mapEntry.width > 0u);
+        BOOST_TEST(mapEntry.height > 0u);
+        BOOST_TEST(!mapEntry.hasLua);
+        BOOST_TEST(catalog.save());
+    }
+    BOOST_TEST_REQUIRE(bfs::exists(catalogPath));
+
+    // Replace the map by garbage of the same size and time: The cached header is used
+    const std::time_t lastWriteTime = bfs::last_write_time(mapPath);
+    const std::string garbage(static_cast<size_t>(bfs::file_size(mapPath)), 'x');
+    bnw::ofstream(mapPath, std::ios::binary) << garbage;
+    bfs::last_write_time(mapPath, lastWriteTime);
+    bnw::ofstream(bfs::path(mapPath).replace_extension("lua")) << "-- Script";
+    {
+        MapCatalog catalog(catalogPath);
+        catalog.startScan({mapFolder});
+        const auto entries = getScannedEntries(catalog);
+        BOOST_TEST_REQUIRE(entries.size() == 2u);
+        BOOST_TEST(entries[1].name == mapEntry.name);
+        BOOST_TEST(entries[1].error.empty());
+        // Checked every time
+        BOOST_TEST(entries[1].hasLua);
+
+        // Changed time: The map is read again
+        bfs::last_write_time(mapPath, lastWriteTime - 10);
+        bfs::remove(mapFolder / "broken.wld");
+        catalog.startScan({mapFolder});
+        const auto newEntries = getScannedEntries(catalog);
+        BOOST_TEST_REQUIRE(newEntries.size() == 1u);
+        BOOST_TEST(!newEntries[0].error.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(IgnoresCorruptCatalog)
+{
+    rttr::test::TmpFolder tmp;
+    const bfs::path catalogPath = tmp.get() / "mapCatalog.dat";
+    bnw::ofstream(catalogPath) << "Garbage";
+    MapCatalog catalog(catalogPath);
+    catalog.startScan({tmp.get()});
+    BOOST_TEST(getScannedEntries(catalog).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,66 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GlobalVars.h"
+#include "WindowManager.h"
+#include "desktops/dskBenchmark.h"
+#include "drivers/VideoDriverWrapper.h"
+#include "uiHelper/uiHelpers.hpp"
+#include <rttr/test/LogAccessor.hpp>
+#include <rttr/test/TmpFolder.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(UI)
+
+BOOST_AUTO_TEST_CASE(ParseBenchmarkNames)
+{
+    const std::vector<Benchmark> all{Benchmark::Text, Benchmark::Primitives, Benchmark::EmptyGame,
+                                     Benchmark::BasicGame, Benchmark::FullGame};
+    BOOST_TEST((parseBenchmarks("all") == all));
+    const std::vector<Benchmark> expected{Benchmark::FullGame, Benchmark::Text};
+    BOOST_TEST((parseBenchmarks("fullGame,text") == expected));
+    BOOST_CHECK_THROW(parseBenchmarks("text,foo"), std::invalid_argument);
+    BOOST_CHECK_THROW(parseBenchmarks("none"), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(HeadlessBenchmarkWritesResults, uiHelper::Fixture)
+{
+    rttr::test::TmpFolder tmp;
+    rttr::test::LogAccessor logAcc;
+
+    dskBenchmark::Config config;
+    config.benchmarks = parseBenchmarks("text,primitives");
+    config.numFrames = 5;
+    config.numInstances = 10;
+    config.outputFile = tmp.get() / "results.json";
+    WINDOWMANAGER.Switch(std::make_unique<dskBenchmark>(config));
+    // Both benchmarks run back to back without any input
+    for(unsigned i = 0; i < 2 * config.numFrames; i++)
+    {
+        BOOST_TEST_REQUIRE(GLOBALVARS.notdone);
+        WINDOWMANAGER.Draw();
+    }
+    BOOST_TEST(!GLOBALVARS.notdone);
+    GLOBALVARS.notdone = true;
+    BOOST_TEST(logAcc.getLog().find("Benchmark results written to") != std::string::npos);
+
+    BOOST_TEST_REQUIRE(boost::filesystem::exists(config.outputFile));
+    boost::nowide::ifstream file(config.outputFile);
+    const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    BOOST_TEST(json.find("\"name\": \"text\"") != std::string::npos);
+    BOOST_TEST(json.find("\"name\": \"primitives\"") != std::string::npos);
+    BOOST_TEST(json.find("\"frames\": 5,") != std::string::npos);
+    BOOST_TEST(json.find("\"instances\": 10,") != std::string::npos);
+    BOOST_TEST(json.find("\"drawFrameMs\": {\"min\": ") != std::string::npos);
+
+    // Leave the screen size as the other tests expect it
+    VIDEODRIVER.ResizeScreen(VideoMode(800, 600), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
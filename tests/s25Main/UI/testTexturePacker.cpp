@@ -8,6 +8,7 @@
 #include "uiHelper/uiHelpers.hpp"
 #include "libsiedler2/ArchivItem_Bitmap_Raw.h"
 #include "libsiedler2/PixelBufferBGRA.h"
+#include "s25util/tmpFile.h"
 #include <boost/test/unit_test.hpp>
 #include <Rect.h>
 #include <array>
@@ -61,4 +62,58 @@ BOOST_AUTO_TEST_CASE(SizeAndPosCorrect)
     }
 }
 
+BOOST_AUTO_TEST_CASE(CacheRestoresPacking)
+{
+    std::array<libsiedler2::ArchivItem_Bitmap_Raw, 4> bmps;
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        libsiedler2::PixelBufferBGRA buffer(3 + i * 2, 7 + i, libsiedler2::ColorBGRA(0xFF00FF00 + i));
+        bmps[i].create(buffer);
+    }
+    TmpFile cacheFile(".cache");
+    cacheFile.close();
+
+    std::array<glSmartBitmap, 4> smartBmps;
+    {
+        glTexturePacker packer;
+        for(unsigned i = 0; i < bmps.size(); ++i)
+        {
+            smartBmps[i].add(&bmps[i]);
+            packer.add(smartBmps[i]);
+        }
+        // Not packed -> Nothing to save
+        BOOST_TEST(!packer.saveCache(cacheFile.filePath, 42));
+        BOOST_TEST_REQUIRE(packer.pack(true));
+        BOOST_TEST_REQUIRE(packer.saveCache(cacheFile.filePath, 42));
+        for(auto& bmp : smartBmps)
+            bmp.setSharedTexture(0);
+    }
+
+    std::array<glSmartBitmap, 4> loadedBmps;
+    glTexturePacker packer;
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        loadedBmps[i].add(&bmps[i]);
+        packer.add(loadedBmps[i]);
+    }
+    // Wrong key
+    BOOST_TEST(!packer.loadCache(cacheFile.filePath, 43));
+    BOOST_TEST(packer.getTextures().empty());
+    BOOST_TEST_REQUIRE(packer.loadCache(cacheFile.filePath, 42));
+    BOOST_TEST_REQUIRE(packer.getTextures().size() == 1u);
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        BOOST_TEST(loadedBmps[i].getTexture() == packer.getTextures()[0].get());
+        for(unsigned j = 0; j < smartBmps[i].texCoords.size(); j++)
+            BOOST_TEST((loadedBmps[i].texCoords[j] == smartBmps[i].texCoords[j]));
+    }
+
+    // Different items -> Cache outdated
+    glSmartBitmap otherBmp;
+    otherBmp.add(&bmps[0]);
+    glTexturePacker otherPacker;
+    otherPacker.add(otherBmp);
+    BOOST_TEST(!otherPacker.loadCache(cacheFile.filePath, 42));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
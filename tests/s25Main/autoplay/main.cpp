@@ -5,6 +5,7 @@
 #define BOOST_TEST_MODULE RTTR_AutoplayTest
 #include "EventManager.h"
 #include "Game.h"
+#include "GameCommandProfiler.h"
 #include "GamePlayer.h"
 #include "Replay.h"
 #include "Timer.h"
@@ -61,6 +62,7 @@ static void playReplay(const boost::filesystem::path& replayPath)
     unsigned nextGF;
     BOOST_TEST_REQUIRE(replay.ReadGF(&nextGF));
 
+    GameCommandProfiler gcProfiler;
     const Timer timer(true);
     do
     {
@@ -84,7 +86,7 @@ static void playReplay(const boost::filesystem::path& replayPath)
                 uint8_t gcPlayer;
                 replay.ReadGameCommand(gcPlayer, msg);
                 for(const gc::GameCommandPtr& gc : msg.gcs)
-                    gc->Execute(game.world_, gcPlayer);
+                    gcProfiler.Execute(*gc, game.world_, gcPlayer);
                 AsyncChecksum& msgChecksum = msg.checksum;
                 if(msgChecksum.randChecksum != 0)
                     BOOST_TEST_REQUIRE(msgChecksum == checksum);
@@ -100,6 +102,7 @@ static void playReplay(const boost::filesystem::path& replayPath)
     } while(!endOfReplay);
     const auto duration = std::chrono::duration_cast<std::chrono::duration<float>>(timer.getElapsed());
     std::cout << "Replay " << replayPath.filename() << " took " << helpers::withUnit(duration) << std::endl;
+    gcProfiler.PrintSummary(std::cout);
 }
 
 BOOST_AUTO_TEST_CASE(Play200kReplay)
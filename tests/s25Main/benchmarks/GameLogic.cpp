@@ -0,0 +1,411 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GameObject.h"
+#include "GamePlayer.h"
+#include "ILocalGameState.h"
+#include "PlayerInfo.h"
+#include "RttrForeachPt.h"
+#include "SerializedGameData.h"
+#include "Ware.h"
+#include "ai/AIPlayer.h"
+#include "buildings/nobMilitary.h"
+#include "factories/AIFactory.h"
+#include "factories/BuildingFactory.h"
+#include "figures/nofPassiveSoldier.h"
+#include "pathfinding/FindPathForRoad.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noFlag.h"
+#include "gameTypes/AIInfo.h"
+#include "gameData/MilitaryConsts.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// All benchmarks on generated worlds take the map size and the number of players as arguments,
+// so the results can be plotted over both
+
+namespace {
+const std::vector<int64_t> mapSizes = {64, 128, 256};
+const std::vector<int64_t> playerCounts = {2, 4, 8};
+
+/// Game object which handles an event and adds a new one with the same length
+class PeriodicEventHandler final : public GameObject
+{
+public:
+    PeriodicEventHandler(EventManager& em, unsigned period, unsigned& numHandled)
+        : em_(em), period_(period), numHandled_(numHandled)
+    {
+        em_.AddEvent(this, period_);
+    }
+
+    void HandleEvent(unsigned /*id*/) override
+    {
+        ++numHandled_;
+        em_.AddEvent(this, period_);
+    }
+    void Destroy() override {}
+    void Serialize(SerializedGameData&) const override {}
+    GO_Type GetGOT() const final { return GO_Type::Staticobject; }
+
+private:
+    EventManager& em_;
+    const unsigned period_;
+    unsigned& numHandled_;
+};
+
+/// Local game state without a local player, required for loading a snapshot
+class NullLocalGameState final : public ILocalGameState
+{
+public:
+    unsigned GetPlayerId() const override { return 0; }
+    bool IsHost() const override { return true; }
+    std::string FormatGFTime(unsigned /*numGFs*/) const override { return {}; }
+    void SystemChat(const std::string& /*text*/) override {}
+};
+
+std::vector<PlayerInfo> createPlayers(unsigned numPlayers)
+{
+    std::vector<PlayerInfo> players(numPlayers);
+    for(auto& player : players)
+        player.ps = PlayerState::Occupied;
+    return players;
+}
+
+GlobalGameSettings createGGS()
+{
+    GlobalGameSettings ggs;
+    // Default setting for new games. Makes the visibility calculations store the FoW state
+    ggs.exploration = Exploration::FogOfWar;
+    return ggs;
+}
+
+/// Create a started game on an empty map of the given size with the HQs of all players evenly distributed
+std::shared_ptr<Game> createGame(unsigned mapSize, unsigned numPlayers)
+{
+    auto game = std::make_shared<Game>(createGGS(), 0, createPlayers(numPlayers));
+    if(!CreateEmptyWorld(MapExtent::all(mapSize))(game->world_))
+        return nullptr;
+    game->Start(false);
+    return game;
+}
+
+/// Add a watchtower which is occupied by a single soldier and hence claims its territory
+nobMilitary* addMilitaryBuilding(GameWorld& world, const MapPoint pt, const unsigned char player)
+{
+    auto* bld = static_cast<nobMilitary*>(
+      BuildingFactory::CreateBuilding(world, BuildingType::Watchtower, pt, player, Nation::Romans));
+    auto& soldier = world.AddFigure(pt, std::make_unique<nofPassiveSoldier>(pt, player, bld, bld, 0));
+    world.GetPlayer(player).IncreaseInventoryJob(soldier.GetJobType(), 1);
+    // Already at the goal, so this adds the soldier to the building
+    soldier.WalkToGoal();
+    return bld;
+}
+
+/// Add a watchtower next to the HQ of each player. Its territory reaches into the one of the neighbours
+std::vector<nobMilitary*> addMilitaryBuildings(GameWorld& world)
+{
+    std::vector<nobMilitary*> result;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+    {
+        const MapPoint pt = world.MakeMapPoint(world.GetPlayer(i).GetHQPos() + Position(6, 0));
+        result.push_back(addMilitaryBuilding(world, pt, i));
+    }
+    return result;
+}
+
+/// Give each node to the player with the closest HQ as if the whole map was conquered
+void distributeTerritory(GameWorld& world)
+{
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        unsigned char owner = 0;
+        unsigned minDistance = std::numeric_limits<unsigned>::max();
+        for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        {
+            const unsigned distance = world.CalcDistance(pt, world.GetPlayer(i).GetHQPos());
+            if(distance < minDistance)
+            {
+                minDistance = distance;
+                owner = static_cast<unsigned char>(i + 1);
+            }
+        }
+        world.SetOwner(pt, owner);
+    }
+    world.RecalcBorderStones(Position(0, 0), Extent(world.GetSize()));
+    world.InitAfterLoad();
+}
+
+/// Fill the territory of the player with sawmills which are connected to the HQ.
+/// Their flags form a grid with a spacing of 4 around the HQ flag. The rows are connected by a road through it.
+/// Return the number of sawmills
+unsigned buildEconomy(GameWorld& world, const unsigned char player)
+{
+    const MapPoint hqFlagPos = world.GetNeighbour(world.GetPlayer(player).GetHQPos(), Direction::SouthEast);
+    const auto getFlagPos = [&world, hqFlagPos](int col, int row) {
+        return world.MakeMapPoint(Position(hqFlagPos) + Position(4 * col, 4 * row));
+    };
+    // Nodes around the flag and the building must belong to the player and be free
+    const auto isUsable = [&world, player](const MapPoint flagPos) {
+        return !world.CheckPointsInRadius(
+          flagPos, 2, [&world, player](const MapPoint pt) { return world.GetNode(pt).owner != player + 1; }, true)
+               && !world.GetNode(flagPos).obj
+               && !world.GetNode(world.GetNeighbour(flagPos, Direction::NorthWest)).obj;
+    };
+    const auto connect = [&world, player](const MapPoint start, const MapPoint end) {
+        const std::vector<Direction> route = FindPathForRoad(world, start, end, false, 12);
+        if(route.empty())
+            return false;
+        world.BuildRoad(player, false, start, route);
+        return world.GetPointRoad(start, route.front()) == PointRoad::Normal;
+    };
+
+    // Don't go around the whole map, so the parts from both directions don't meet
+    const int maxCol = world.GetWidth() / 8 - 1;
+    const int maxRow = world.GetHeight() / 8 - 1;
+    unsigned numBuildings = 0;
+    for(const int rowDir : {1, -1})
+    {
+        for(int row = (rowDir > 0) ? 0 : -1; row * rowDir <= maxRow; row += rowDir)
+        {
+            const MapPoint rowStart = getFlagPos(0, row);
+            if(row != 0 && (!isUsable(rowStart) || !connect(getFlagPos(0, row - rowDir), rowStart)))
+                break;
+            for(const int colDir : {1, -1})
+            {
+                for(int col = colDir; col * colDir <= maxCol; col += colDir)
+                {
+                    const MapPoint flagPos = getFlagPos(col, row);
+                    if(!isUsable(flagPos))
+                        break;
+                    BuildingFactory::CreateBuilding(world, BuildingType::Sawmill,
+                                                    world.GetNeighbour(flagPos, Direction::NorthWest), player,
+                                                    Nation::Romans);
+                    numBuildings++;
+                    if(!connect(getFlagPos(col - colDir, row), flagPos))
+                        break;
+                }
+            }
+        }
+    }
+    return numBuildings;
+}
+
+/// Create a game resembling a running one: The map is split among the players and each has an economy in which
+/// workers and wares are on their way
+std::shared_ptr<Game> createPopulatedGame(unsigned mapSize, unsigned numPlayers)
+{
+    auto game = createGame(mapSize, numPlayers);
+    if(!game)
+        return game;
+    distributeTerritory(game->world_);
+    for(unsigned i = 0; i < numPlayers; i++)
+        buildEconomy(game->world_, i);
+    for(unsigned i = 0; i < 2000; i++)
+        game->RunGF();
+    return game;
+}
+} // namespace
+
+static void BM_ExecuteNextGF(benchmark::State& state)
+{
+    EventManager em(0);
+    unsigned numHandled = 0;
+    std::vector<std::unique_ptr<PeriodicEventHandler>> objects;
+    const auto numObjects = static_cast<unsigned>(state.range(0));
+    objects.reserve(numObjects);
+    // Mix of short events (e.g. walking) and long ones (e.g. production or growing trees)
+    for(unsigned i = 0; i < numObjects; i++)
+    {
+        const unsigned period = (i % 4u) ? 20u : 1u + (i * 7u) % 2000u;
+        objects.push_back(std::make_unique<PeriodicEventHandler>(em, period, numHandled));
+    }
+
+    for(auto _ : state)
+        em.ExecuteNextGF();
+    state.SetItemsProcessed(numHandled);
+}
+// Argument is the number of objects with events
+BENCHMARK(BM_ExecuteNextGF)->RangeMultiplier(10)->Range(1000, 1000000);
+
+static void BM_RecalcTerritory(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto game = createGame(static_cast<unsigned>(state.range(0)), static_cast<unsigned>(state.range(1)));
+    if(!game)
+    {
+        state.SkipWithError("World creation failed");
+        return;
+    }
+    GameWorld& world = game->world_;
+    const std::vector<nobMilitary*> blds = addMilitaryBuildings(world);
+
+    for(auto _ : state)
+    {
+        // Losing and recapturing the building changes the owner of all nodes only it claims
+        for(const nobMilitary* bld : blds)
+        {
+            world.RecalcTerritory(*bld, TerritoryChangeReason::Destroyed);
+            world.RecalcTerritory(*bld, TerritoryChangeReason::Captured);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * blds.size() * 2);
+}
+BENCHMARK(BM_RecalcTerritory)->ArgsProduct({mapSizes, playerCounts});
+
+static void BM_RecalcVisibilities(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto game = createGame(static_cast<unsigned>(state.range(0)), static_cast<unsigned>(state.range(1)));
+    if(!game)
+    {
+        state.SkipWithError("World creation failed");
+        return;
+    }
+    GameWorld& world = game->world_;
+    const std::vector<nobMilitary*> blds = addMilitaryBuildings(world);
+
+    for(auto _ : state)
+    {
+        for(const nobMilitary* bld : blds)
+        {
+            world.RecalcVisibilitiesAroundPoint(bld->GetPos(), bld->GetMilitaryRadius() + VISUALRANGE_MILITARY,
+                                                bld->GetPlayer(), nullptr);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * blds.size());
+}
+BENCHMARK(BM_RecalcVisibilities)->ArgsProduct({mapSizes, playerCounts});
+
+static void BM_FindClientForWare(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto game = createGame(static_cast<unsigned>(state.range(0)), static_cast<unsigned>(state.range(1)));
+    if(!game)
+    {
+        state.SkipWithError("World creation failed");
+        return;
+    }
+    GameWorld& world = game->world_;
+    distributeTerritory(world);
+    const unsigned numConsumers = buildEconomy(world, 0);
+    state.counters["consumers"] = numConsumers;
+
+    GamePlayer& player = world.GetPlayer(0);
+    auto* hq = world.GetSpecObj<noRoadNode>(player.GetHQPos());
+    Ware ware(GoodType::Wood, nullptr, hq);
+    for(auto _ : state)
+        benchmark::DoNotOptimize(player.FindClientForWare(ware));
+    player.RemoveWare(ware);
+}
+BENCHMARK(BM_FindClientForWare)->ArgsProduct({mapSizes, playerCounts});
+
+static void BM_MakeSnapshot(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto game = createPopulatedGame(static_cast<unsigned>(state.range(0)), static_cast<unsigned>(state.range(1)));
+    if(!game)
+    {
+        state.SkipWithError("World creation failed");
+        return;
+    }
+    SerializedGameData sgd;
+    for(auto _ : state)
+        sgd.MakeSnapshot(*game);
+    state.counters["objects"] = GameObject::GetNumObjs();
+    state.SetBytesProcessed(state.iterations() * sgd.GetLength());
+}
+BENCHMARK(BM_MakeSnapshot)->ArgsProduct({mapSizes, playerCounts})->Unit(benchmark::kMillisecond);
+
+static void BM_ReadSnapshot(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto numPlayers = static_cast<unsigned>(state.range(1));
+    std::vector<char> data;
+    unsigned startGF = 0;
+    {
+        // Only one game may exist at a time as the objects are counted globally
+        const auto game = createPopulatedGame(static_cast<unsigned>(state.range(0)), numPlayers);
+        if(!game)
+        {
+            state.SkipWithError("World creation failed");
+            return;
+        }
+        SerializedGameData sgd;
+        sgd.MakeSnapshot(*game);
+        data.assign(sgd.GetData(), sgd.GetData() + sgd.GetLength());
+        startGF = game->em_->GetCurrentGF();
+    }
+    NullLocalGameState localGameState;
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        SerializedGameData sgd;
+        sgd.PushRawData(data.data(), data.size());
+        auto game = std::make_shared<Game>(createGGS(), startGF, createPlayers(numPlayers));
+        state.ResumeTiming();
+        sgd.ReadSnapshot(*game, localGameState);
+        state.PauseTiming();
+        game.reset();
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_ReadSnapshot)->ArgsProduct({mapSizes, playerCounts})->Unit(benchmark::kMillisecond);
+
+static void BM_AIRunGF(benchmark::State& state)
+{
+    using clock = std::chrono::steady_clock;
+    rttr::test::Fixture f;
+    const auto level = static_cast<AI::Level>(state.range(0));
+    const auto game = createGame(static_cast<unsigned>(state.range(1)), static_cast<unsigned>(state.range(2)));
+    if(!game)
+    {
+        state.SkipWithError("World creation failed");
+        return;
+    }
+    GameWorld& world = game->world_;
+    std::vector<std::unique_ptr<AIPlayer>> ais;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        ais.push_back(AIFactory::Create(AI::Info(AI::Type::Default, level), i, world));
+
+    // Commands are sent every network frame and executed one network frame later
+    constexpr unsigned nwfLength = 5;
+    std::vector<std::vector<gc::GameCommandPtr>> pendingGCs(ais.size());
+    for(auto _ : state)
+    {
+        game->RunGF();
+        const unsigned gf = game->em_->GetCurrentGF();
+        const bool isNWF = gf % nwfLength == 0;
+        if(isNWF)
+        {
+            for(unsigned i = 0; i < ais.size(); i++)
+            {
+                for(gc::GameCommandPtr& gc : pendingGCs[i])
+                    gc->Execute(world, i);
+                pendingGCs[i] = ais[i]->FetchGameCommands();
+            }
+        }
+        // Only the AI itself is measured
+        const auto start = clock::now();
+        for(auto& ai : ais)
+            ai->RunGF(gf, isNWF);
+        state.SetIterationTime(std::chrono::duration<double>(clock::now() - start).count());
+    }
+}
+// Arguments are the AI level, the map size and the number of players, which are all AIs.
+// The AI behaves differently over time, so use a fixed number of GFs
+BENCHMARK(BM_AIRunGF)
+  ->ArgsProduct({{static_cast<int64_t>(AI::Level::Easy), static_cast<int64_t>(AI::Level::Medium),
+                  static_cast<int64_t>(AI::Level::Hard)},
+                 mapSizes,
+                 playerCounts})
+  ->Iterations(2000)
+  ->UseManualTime();
@@ -3,14 +3,22 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "Game.h"
+#include "ListDir.h"
 #include "PlayerInfo.h"
+#include "commonDefines.h"
 #include "network/GameClient.h"
 #include "ogl/glAllocator.h"
 #include "world/MapLoader.h"
+#include "libsiedler2/Archiv.h"
+#include "libsiedler2/ArchivItem_Map.h"
+#include "libsiedler2/ArchivItem_Map_Header.h"
 #include "libsiedler2/libsiedler2.h"
+#include "libsiedler2/prototypen.h"
 #include <rttr/test/Fixture.hpp>
 #include <benchmark/benchmark.h>
 #include <array>
+#include <map>
+#include <string>
 #include <test/testConfig.h>
 #include <utility>
 
@@ -54,7 +62,8 @@ constexpr std::array<std::tuple<const char*, unsigned>, 3> maps = {
   {{"AM_FANGDERZEIT", 7}, {"TueranTuer", 2}, {"Suedameri", 5}}};
 static void BM_BQ_Calculation(benchmark::State& state)
 {
-    const auto& curValues = maps[static_cast<size_t>(state.range())];
+    const auto& curValues = maps[static_cast<size_t>(state.range(0))];
+    const auto numThreads = static_cast<unsigned>(state.range(1));
 
     std::vector<PlayerInfo> players(std::get<1>(curValues));
     for(auto& player : players)
@@ -64,15 +73,68 @@ static void BM_BQ_Calculation(benchmark::State& state)
     MapLoader loader(world);
 
     const std::string curMap = std::get<0>(curValues);
-    state.SetLabel(curMap);
+    state.SetLabel(curMap + (numThreads ? " " + std::to_string(numThreads) + " threads" : " all threads"));
     const std::string mapPath = "data/RTTR/MAPS/NEW/" + curMap + ".SWD";
     if(!loader.Load(rttr::test::rttrBaseDir / mapPath))
         state.SkipWithError(("Map " + curMap + " failed to load").c_str());
 
     for(auto _ : state)
     {
-        world.InitAfterLoad();
+        world.InitAfterLoad(numThreads);
         benchmark::DoNotOptimize(world);
     }
 }
-BENCHMARK(BM_BQ_Calculation)->DenseRange(0, maps.size() - 1);
\ No newline at end of file
+// Second argument is the number of threads (0 = all cores)
+BENCHMARK(BM_BQ_Calculation)
+  ->ArgsProduct({benchmark::CreateDenseRange(0, maps.size() - 1, 1), {1, 2, 4, 0}})
+  ->UseRealTime();
+
+static void BM_LoadMap(benchmark::State& state, const boost::filesystem::path& mapPath, unsigned numPlayers)
+{
+    rttr::test::Fixture f;
+    libsiedler2::setAllocator(new GlAllocator);
+
+    std::vector<PlayerInfo> players(numPlayers);
+    for(auto& player : players)
+        player.ps = PlayerState::Occupied;
+    state.SetLabel(mapPath.filename().string());
+
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        auto game = std::make_shared<Game>(GlobalGameSettings(), 0, players);
+        MapLoader loader(game->world_);
+        state.ResumeTiming();
+        if(!loader.Load(mapPath))
+        {
+            state.SkipWithError("Map failed to load");
+            break;
+        }
+        state.PauseTiming();
+        game.reset();
+        state.ResumeTiming();
+    }
+}
+
+/// Register BM_LoadMap for one shipped map of each size, ordered by size
+static const bool mapLoadBenchmarksRegistered = [] {
+    std::map<std::pair<unsigned, unsigned>, std::pair<boost::filesystem::path, unsigned>> mapsBySize;
+    for(const boost::filesystem::path& mapPath : ListDir(rttr::test::rttrBaseDir / "data/RTTR/MAPS/NEW", "swd"))
+    {
+        libsiedler2::Archiv map;
+        if(libsiedler2::loader::LoadMAP(mapPath, map, true) != 0)
+            continue;
+        const libsiedler2::ArchivItem_Map_Header& header =
+          checkedCast<const libsiedler2::ArchivItem_Map*>(map[0])->getHeader();
+        mapsBySize.emplace(std::make_pair(header.getWidth(), header.getHeight()),
+                           std::make_pair(mapPath, header.getNumPlayers()));
+    }
+    for(const auto& entry : mapsBySize)
+    {
+        const std::string name =
+          "BM_LoadMap/" + std::to_string(entry.first.first) + "x" + std::to_string(entry.first.second);
+        benchmark::RegisterBenchmark(name.c_str(), BM_LoadMap, entry.second.first, entry.second.second)
+          ->Unit(benchmark::kMillisecond);
+    }
+    return true;
+}();
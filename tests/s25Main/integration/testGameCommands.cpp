@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "GameCommandProfiler.h"
 #include "GamePlayer.h"
 #include "PointOutput.h"
 #include "RttrForeachPt.h"
@@ -27,6 +28,7 @@
 #include "rttr/test/random.hpp"
 #include <boost/test/unit_test.hpp>
 #include <iostream>
+#include <sstream>
 
 #if defined(PVS_STUDIO) || defined(__clang_analyzer__)
 #    undef BOOST_TEST_REQUIRE
@@ -1001,4 +1003,63 @@ BOOST_FIXTURE_TEST_CASE(SurrenderTest, WorldWithGCExecution2P)
     BOOST_TEST_REQUIRE(!player2.IsDefeated());
 }
 
+namespace {
+/// Executes the commands through a profiler
+class ProfilingGCExecutor : public GameCommandFactory
+{
+public:
+    ProfilingGCExecutor(GameWorld& world, unsigned playerId) : world_(world), playerId_(playerId) {}
+    GameCommandProfiler profiler;
+
+protected:
+    bool AddGC(gc::GameCommandPtr gc) override
+    {
+        profiler.Execute(*gc, world_, playerId_);
+        return true;
+    }
+
+private:
+    GameWorld& world_;
+    unsigned playerId_;
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(ProfilerCountsCommandsAndEvents, WorldWithGCExecution2P)
+{
+    ProfilingGCExecutor executor(world, curPlayer);
+    GameCommandProfiler& gcProfiler = executor.profiler;
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    const MapPoint flagPt = hqFlagPos + MapPoint(2, 0);
+    executor.SetFlag(flagPt);
+    // Invalid position -> Still executed
+    executor.SetFlag(flagPt);
+    // Connected to the HQ -> Carrier leaves the HQ
+    executor.BuildRoad(hqFlagPos, false, std::vector<Direction>(2, Direction::East));
+    BOOST_TEST_REQUIRE(world.GetPointRoad(hqFlagPos, Direction::East) == PointRoad::Normal);
+
+    const GameCommandProfiler::Stats& flagStats = gcProfiler.GetStats(gc::GCType::SetFlag);
+    BOOST_TEST(flagStats.count == 2u);
+    const GameCommandProfiler::Stats& roadStats = gcProfiler.GetStats(gc::GCType::BuildRoad);
+    BOOST_TEST(roadStats.count == 1u);
+    BOOST_TEST(roadStats.numEventsAdded > 0u);
+    BOOST_TEST(gcProfiler.GetStats(gc::GCType::Attack).count == 0u);
+    const GameCommandProfiler::Stats total = gcProfiler.GetTotal();
+    BOOST_TEST(total.count == 3u);
+    BOOST_TEST(total.numEventsAdded == flagStats.numEventsAdded + roadStats.numEventsAdded);
+    BOOST_TEST((total.duration == flagStats.duration + roadStats.duration));
+
+    std::stringstream csv;
+    gcProfiler.WriteCSV(csv);
+    std::string line;
+    std::vector<std::string> lines;
+    while(std::getline(csv, line))
+        lines.push_back(line);
+    BOOST_TEST_REQUIRE(lines.size() == 3u);
+    BOOST_TEST(lines[1].find("SetFlag,2,") == 0u);
+    BOOST_TEST(lines[2].find("BuildRoad,1,") == 0u);
+
+    gcProfiler.Clear();
+    BOOST_TEST(gcProfiler.GetTotal().count == 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
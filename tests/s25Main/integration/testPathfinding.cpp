@@ -4,8 +4,11 @@
 
 #include "RttrForeachPt.h"
 #include "helpers/OptionalIO.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
+#include "worldFixtures/WorldWithGCExecution.h"
+#include "nodeObjs/noFlag.h"
 #include "nodeObjs/noGranite.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "gameData/GameConsts.h"
@@ -290,4 +293,42 @@ BOOST_FIXTURE_TEST_CASE(BlockedPaths, WorldFixtureEmpty0P)
     BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, surroundingPts2[0]));
 }
 
+BOOST_FIXTURE_TEST_CASE(RoadNetworkConnectivity, WorldWithGCExecution1P)
+{
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    const MapPoint flag1Pos = hqFlagPos + MapPoint(2, 0);
+    const MapPoint flag2Pos = flag1Pos + MapPoint(2, 0);
+    this->SetFlag(flag1Pos);
+    this->SetFlag(flag2Pos);
+    const noFlag& hqFlag = *world.GetSpecObj<noFlag>(hqFlagPos);
+    const noFlag& flag1 = *world.GetSpecObj<noFlag>(flag1Pos);
+    const noFlag& flag2 = *world.GetSpecObj<noFlag>(flag2Pos);
+    const noRoadNode& hq = *world.GetSpecObj<noRoadNode>(hqPos);
+    BOOST_TEST(pathFinder.MightBeConnected(hq, hqFlag));
+    BOOST_TEST(!pathFinder.MightBeConnected(hqFlag, flag1));
+    BOOST_TEST(!pathFinder.PathExists(hqFlag, flag1, true));
+
+    this->BuildRoad(hqFlagPos, false, std::vector<Direction>(2, Direction::East));
+    this->BuildRoad(flag1Pos, false, std::vector<Direction>(2, Direction::East));
+    BOOST_TEST(pathFinder.MightBeConnected(hq, flag2));
+    BOOST_TEST(pathFinder.PathExists(hq, flag2, false));
+    unsigned length = 0;
+    BOOST_TEST(pathFinder.FindPath(hq, flag2, true, std::numeric_limits<unsigned>::max(), nullptr, &length));
+    BOOST_TEST(length == 5u);
+
+    // Splitting the network is detected
+    this->DestroyRoad(flag1Pos, Direction::East);
+    BOOST_TEST(pathFinder.MightBeConnected(hq, flag1));
+    BOOST_TEST(!pathFinder.MightBeConnected(hq, flag2));
+    BOOST_TEST(!pathFinder.PathExists(hq, flag2, true));
+    BOOST_TEST(world.FindPathForWareOnRoads(hq, flag2) == RoadPathDirection::None);
+
+    // Reconnecting by a different road as well
+    this->BuildRoad(hqFlagPos, false,
+                    {Direction::SouthEast, Direction::East, Direction::East, Direction::East, Direction::NorthEast});
+    BOOST_TEST(pathFinder.MightBeConnected(hq, flag2));
+    BOOST_TEST(pathFinder.PathExists(hq, flag2, false));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
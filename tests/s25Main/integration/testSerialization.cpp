@@ -306,9 +306,19 @@ BOOST_FIXTURE_TEST_CASE(BaseSaveLoad, RandWorldFixture)
             }
             BOOST_TEST_REQUIRE(loadSave.ggs.speed == ggs.speed);
         }
-        if(what != SaveGameDataToLoad::All)
+        if(what == SaveGameDataToLoad::Header)
+        {
+            BOOST_TEST_REQUIRE(loadSave.sgd.GetLength() == 0u);
+            // Position of the game data is only known after reading the settings
+            BOOST_TEST_REQUIRE(!loadSave.LoadGameData());
+        } else if(what == SaveGameDataToLoad::HeaderAndSettings)
+        {
             BOOST_TEST_REQUIRE(loadSave.sgd.GetLength() == 0u);
-        else
+            // Game data can be loaded separately afterwards
+            BOOST_TEST_REQUIRE(loadSave.LoadGameData());
+            BOOST_REQUIRE_EQUAL_COLLECTIONS(loadSave.sgd.GetData(), loadSave.sgd.GetData() + loadSave.sgd.GetLength(),
+                                            save.sgd.GetData(), save.sgd.GetData() + save.sgd.GetLength());
+        } else
         {
             std::vector<PlayerInfo> players;
             for(unsigned j = 0; j < 4; j++)
@@ -512,7 +522,8 @@ BOOST_FIXTURE_TEST_CASE(BrokenReplayWithMap, ReplayMapFixture)
         BOOST_TEST_REQUIRE(replay.IsRecording());
         AddReplayCmds(replay, cmds);
         BOOST_TEST(replay.GetLastGF() == 5u);
-        // Assume an exception/crash here so Replay is simply destroyed without Close or StopRecording
+        // Assume an exception here so Replay is simply destroyed without Close or StopRecording.
+        // The destructor still writes the open block, see ReplayAfterHardCrash for a crash without it
     }
 
     Replay loadReplay;
@@ -547,6 +558,171 @@ BOOST_FIXTURE_TEST_CASE(BrokenReplayWithMap, ReplayMapFixture)
     CheckReplayCmds(loadReplay, cmds);
 }
 
+BOOST_FIXTURE_TEST_CASE(ReplayAfterHardCrash, ReplayMapFixture)
+{
+    TmpFile tmpFile, crashedFile;
+    BOOST_TEST_REQUIRE(tmpFile.isValid());
+    BOOST_TEST_REQUIRE(crashedFile.isValid());
+    tmpFile.close();
+    crashedFile.close();
+    bfs::remove(tmpFile.filePath);
+    bfs::remove(crashedFile.filePath);
+
+    // Commands of 1 GF more than fit into a block, so the first block gets written and the 2nd is still open
+    constexpr unsigned numGFs = 1001;
+    Replay replay;
+    for(const BasePlayerInfo& player : players)
+        replay.AddPlayer(player);
+    BOOST_TEST_REQUIRE(replay.StartRecording(tmpFile.filePath, map));
+    for(unsigned gf = 0; gf < numGFs; gf++)
+    {
+        replay.AddChatCommand(gf, 1, ChatDestination::All, std::to_string(gf));
+        replay.UpdateLastGF(gf);
+    }
+    // The process dies now: Only what is on disk remains
+    bfs::copy_file(tmpFile.filePath, crashedFile.filePath);
+    replay.StopRecording();
+
+    Replay loadReplay;
+    BOOST_TEST_REQUIRE(loadReplay.LoadHeader(crashedFile.filePath));
+    MapInfo newMap;
+    BOOST_TEST_REQUIRE(loadReplay.LoadGameData(newMap));
+    unsigned gf;
+    for(unsigned expectedGF = 0; expectedGF + 1 < numGFs; expectedGF++)
+    {
+        BOOST_TEST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_TEST_REQUIRE(gf == expectedGF);
+        BOOST_TEST_REQUIRE(loadReplay.ReadRCType() == ReplayCommand::Chat);
+        uint8_t player, dst;
+        std::string txt;
+        loadReplay.ReadChatCommand(player, dst, txt);
+        BOOST_TEST_REQUIRE(txt == std::to_string(gf));
+    }
+    // The commands of the open block are lost
+    BOOST_TEST(!loadReplay.ReadGF(&gf));
+}
+
+BOOST_FIXTURE_TEST_CASE(ReplayWithManyCommands, ReplayMapFixture)
+{
+    using rttr::test::randomValue;
+    TmpFile tmpFile;
+    BOOST_TEST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    bfs::remove(tmpFile.filePath);
+
+    // Enough GFs and commands to span multiple blocks
+    struct Cmd
+    {
+        unsigned gf;
+        uint8_t player;
+        AsyncChecksum checksum;
+    };
+    std::vector<Cmd> cmds;
+    AsyncChecksum checksum(randomValue<unsigned>(), randomValue(1000u, 2000u), 3000, 500, 0xFFFFFFF0);
+    for(unsigned gf = 0; gf < 5000; gf += randomValue(1u, 20u))
+    {
+        checksum.randChecksum = randomValue<unsigned>();
+        checksum.objCt += randomValue(-50, 50);
+        checksum.objIdCt += randomValue(0u, 50u);
+        checksum.eventCt += randomValue(-50, 50);
+        checksum.evInstanceCt += randomValue(0u, 50u); // Overflows
+        for(uint8_t player = 0; player < 3; player++)
+            cmds.push_back(Cmd{gf, player, checksum});
+    }
+
+    {
+        Replay replay;
+        for(const BasePlayerInfo& player : players)
+            replay.AddPlayer(player);
+        BOOST_TEST_REQUIRE(replay.StartRecording(tmpFile.filePath, map));
+        for(const Cmd& cmd : cmds)
+        {
+            replay.AddGameCommand(cmd.gf, cmd.player, PlayerGameCommands(cmd.checksum, {}));
+            if(cmd.player == 0 && cmd.gf % 10 == 0)
+                replay.AddChatCommand(cmd.gf, 1, ChatDestination::All, std::to_string(cmd.gf));
+            replay.UpdateLastGF(cmd.gf);
+        }
+        BOOST_TEST_REQUIRE(replay.StopRecording());
+    }
+
+    Replay loadReplay;
+    BOOST_TEST_REQUIRE(loadReplay.LoadHeader(tmpFile.filePath));
+    BOOST_TEST(loadReplay.GetLastGF() == cmds.back().gf);
+    MapInfo newMap;
+    BOOST_TEST_REQUIRE(loadReplay.LoadGameData(newMap));
+    unsigned gf;
+    for(const Cmd& cmd : cmds)
+    {
+        BOOST_TEST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_TEST_REQUIRE(gf == cmd.gf);
+        BOOST_TEST_REQUIRE(loadReplay.ReadRCType() == ReplayCommand::Game);
+        uint8_t player;
+        PlayerGameCommands loadedCmds;
+        loadReplay.ReadGameCommand(player, loadedCmds);
+        BOOST_TEST_REQUIRE(player == cmd.player);
+        BOOST_TEST_REQUIRE(loadedCmds.checksum == cmd.checksum);
+        BOOST_TEST_REQUIRE(loadedCmds.gcs.empty());
+        if(cmd.player == 0 && cmd.gf % 10 == 0)
+        {
+            BOOST_TEST_REQUIRE(loadReplay.ReadGF(&gf));
+            BOOST_TEST_REQUIRE(gf == cmd.gf);
+            BOOST_TEST_REQUIRE(loadReplay.ReadRCType() == ReplayCommand::Chat);
+            uint8_t dst;
+            std::string txt;
+            loadReplay.ReadChatCommand(player, dst, txt);
+            BOOST_TEST_REQUIRE(txt == std::to_string(cmd.gf));
+        }
+    }
+    BOOST_TEST_REQUIRE(!loadReplay.ReadGF(&gf));
+}
+
+BOOST_FIXTURE_TEST_CASE(ReplayChecksumDeltas, ReplayMapFixture)
+{
+    TmpFile tmpFile;
+    BOOST_TEST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    bfs::remove(tmpFile.filePath);
+
+    // Unchanged values, small and large steps in both directions and wrap arounds
+    const std::vector<AsyncChecksum> checksums = {
+      AsyncChecksum(42, 0, 0, 0, 0),
+      AsyncChecksum(42, 1, 0, 0, 0),
+      AsyncChecksum(43, 0, 5, 0xFFFFFFFF, 0),
+      AsyncChecksum(43, 0xFFFFFFFF, 0x7FFFFFFF, 0, 0x80000000),
+      AsyncChecksum(0, 0x80000000, 0x80000000, 0x7FFFFFFF, 0x7FFFFFFF),
+      AsyncChecksum(0, 0x80000000, 0, 0x80000000, 0xFFFFFFFF),
+      AsyncChecksum(0xFFFFFFFF, 123456, 123460, 99, 1),
+    };
+
+    {
+        Replay replay;
+        for(const BasePlayerInfo& player : players)
+            replay.AddPlayer(player);
+        BOOST_TEST_REQUIRE(replay.StartRecording(tmpFile.filePath, map));
+        for(unsigned i = 0; i < checksums.size(); i++)
+            replay.AddGameCommand(i, 0, PlayerGameCommands(checksums[i], {}));
+        replay.UpdateLastGF(checksums.size());
+        BOOST_TEST_REQUIRE(replay.StopRecording());
+    }
+
+    Replay loadReplay;
+    BOOST_TEST_REQUIRE(loadReplay.LoadHeader(tmpFile.filePath));
+    MapInfo newMap;
+    BOOST_TEST_REQUIRE(loadReplay.LoadGameData(newMap));
+    for(unsigned i = 0; i < checksums.size(); i++)
+    {
+        unsigned gf;
+        BOOST_TEST_REQUIRE(loadReplay.ReadGF(&gf));
+        BOOST_TEST_REQUIRE(gf == i);
+        BOOST_TEST_REQUIRE(loadReplay.ReadRCType() == ReplayCommand::Game);
+        uint8_t player;
+        PlayerGameCommands loadedCmds;
+        loadReplay.ReadGameCommand(player, loadedCmds);
+        BOOST_TEST_INFO("Checksum " << i);
+        BOOST_TEST(loadedCmds.checksum == checksums[i]);
+    }
+}
+
 BOOST_FIXTURE_TEST_CASE(ReplayWithSavegame, RandWorldFixture)
 {
     MapInfo map;
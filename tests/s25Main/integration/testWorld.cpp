@@ -9,11 +9,15 @@
 #include "RttrForeachPt.h"
 #include "files.h"
 #include "lua/GameDataLoader.h"
+#include "notifications/NodeNote.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/MockLocalGameState.h"
 #include "worldFixtures/WorldFixture.h"
 #include "world/MapLoader.h"
+#include "world/MapTemplate.h"
 #include "nodeObjs/noBase.h"
+#include "nodeObjs/noFlag.h"
+#include "nodeObjs/noTree.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "libsiedler2/ArchivItem_Map.h"
 #include "libsiedler2/ArchivItem_Map_Header.h"
@@ -21,6 +25,7 @@
 #include "s25util/tmpFile.h"
 #include <boost/filesystem/path.hpp>
 #include <boost/test/unit_test.hpp>
+#include <set>
 #include <vector>
 
 struct MapTestFixture
@@ -69,6 +74,23 @@ struct LoadWorldAndS2MapCreator : MapTestFixture
     }
 };
 
+struct LoadWorldFromTemplateCreator
+{
+    static std::shared_ptr<const MapTemplate> mapTemplate;
+    std::vector<MapPoint> hqs;
+
+    explicit LoadWorldFromTemplateCreator(MapExtent) {}
+    bool operator()(GameWorldBase& world)
+    {
+        MapLoader loader(world);
+        BOOST_TEST_REQUIRE(loader.Load(*mapTemplate));
+        for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+            hqs.push_back(loader.GetHQPos(i));
+        return true;
+    }
+};
+std::shared_ptr<const MapTemplate> LoadWorldFromTemplateCreator::mapTemplate;
+
 using WorldLoadedWithS2MapFixture = WorldFixture<LoadWorldAndS2MapCreator>;
 using WorldLoaded1PFixture = WorldFixture<LoadWorldFromFileCreator, 1>;
 using WorldFixtureEmpty1P = WorldFixture<CreateEmptyWorld, 1>;
@@ -131,6 +153,25 @@ BOOST_FIXTURE_TEST_CASE(SameBQasInS2, WorldLoadedWithS2MapFixture)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(ParallelBQCalculation, WorldLoadedWithS2MapFixture)
+{
+    std::vector<MapPoint> bqChangedPts;
+    Subscription sub = world.GetNotifications().subscribe<NodeNote>([&bqChangedPts](const NodeNote& note) {
+        if(note.type == NodeNote::BQ)
+            bqChangedPts.push_back(note.pos);
+    });
+    world.InitAfterLoad(4);
+    // Notifications are sent in node order as for the serial calculation
+    BOOST_TEST_REQUIRE(!bqChangedPts.empty());
+    for(unsigned i = 1; i < bqChangedPts.size(); i++)
+        BOOST_TEST_REQUIRE(world.GetIdx(bqChangedPts[i - 1]) < world.GetIdx(bqChangedPts[i]));
+    // Serial calculation doesn't change anything
+    bqChangedPts.clear();
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        world.RecalcBQ(pt);
+    BOOST_TEST(bqChangedPts.empty());
+}
+
 BOOST_FIXTURE_TEST_CASE(HQPlacement, WorldLoaded1PFixture)
 {
     GamePlayer& player = world.GetPlayer(0);
@@ -139,6 +180,74 @@ BOOST_FIXTURE_TEST_CASE(HQPlacement, WorldLoaded1PFixture)
     BOOST_TEST_REQUIRE(world.GetNO(worldCreator.hqs[0])->GetGOT() == GO_Type::NobHq);
 }
 
+BOOST_AUTO_TEST_CASE(LoadFromTemplate)
+{
+    LoadWorldFromTemplateCreator::mapTemplate = MapLoader::CreateTemplate(testMapPath);
+    BOOST_TEST_REQUIRE(LoadWorldFromTemplateCreator::mapTemplate);
+    // Worlds can't exist at the same time, so store the relevant data of the one loaded from file
+    struct NodeData
+    {
+        unsigned char altitude, shadow;
+        unsigned t1, t2;
+        Resource resources;
+        unsigned short seaId;
+        unsigned harborId;
+        Visibility visibility;
+        GO_Type objType;
+    };
+    std::vector<NodeData> expectedNodes;
+    std::vector<MapPoint> expectedHarbors;
+    std::vector<unsigned> expectedSeaSizes;
+    std::vector<MapPoint> expectedHqs;
+    {
+        WorldLoaded1PFixture fixture;
+        const GameWorld& world = fixture.world;
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            const MapNode& node = world.GetNode(pt);
+            expectedNodes.push_back(NodeData{node.altitude, node.shadow, node.t1.value, node.t2.value, node.resources,
+                                             node.seaId, node.harborId, node.fow[0].visibility,
+                                             world.GetNO(pt)->GetGOT()});
+        }
+        for(unsigned i = 1; i <= world.GetNumHarborPoints(); i++)
+            expectedHarbors.push_back(world.GetHarborPoint(i));
+        for(unsigned i = 1; i <= world.GetNumSeas(); i++)
+            expectedSeaSizes.push_back(world.GetSeaSize(i));
+        expectedHqs = fixture.worldCreator.hqs;
+    }
+    // Load multiple times to check that the template is not modified
+    for(unsigned run = 0; run < 2; run++)
+    {
+        WorldFixture<LoadWorldFromTemplateCreator, 1> fixture;
+        const GameWorld& world = fixture.world;
+        BOOST_TEST_REQUIRE(world.GetWidth() == 176u);
+        BOOST_TEST_REQUIRE(world.GetHeight() == 80u);
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            BOOST_TEST_INFO("pt " << pt);
+            const MapNode& node = world.GetNode(pt);
+            const NodeData& expected = expectedNodes[world.GetIdx(pt)];
+            BOOST_TEST_REQUIRE(node.altitude == expected.altitude);
+            BOOST_TEST_REQUIRE(node.shadow == expected.shadow);
+            BOOST_TEST_REQUIRE(node.t1.value == expected.t1);
+            BOOST_TEST_REQUIRE(node.t2.value == expected.t2);
+            BOOST_TEST_REQUIRE(node.resources == expected.resources);
+            BOOST_TEST_REQUIRE(node.seaId == expected.seaId);
+            BOOST_TEST_REQUIRE(node.harborId == expected.harborId);
+            BOOST_TEST_REQUIRE(node.fow[0].visibility == expected.visibility);
+            BOOST_TEST_REQUIRE(world.GetNO(pt)->GetGOT() == expected.objType);
+        }
+        BOOST_TEST_REQUIRE(world.GetNumHarborPoints() == expectedHarbors.size());
+        for(unsigned i = 1; i <= world.GetNumHarborPoints(); i++)
+            BOOST_TEST(world.GetHarborPoint(i) == expectedHarbors[i - 1]);
+        BOOST_TEST_REQUIRE(world.GetNumSeas() == expectedSeaSizes.size());
+        for(unsigned i = 1; i <= world.GetNumSeas(); i++)
+            BOOST_TEST(world.GetSeaSize(i) == expectedSeaSizes[i - 1]);
+        BOOST_TEST(fixture.worldCreator.hqs == expectedHqs, boost::test_tools::per_element());
+    }
+    LoadWorldFromTemplateCreator::mapTemplate.reset();
+}
+
 BOOST_FIXTURE_TEST_CASE(CloseHarborSpots, WorldFixture<UninitializedWorldCreator>)
 {
     loadGameData(world.GetDescriptionWriteable());
@@ -247,6 +356,84 @@ BOOST_FIXTURE_TEST_CASE(NONothingOnEmptyNode, WorldFixtureEmpty1P)
     BOOST_TEST(world.GetGOT(emptySpot) == GO_Type::Nothing);
 }
 
+using WorldFixtureEmpty2P = WorldFixture<CreateEmptyWorld, 2>;
+BOOST_FIXTURE_TEST_CASE(FOWObjectsAreShared, WorldFixtureEmpty2P)
+{
+    const MapPoint treePos = world.GetNeighbour(world.GetPlayer(0).GetHQPos(), Direction::SouthWest);
+    const MapPoint sameTreePos = world.GetNeighbour(treePos, Direction::West);
+    const MapPoint otherTreePos = world.GetNeighbour(sameTreePos, Direction::West);
+    world.SetNO(treePos, new noTree(treePos, 0, 3));
+    world.SetNO(sameTreePos, new noTree(sameTreePos, 0, 3));
+    world.SetNO(otherTreePos, new noTree(otherTreePos, 1, 3));
+    for(const MapPoint pt : {treePos, sameTreePos, otherTreePos})
+    {
+        for(unsigned char player = 0; player < 2; player++)
+            world.SetVisibility(pt, player, Visibility::FogOfWar, 1);
+    }
+
+    const FOWObject* fowTree = world.GetNode(treePos).fow[0].object;
+    BOOST_TEST_REQUIRE(fowTree);
+    BOOST_TEST((fowTree->GetType() == FoW_Type::Tree));
+    // All players and nodes which saw the same share the object
+    BOOST_TEST(world.GetNode(treePos).fow[1].object == fowTree);
+    BOOST_TEST(world.GetNode(sameTreePos).fow[0].object == fowTree);
+    BOOST_TEST(world.GetNode(sameTreePos).fow[1].object == fowTree);
+    BOOST_TEST(world.GetNode(otherTreePos).fow[0].object != fowTree);
+    BOOST_TEST(world.GetNode(otherTreePos).fow[1].object == world.GetNode(otherTreePos).fow[0].object);
+
+    // Seeing the node again and losing sight yields the same object
+    world.SetVisibility(treePos, 0, Visibility::Visible);
+    BOOST_TEST(!world.GetNode(treePos).fow[0].object);
+    world.SetVisibility(treePos, 0, Visibility::FogOfWar, 2);
+    BOOST_TEST(world.GetNode(treePos).fow[0].object == fowTree);
+}
+
+BOOST_FIXTURE_TEST_CASE(BatchedBQUpdates, WorldFixtureEmpty1P)
+{
+    std::vector<MapPoint> bqChangedPts;
+    Subscription sub = world.GetNotifications().subscribe<NodeNote>([&bqChangedPts](const NodeNote& note) {
+        if(note.type == NodeNote::BQ)
+            bqChangedPts.push_back(note.pos);
+    });
+    // Each changed node must be notified once and the BQ must be the same as when calculating it from scratch
+    const auto checkBQs = [this, &bqChangedPts]() {
+        std::set<unsigned> notifiedIdxs;
+        for(const MapPoint pt : bqChangedPts)
+            BOOST_TEST(notifiedIdxs.insert(world.GetIdx(pt)).second);
+        bqChangedPts.clear();
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+            world.RecalcBQ(pt);
+        BOOST_TEST(bqChangedPts.empty());
+        bqChangedPts.clear();
+    };
+
+    const MapPoint hqFlagPt = world.GetNeighbour(world.GetPlayer(0).GetHQPos(), Direction::SouthEast);
+    const MapPoint flagPt = world.GetNeighbour(world.GetNeighbour(hqFlagPt, Direction::East), Direction::East);
+    {
+        GameWorldBase::BQUpdateBatch batch(world);
+        world.SetFlag(flagPt, 0);
+        BOOST_TEST_REQUIRE(world.GetNO(flagPt)->GetGOT() == GO_Type::Flag);
+        // Nested batches are fine too
+        {
+            GameWorldBase::BQUpdateBatch innerBatch(world);
+            world.RecalcBQAroundPointBig(flagPt);
+        }
+        // Deferred till the outermost batch ends
+        BOOST_TEST(bqChangedPts.empty());
+        BOOST_TEST(world.GetNode(flagPt).bq != BuildingQuality::Nothing);
+    }
+    BOOST_TEST(world.GetNode(flagPt).bq == BuildingQuality::Nothing);
+    checkBQs();
+
+    // Road building and destruction use batches internally
+    world.BuildRoad(0, false, hqFlagPt, std::vector<Direction>(2, Direction::East));
+    BOOST_TEST_REQUIRE(world.GetSpecObj<noFlag>(hqFlagPt)->GetRoute(Direction::East));
+    checkBQs();
+    world.DestroyFlag(flagPt, 0);
+    BOOST_TEST_REQUIRE(!world.GetSpecObj<noFlag>(hqFlagPt)->GetRoute(Direction::East));
+    checkBQs();
+}
+
 BOOST_FIXTURE_TEST_CASE(LoadLua, WorldFixture<UninitializedWorldCreator>)
 {
     MapLoader loader(world);
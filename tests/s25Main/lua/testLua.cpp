@@ -6,6 +6,7 @@
 #include "Loader.h"
 #include "PointOutput.h"
 #include "RttrForeachPt.h"
+#include "SerializedGameData.h"
 #include "buildings/noBuildingSite.h"
 #include "buildings/nobHQ.h"
 #include "enum_cast.hpp"
@@ -814,6 +815,83 @@ BOOST_AUTO_TEST_CASE(onExplored)
     }
 }
 
+BOOST_AUTO_TEST_CASE(BatchedWorldEvents)
+{
+    const MapPoint pt1(3, 4), pt2(5, 1);
+    LuaInterfaceGame& lua = world.GetLua();
+    executeLua("explored = {}\noccupied = {}\n"
+               "function onExploredBatch(player_id, points)\n"
+               "  for _, pt in ipairs(points) do\n"
+               "    table.insert(explored, player_id..':'..pt.x..','..pt.y..':'..tostring(pt.owner))\n"
+               "  end\n"
+               "end\n"
+               "function onOccupiedBatch(player_id, points)\n"
+               "  for _, pt in ipairs(points) do table.insert(occupied, player_id..':'..pt.x..','..pt.y) end\n"
+               "end");
+    // Handlers are plain globals
+    BOOST_TEST(isLuaEqual("type(rawget(_G, 'onExploredBatch'))", "'function'"));
+    lua.EventExplored(1, pt1, 0);
+    lua.EventExplored(1, pt2, 3);
+    lua.EventOccupied(0, pt2);
+    // Delivered at the end of the GF
+    BOOST_TEST(isLuaEqual("#explored", "0"));
+    BOOST_TEST(isLuaEqual("#occupied", "0"));
+    lua.EventGameFrame(1);
+    BOOST_TEST(isLuaEqual("table.concat(explored, ';')", "'1:3,4:nil;1:5,1:2'"));
+    BOOST_TEST(isLuaEqual("table.concat(occupied, ';')", "'0:5,1'"));
+    // Each point is delivered only once
+    lua.EventGameFrame(2);
+    BOOST_TEST(isLuaEqual("#explored", "2"));
+    BOOST_TEST(isLuaEqual("#occupied", "1"));
+
+    // Redefining a handler takes effect immediately
+    executeLua("function onExploredBatch(player_id, points) explored = {} end\n"
+               "function onOccupied(player_id, x, y) table.insert(occupied, 'single') end");
+    lua.EventExplored(0, pt1, 0);
+    lua.EventOccupied(0, pt1);
+    BOOST_TEST(isLuaEqual("occupied[#occupied]", "'single'"));
+    lua.EventGameFrame(3);
+    BOOST_TEST(isLuaEqual("#explored", "0"));
+    BOOST_TEST(isLuaEqual("occupied[#occupied]", "'0:3,4'"));
+    // Handlers can also be removed
+    executeLua("onExploredBatch = nil\nonOccupiedBatch = nil\nonOccupied = nil");
+    BOOST_TEST(isLuaEqual("onExploredBatch", "nil"));
+    lua.EventExplored(0, pt1, 0);
+    lua.EventOccupied(0, pt1);
+    lua.EventGameFrame(4);
+    BOOST_TEST(isLuaEqual("#occupied", "3"));
+}
+
+BOOST_AUTO_TEST_CASE(GameFrameInterval)
+{
+    LuaInterfaceGame& lua = world.GetLua();
+    executeLua("gfs = {}\nfunction onGameFrame(gf) table.insert(gfs, gf) end\nrttr:SetGameFrameInterval(5)");
+    for(unsigned gf = 0; gf < 12; gf++)
+        lua.EventGameFrame(gf);
+    BOOST_TEST(isLuaEqual("table.concat(gfs, ',')", "'0,5,10'"));
+    BOOST_REQUIRE_THROW(executeLua("rttr:SetGameFrameInterval(0)"), LuaExecutionError);
+}
+
+BOOST_AUTO_TEST_CASE(EventStateIsSerialized)
+{
+    const MapPoint pt(3, 4);
+    LuaInterfaceGame& lua = world.GetLua();
+    executeLua("gfs = {}\nfunction onGameFrame(gf) table.insert(gfs, gf) end\nrttr:SetGameFrameInterval(3)\n"
+               "explored = {}\nfunction onExploredBatch(player_id, points) table.insert(explored, #points) end");
+    lua.EventExplored(1, pt, 0);
+    lua.EventExplored(1, pt, 2);
+    SerializedGameData sgd;
+    lua.SerializeEventState(sgd);
+    // Deliver and reset everything, then restore from the saved state
+    lua.EventGameFrame(1);
+    executeLua("rttr:SetGameFrameInterval(1)\nexplored = {}");
+    lua.DeserializeEventState(sgd);
+    lua.EventGameFrame(2);
+    lua.EventGameFrame(3);
+    BOOST_TEST(isLuaEqual("table.concat(explored, ',')", "'2'"));
+    BOOST_TEST(isLuaEqual("table.concat(gfs, ',')", "'3'"));
+}
+
 BOOST_AUTO_TEST_CASE(LuaPacts)
 {
     initWorld();
@@ -6,7 +6,9 @@
 #include "helpers/containerUtils.h"
 #include "mapGenerator/Algorithms.h"
 #include <boost/test/unit_test.hpp>
+#include <cmath>
 #include <set>
+#include <vector>
 
 using namespace rttr::mapGenerator;
 
@@ -97,6 +99,97 @@ BOOST_AUTO_TEST_CASE(Smooth_interpolates_values_around_peak)
     }
 }
 
+BOOST_AUTO_TEST_CASE(KernelRows_match_points_in_radius)
+{
+    NodeMapBase<int> nodes;
+    nodes.Resize(MapExtent(32, 32));
+    const unsigned radius = 5;
+    BOOST_TEST_REQUIRE(CanUseKernelRows(nodes.GetSize(), radius));
+    for(const MapPoint pt : {MapPoint(0, 0), MapPoint(10, 11), MapPoint(31, 30)})
+    {
+        std::set<MapPoint, MapPointLess> expectedPts;
+        for(const MapPoint p : nodes.GetPointsInRadiusWithCenter(pt, radius))
+            expectedPts.insert(p);
+        std::set<MapPoint, MapPointLess> kernelPts;
+        for(const KernelRow& row : GetKernelRows(radius, (pt.y & 1) != 0))
+        {
+            for(unsigned i = 0; i < row.width; i++)
+            {
+                const Position curPos(pt.x + row.startOffset + static_cast<int>(i), pt.y + row.rowOffset);
+                kernelPts.insert(nodes.MakeMapPoint(curPos));
+            }
+        }
+        BOOST_TEST(kernelPts == expectedPts, boost::test_tools::per_element());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Smooth_matches_smoothing_over_points_in_radius)
+{
+    NodeMapBase<uint8_t> nodes;
+    nodes.Resize(MapExtent(40, 30));
+    RTTR_FOREACH_PT(MapPoint, nodes.GetSize())
+        nodes[pt] = static_cast<uint8_t>((pt.x * 37 + pt.y * 101 + pt.x * pt.y) % 256);
+    NodeMapBase<uint8_t> expected = nodes;
+
+    const unsigned radius = 6;
+    const unsigned iterations = 3;
+    for(unsigned i = 0; i < iterations; ++i)
+    {
+        RTTR_FOREACH_PT(MapPoint, expected.GetSize())
+        {
+            int sum = expected[pt];
+            const auto neighbors = expected.GetPointsInRadius(pt, radius);
+            for(const MapPoint& p : neighbors)
+                sum += expected[p];
+            expected[pt] = static_cast<uint8_t>(round(static_cast<double>(sum) / (neighbors.size() + 1)));
+        }
+    }
+
+    Smooth(iterations, radius, nodes);
+
+    RTTR_FOREACH_PT(MapPoint, nodes.GetSize())
+    {
+        BOOST_TEST_INFO(pt);
+        BOOST_TEST_REQUIRE(nodes[pt] == expected[pt]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SmoothParallel_is_independent_of_thread_count)
+{
+    for(const MapExtent size : {MapExtent(16, 8), MapExtent(40, 30)})
+    {
+        NodeMapBase<uint8_t> nodes;
+        nodes.Resize(size);
+        RTTR_FOREACH_PT(MapPoint, size)
+            nodes[pt] = static_cast<uint8_t>((pt.x * 37 + pt.y * 101 + pt.x * pt.y) % 256);
+        NodeMapBase<uint8_t> nodesSingleThreaded = nodes;
+        // Double buffered smoothing over the points in the radius
+        NodeMapBase<uint8_t> expected = nodes;
+        for(unsigned i = 0; i < 2; ++i)
+        {
+            const NodeMapBase<uint8_t> src = expected;
+            RTTR_FOREACH_PT(MapPoint, size)
+            {
+                int sum = src[pt];
+                const auto neighbors = src.GetPointsInRadius(pt, 4);
+                for(const MapPoint& p : neighbors)
+                    sum += src[p];
+                expected[pt] = static_cast<uint8_t>(round(static_cast<double>(sum) / (neighbors.size() + 1)));
+            }
+        }
+
+        SmoothParallel(2, 4, nodesSingleThreaded, 1);
+        SmoothParallel(2, 4, nodes, 3);
+
+        BOOST_TEST(std::vector<uint8_t>(nodesSingleThreaded.begin(), nodesSingleThreaded.end())
+                     == std::vector<uint8_t>(expected.begin(), expected.end()),
+                   boost::test_tools::per_element());
+        BOOST_TEST(std::vector<uint8_t>(nodes.begin(), nodes.end())
+                     == std::vector<uint8_t>(nodesSingleThreaded.begin(), nodesSingleThreaded.end()),
+                   boost::test_tools::per_element());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(Scale_updates_minimum_and_maximum_values_correctly)
 {
     MapExtent size(16, 8);
@@ -197,6 +290,55 @@ BOOST_AUTO_TEST_CASE(Collect_returns_only_connected_positive_map_points)
     }
 }
 
+BOOST_AUTO_TEST_CASE(Collect_with_shared_visited_set_finds_each_area_once)
+{
+    NodeMapBase<int> map;
+    map.Resize(MapExtent(16, 16), 0);
+    const MapPoint point(4, 4);
+    const MapPoint other(12, 12);
+    for(const MapPoint pt : {point, other})
+    {
+        map[pt] = 1;
+        for(const MapPoint neighbor : map.GetNeighbours(pt))
+            map[neighbor] = 1;
+    }
+    const auto evaluator = [&map](const MapPoint& p) { return map[p] != 0; };
+
+    NodeSet visited(map.GetSize());
+    std::vector<std::vector<MapPoint>> areas;
+    RTTR_FOREACH_PT(MapPoint, map.GetSize())
+    {
+        if(visited.contains(pt))
+            continue;
+        auto area = Collect(map, pt, evaluator, visited);
+        if(!area.empty())
+            areas.push_back(area);
+    }
+
+    BOOST_TEST_REQUIRE(areas.size() == 2u);
+    for(const auto& area : areas)
+        BOOST_TEST(area.size() == 7u);
+    // All points were evaluated exactly once
+    BOOST_TEST(visited.size() == 16u * 16u);
+    // Same area as without the shared set, also in the same (BFS) order
+    BOOST_TEST(Collect(map, areas[0].front(), evaluator) == areas[0], boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(NodeSet_keeps_insertion_order_without_duplicates)
+{
+    NodeSet nodes(MapExtent(8, 6));
+    BOOST_TEST(nodes.empty());
+    BOOST_TEST(nodes.insert(MapPoint(7, 5)));
+    BOOST_TEST(nodes.insert(MapPoint(0, 0)));
+    BOOST_TEST(!nodes.insert(MapPoint(7, 5)));
+    nodes.insert(std::vector<MapPoint>{MapPoint(3, 2), MapPoint(0, 0)});
+
+    const std::vector<MapPoint> expected{MapPoint(7, 5), MapPoint(0, 0), MapPoint(3, 2)};
+    BOOST_TEST(nodes.points() == expected, boost::test_tools::per_element());
+    BOOST_TEST(nodes.contains(MapPoint(3, 2)));
+    BOOST_TEST(!nodes.contains(MapPoint(2, 3)));
+}
+
 BOOST_AUTO_TEST_CASE(DistancesTo_with_predicate_returns_expected_distance_for_each_map_point)
 {
     MapExtent size(9, 8);
@@ -0,0 +1,58 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "mapGenFixtures.h"
+#include "mapGenerator/MapStatistics.h"
+#include "mapGenerator/TextureHelper.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace rttr::mapGenerator;
+
+BOOST_FIXTURE_TEST_SUITE(MapStatisticsTests, MapGenFixture)
+
+BOOST_AUTO_TEST_CASE(GetMapStatistics_for_land_map_counts_all_nodes_as_land_and_reachable)
+{
+    Map map = createMap(MapExtent(16, 16), 2);
+    map.getTextures().Resize(map.size, TexturePair(map.textureMap.Find(IsBuildableLand)));
+    map.hqPositions = {MapPoint(2, 2), MapPoint(10, 10)};
+
+    const MapStatistics stats = GetMapStatistics(map);
+
+    BOOST_TEST(stats.numLandNodes == 16u * 16u);
+    BOOST_TEST(stats.numWaterNodes == 0u);
+    BOOST_TEST(stats.GetLandRatio() == 1.);
+    BOOST_TEST(stats.numHarbors == 0u);
+    BOOST_TEST(stats.minHqDistance == map.z.CalcDistance(MapPoint(2, 2), MapPoint(10, 10)));
+    BOOST_TEST(stats.maxHqDistance == stats.minHqDistance);
+    BOOST_TEST(stats.reachableNodes == std::vector<unsigned>(2, 16u * 16u), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(GetMapStatistics_reports_separated_areas_per_player)
+{
+    Map map = createMap(MapExtent(16, 16), 3);
+    map.getTextures().Resize(map.size, TexturePair(map.textureMap.Find(IsBuildableLand)));
+    const auto water = TexturePair(map.textureMap.Find(IsWater));
+    // Two land strips separated by water strips
+    RTTR_FOREACH_PT(MapPoint, map.size)
+    {
+        if(pt.x < 4 || (pt.x >= 8 && pt.x < 12))
+            map.getTextures()[pt] = water;
+    }
+    map.hqPositions = {MapPoint(5, 2), MapPoint(13, 2), MapPoint(6, 12)};
+
+    const MapStatistics stats = GetMapStatistics(map);
+
+    BOOST_TEST(stats.numWaterNodes > 0u);
+    BOOST_TEST(stats.numLandNodes + stats.numWaterNodes == 16u * 16u);
+    BOOST_TEST(stats.GetLandRatio() < 1.);
+    BOOST_TEST_REQUIRE(stats.reachableNodes.size() == 3u);
+    // Strips are symmetric and the first and last player share a strip
+    BOOST_TEST(stats.reachableNodes[0] == stats.reachableNodes[1]);
+    BOOST_TEST(stats.reachableNodes[0] == stats.reachableNodes[2]);
+    BOOST_TEST(stats.reachableNodes[0] + stats.reachableNodes[1] == stats.numLandNodes);
+    BOOST_TEST(stats.minHqDistance == map.z.CalcDistance(MapPoint(5, 2), MapPoint(6, 12)));
+    BOOST_TEST(stats.maxHqDistance == map.z.CalcDistance(MapPoint(13, 2), MapPoint(6, 12)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,7 +12,10 @@
 #include "libsiedler2/libsiedler2.h"
 #include "rttr/test/TmpFolder.hpp"
 #include "rttr/test/random.hpp"
+#include <boost/nowide/fstream.hpp>
 #include <boost/test/unit_test.hpp>
+#include <iterator>
+#include <string>
 
 using namespace rttr::mapGenerator;
 
@@ -174,4 +177,25 @@ BOOST_AUTO_TEST_CASE(GenerateRandomMap_returns_valid_mapfile_with_max_players)
     }
 }
 
+BOOST_AUTO_TEST_CASE(CreateRandomMap_with_same_seed_creates_same_map)
+{
+    rttr::test::TmpFolder tmpFolder;
+
+    MapSettings settings;
+    settings.size = MapExtent(32, 32);
+    settings.numPlayers = 2;
+    settings.style = MapStyle::Mixed;
+
+    const auto readFile = [](const boost::filesystem::path& filePath) {
+        boost::nowide::ifstream file(filePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    CreateRandomMap(tmpFolder.get() / "map1.swd", settings, 42);
+    CreateRandomMap(tmpFolder.get() / "map2.swd", settings, 42);
+    const std::string map1 = readFile(tmpFolder.get() / "map1.swd");
+    BOOST_TEST(!map1.empty());
+    BOOST_TEST(map1 == readFile(tmpFolder.get() / "map2.swd"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
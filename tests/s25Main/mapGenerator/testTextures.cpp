@@ -146,7 +146,8 @@ BOOST_FIXTURE_TEST_CASE(ReplaceTextures_replaces_textures_within_radius, Texture
     for(unsigned radius = 0; radius < 4; radius++)
     {
         textures.Resize(textures.GetSize(), source);
-        std::set<MapPoint, MapPointLess> nodes(points);
+        NodeSet nodes(textures.GetSize());
+        nodes.insert(points);
 
         ReplaceTextures(textures, radius, nodes, target, {});
 
@@ -179,7 +180,8 @@ BOOST_FIXTURE_TEST_CASE(ReplaceTextures_does_not_replace_excluded_textures, Text
     for(unsigned radius = 0; radius < 4; radius++)
     {
         textures.Resize(textures.GetSize(), source);
-        std::set<MapPoint, MapPointLess> nodes(points);
+        NodeSet nodes(textures.GetSize());
+        nodes.insert(points);
 
         ReplaceTextures(textures, radius, nodes, target, {source});
 
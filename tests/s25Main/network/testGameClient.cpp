@@ -10,6 +10,7 @@
 #include "network/GameClient.h"
 #include "network/GameMessage.h"
 #include "network/GameMessages.h"
+#include "network/MapCache.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "test/testConfig.h"
 #include "rttr/test/LogAccessor.hpp"
@@ -118,7 +119,8 @@ BOOST_DATA_TEST_CASE(ClientFollowsConnectProtocol, usesLuaScriptValues, usesLuaS
         MOCK_EXPECT(callbacks.CI_NextConnectState).with(ConnectState::ReceiveMap).once();
         clientMsgInterface.OnGameMessage(GameMessage_Map_Info(testMapPath.filename().string(), MapType::OldMap,
                                                               mapInfo.mapData.uncompressedLength, mapDataSize,
-                                                              mapInfo.luaData.uncompressedLength, luaDataSize));
+                                                              mapInfo.luaData.uncompressedLength, luaDataSize,
+                                                              mapInfo.mapChecksum, mapInfo.luaChecksum));
         const auto msg = boost::dynamic_pointer_cast<GameMessage_MapRequest>(client.GetMainPlayer().sendQueue.pop());
         BOOST_TEST_REQUIRE(msg);
         BOOST_TEST(!msg->requestInfo);
@@ -210,7 +212,8 @@ BOOST_AUTO_TEST_CASE(ClientDetectsMapBufferOverflow)
 
     const auto mapDataSize = rttr::test::randomValue(10u, 100u);
     std::vector<char> mapData(mapDataSize);
-    clientMsgInterface.OnGameMessage(GameMessage_Map_Info("testMap.swd", MapType::OldMap, 500u, mapDataSize, 0, 0));
+    clientMsgInterface.OnGameMessage(
+      GameMessage_Map_Info("testMap.swd", MapType::OldMap, 500u, mapDataSize, 0, 0, 42u, 0));
     // First part of map
     MOCK_EXPECT(callbacks.CI_MapPartReceived).in(s).with(10u, mapDataSize).once();
     clientMsgInterface.OnGameMessage(GameMessage_Map_Data(true, 0, mapData.data(), 10));
@@ -223,4 +226,50 @@ BOOST_AUTO_TEST_CASE(ClientDetectsMapBufferOverflow)
     BOOST_TEST(client.GetState() == ClientState::Stopped);
 }
 
+BOOST_AUTO_TEST_CASE(ClientUsesCachedMap)
+{
+    GameClient client;
+    GameMessageInterface& clientMsgInterface = client;
+    MockClientInterface callbacks;
+    client.SetInterface(&callbacks);
+    TestServer server;
+    const auto serverPort = server.tryListen();
+    BOOST_TEST_REQUIRE(serverPort >= 0);
+    const auto pw = rttr::test::randString(10);
+    const auto serverType = rttr::test::randomEnum<ServerType>();
+    mock::sequence s;
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::Initiated).once();
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::VerifyServer).once();
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::QueryPw).once();
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::QueryMapInfo).once();
+    // No transfer but directly verify the map
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::VerifyMap).once();
+
+    BOOST_TEST_REQUIRE(client.Connect("localhost", pw, serverType, serverPort, false, false));
+    clientMsgInterface.OnGameMessage(GameMessage_Player_Id(1));
+    clientMsgInterface.OnGameMessage(GameMessage_Server_TypeOK(GameMessage_Server_TypeOK::StatusCode::Ok, ""));
+    clientMsgInterface.OnGameMessage(GameMessage_Server_Password("true"));
+
+    const boost::filesystem::path testMapPath =
+      rttr::test::rttrBaseDir / "tests" / "testData" / "maps" / "LuaFunctions.SWD";
+    MapInfo mapInfo;
+    mapInfo.mapData.CompressFromFile(testMapPath, &mapInfo.mapChecksum);
+    const MapCache::Key key{mapInfo.mapData.uncompressedLength, static_cast<unsigned>(mapInfo.mapData.data.size()),
+                            mapInfo.mapChecksum};
+    BOOST_TEST_REQUIRE(MapCache(RTTRCONFIG.ExpandPath(s25::folders::cache) / "maps").add(key, testMapPath));
+
+    // Map is known under a different name
+    clientMsgInterface.OnGameMessage(GameMessage_Map_Info("renamedMap.swd", MapType::OldMap, key.length,
+                                                          key.compressedLength, 0, 0, key.checksum, 0));
+    // Skip the messages sent before
+    auto& sendQueue = client.GetMainPlayer().sendQueue;
+    decltype(sendQueue.pop()) lastMsg;
+    while(!sendQueue.empty())
+        lastMsg = sendQueue.pop();
+    const auto msg = boost::dynamic_pointer_cast<GameMessage_Map_Checksum>(std::move(lastMsg));
+    BOOST_TEST_REQUIRE(msg);
+    BOOST_TEST(msg->mapChecksum == mapInfo.mapChecksum);
+    BOOST_TEST(bfs::exists(RTTRCONFIG.ExpandPath(s25::folders::mapsPlayed) / "renamedMap.swd"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
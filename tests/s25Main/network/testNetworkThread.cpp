@@ -0,0 +1,116 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "TestServer.h"
+#include "network/GameMessage.h"
+#include "network/GameMessages.h"
+#include "network/NetworkPlayer.h"
+#include "network/NetworkThread.h"
+#include "gameTypes/GameTypesOutput.h"
+#include <boost/pointer_cast.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+namespace {
+class GameTestServer : public TestServer
+{
+public:
+    Connection acceptConnection(unsigned /*id*/, const Socket& so) override
+    {
+        return Connection(GameMessage::create_game, so);
+    }
+};
+
+/// Wait until the predicate is true or a timeout occurs. Return the value of the predicate
+template<class T_Pred>
+bool waitFor(T_Pred&& predicate)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while(!predicate())
+    {
+        if(std::chrono::steady_clock::now() > timeout)
+            return false; // LCOV_EXCL_LINE
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(NetworkThreadSuite)
+
+BOOST_AUTO_TEST_CASE(ExchangesMessagesWithServer)
+{
+    GameTestServer server;
+    const auto serverPort = server.tryListen();
+    BOOST_TEST_REQUIRE(serverPort >= 0);
+
+    NetworkThread networkThread;
+    NetworkPlayer player(0);
+    BOOST_TEST_REQUIRE(player.socket.Connect("localhost", serverPort, false));
+    BOOST_TEST_REQUIRE(server.run(true));
+    BOOST_TEST_REQUIRE(server.connections.size() == 1u);
+    Connection& serverCon = server.connections.front();
+
+    player.attachToNetworkThread(networkThread);
+    BOOST_TEST(player.usesNetworkThread());
+    BOOST_TEST(networkThread.getNumConnections() == 1u);
+
+    // Client -> Server: Game thread only passes the message to the network thread
+    player.sendMsgAsync(new GameMessage_Server_Type(ServerType::Local, "1234"));
+    player.sendMsgAsync(new GameMessage_Pong());
+    BOOST_TEST(player.sendMsgs(1));
+    BOOST_TEST(player.sendQueue.empty());
+    const auto serverReceived = [&]() {
+        server.run();
+        return !serverCon.recvQueue.empty();
+    };
+    BOOST_TEST_REQUIRE(waitFor(serverReceived));
+    {
+        const auto msg = boost::dynamic_pointer_cast<GameMessage_Server_Type>(serverCon.recvQueue.pop());
+        BOOST_TEST_REQUIRE(msg);
+        BOOST_TEST(msg->type == ServerType::Local);
+        BOOST_TEST(msg->revision == "1234");
+    }
+    BOOST_TEST_REQUIRE(waitFor(serverReceived));
+    BOOST_TEST(dynamic_cast<GameMessage_Pong*>(serverCon.recvQueue.pop().get()));
+
+    // Server -> Client: Messages are received without the game thread
+    serverCon.sendQueue.push(new GameMessage_Ping(1));
+    server.run();
+    BOOST_TEST_REQUIRE(waitFor([&]() {
+        BOOST_TEST_REQUIRE(player.receiveMsgs());
+        return !player.recvQueue.empty();
+    }));
+    BOOST_TEST(dynamic_cast<GameMessage_Ping*>(player.recvQueue.pop().get()));
+    BOOST_TEST(player.recvQueue.empty());
+
+    // Connection loss is reported on receive
+    server.stop();
+    BOOST_TEST(waitFor([&]() { return !player.receiveMsgs(); }));
+
+    // Closing detaches from the thread
+    player.closeConnection();
+    BOOST_TEST(!player.usesNetworkThread());
+    BOOST_TEST(networkThread.getNumConnections() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(DropsConnectionsOfDestroyedPlayers)
+{
+    GameTestServer server;
+    const auto serverPort = server.tryListen();
+    BOOST_TEST_REQUIRE(serverPort >= 0);
+
+    NetworkThread networkThread;
+    {
+        NetworkPlayer player(0);
+        BOOST_TEST_REQUIRE(player.socket.Connect("localhost", serverPort, false));
+        BOOST_TEST_REQUIRE(server.run(true));
+        player.attachToNetworkThread(networkThread);
+        BOOST_TEST(networkThread.getNumConnections() == 1u);
+    }
+    BOOST_TEST(waitFor([&]() { return networkThread.getNumConnections() == 0u; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkReport.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <sstream>
+
+using std::chrono::milliseconds;
+
+BOOST_AUTO_TEST_SUITE(BenchmarkReportSuite)
+
+BOOST_AUTO_TEST_CASE(CalculatesPercentiles)
+{
+    {
+        const BenchmarkReport::Statistics stats = BenchmarkReport::getStatistics({});
+        BOOST_TEST((stats.min == milliseconds::zero() && stats.p99 == milliseconds::zero()));
+    }
+    // 1..100ms shuffled
+    std::vector<BenchmarkReport::clock::duration> durations;
+    for(int i = 100; i > 0; i -= 2)
+        durations.push_back(milliseconds(i));
+    for(int i = 1; i < 100; i += 2)
+        durations.push_back(milliseconds(i));
+    const BenchmarkReport::Statistics stats = BenchmarkReport::getStatistics(durations);
+    BOOST_TEST((stats.min == milliseconds(1)));
+    BOOST_TEST((stats.median == milliseconds(50)));
+    BOOST_TEST((stats.p95 == milliseconds(95)));
+    BOOST_TEST((stats.p99 == milliseconds(99)));
+    BOOST_TEST((stats.max == milliseconds(100)));
+    BOOST_TEST((stats.mean == std::chrono::microseconds(50500)));
+
+    const BenchmarkReport::Statistics single = BenchmarkReport::getStatistics({milliseconds(7)});
+    BOOST_TEST((single.min == milliseconds(7) && single.median == milliseconds(7) && single.p99 == milliseconds(7)));
+}
+
+BOOST_AUTO_TEST_CASE(SeparatesSimulationAndDrawTime)
+{
+    BenchmarkReport report;
+    report.startTest("game", 100);
+    report.addFrame(milliseconds(10), milliseconds(4), 2);
+    report.addFrame(milliseconds(20), milliseconds(6), 3);
+    report.finishTest();
+    report.startTest("text", 50);
+    report.addFrame(milliseconds(5));
+    report.finishTest();
+
+    BOOST_TEST_REQUIRE(report.getTests().size() == 2u);
+    const BenchmarkReport::Test& game = report.getTests()[0];
+    BOOST_TEST(game.name == "game");
+    BOOST_TEST(game.numInstances == 100);
+    BOOST_TEST(game.numGFs == 5u);
+    BOOST_TEST((game.getTotalTime() == milliseconds(30)));
+    BOOST_TEST((game.getTotalSimTime() == milliseconds(10)));
+    const std::vector<BenchmarkReport::clock::duration> expectedDrawTimes{milliseconds(6), milliseconds(14)};
+    BOOST_TEST((game.getDrawTimes() == expectedDrawTimes));
+    BOOST_TEST(game.getGFsPerSecond() == 500., boost::test_tools::tolerance(1e-6));
+    BOOST_TEST(game.peakMemoryUsage > 0u);
+    BOOST_TEST(report.getTests()[1].getGFsPerSecond() == 0.);
+
+    std::ostringstream s;
+    report.WriteJSON(s);
+    const std::string json = s.str();
+    BOOST_TEST(json.find("\"name\": \"game\"") != std::string::npos);
+    BOOST_TEST(json.find("\"gfsPerSecond\": 500") != std::string::npos);
+    BOOST_TEST(json.find("\"drawFrameMs\": {\"min\": 6, \"median\": 6, \"p95\": 14, \"p99\": 14, "
+                         "\"max\": 14, \"mean\": 10}")
+               != std::string::npos);
+    BOOST_TEST(json.find("\"name\": \"text\"") != std::string::npos);
+    // Balanced braces
+    BOOST_TEST(std::count(json.begin(), json.end(), '{') == std::count(json.begin(), json.end(), '}'));
+    BOOST_TEST(std::count(json.begin(), json.end(), '[') == std::count(json.begin(), json.end(), ']'));
+
+    report.Clear();
+    s.str("");
+    report.WriteJSON(s);
+    BOOST_TEST(s.str().find("\"tests\": []") != std::string::npos);
+
+    // Clearing also discards a running test
+    report.startTest("game", 100);
+    report.addFrame(milliseconds(10));
+    report.Clear();
+    s.str("");
+    report.WriteJSON(s);
+    BOOST_TEST(s.str().find("\"tests\": []") != std::string::npos);
+    report.startTest("text", 50);
+    report.addFrame(milliseconds(5));
+    report.finishTest();
+    BOOST_TEST_REQUIRE(report.getTests().size() == 1u);
+    BOOST_TEST(report.getTests()[0].name == "text");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gameTypes/CompressedData.h"
+#include "rttr/test/random.hpp"
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+/// Data of the given size which is only partly compressible
+std::vector<char> createData(size_t size)
+{
+    std::vector<char> data(size);
+    for(size_t i = 0; i < size; i++)
+        data[i] = (i % 4u == 0u) ? static_cast<char>(rttr::test::randomValue<int>(-128, 127)) : static_cast<char>(i);
+    return data;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(CompressedDataSuite)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+    // Empty, single chunk and multiple chunks (chunk size is 64KiB) for in- and output
+    for(const size_t size : {0u, 1000u, 1024u * 1024u})
+    {
+        const std::vector<char> data = createData(size);
+        const std::vector<char> compressed = CompressedData::compress(data);
+        BOOST_TEST(!compressed.empty());
+        BOOST_TEST(CompressedData::decompress(compressed, size) == data, boost::test_tools::per_element());
+
+        // Chunk-wise decompression yields the data in order
+        std::vector<char> decompressed;
+        unsigned numChunks = 0;
+        const auto onChunk = [&](const char* chunk, size_t chunkSize) {
+            BOOST_TEST(chunkSize > 0u);
+            decompressed.insert(decompressed.end(), chunk, chunk + chunkSize);
+            ++numChunks;
+        };
+        CompressedData::decompress(compressed.data(), compressed.size(), size, onChunk);
+        BOOST_TEST(decompressed == data, boost::test_tools::per_element());
+        if(size == 0u)
+            BOOST_TEST(numChunks == 0u);
+        else if(size == 1000u)
+            BOOST_TEST(numChunks == 1u);
+        else
+            BOOST_TEST(numChunks > 1u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedInputThrows)
+{
+    const size_t size = 1024u * 1024u;
+    const std::vector<char> compressed = CompressedData::compress(createData(size));
+    for(const size_t truncatedSize : {size_t(0), compressed.size() / 2u, compressed.size() - 1u})
+    {
+        const std::vector<char> truncated(compressed.begin(), compressed.begin() + truncatedSize);
+        BOOST_CHECK_THROW(CompressedData::decompress(truncated, size), std::runtime_error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LengthMismatchThrows)
+{
+    for(const size_t size : {1000u, 1024u * 1024u})
+    {
+        const std::vector<char> compressed = CompressedData::compress(createData(size));
+        BOOST_CHECK_THROW(CompressedData::decompress(compressed, size - 1u), std::runtime_error);
+        BOOST_CHECK_THROW(CompressedData::decompress(compressed, size + 1u), std::runtime_error);
+    }
+    // Empty data
+    const std::vector<char> compressed = CompressedData::compress(std::vector<char>());
+    BOOST_CHECK_THROW(CompressedData::decompress(compressed, 1u), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
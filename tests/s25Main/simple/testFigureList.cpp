@@ -0,0 +1,90 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "nodeObjs/FigureList.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace {
+class DummyFigure final : public noBase
+{
+public:
+    explicit DummyFigure(unsigned& numAlive) : noBase(NodalObjectType::Figure), numAlive_(numAlive) { ++numAlive_; }
+    ~DummyFigure() override { --numAlive_; }
+    // LCOV_EXCL_START
+    void Draw(DrawPoint) override {}
+    void Destroy() override {}
+    void Serialize(SerializedGameData&) const override {}
+    GO_Type GetGOT() const override { return GO_Type::Animal; }
+    // LCOV_EXCL_STOP
+
+private:
+    unsigned& numAlive_;
+};
+
+std::vector<const noBase*> toVector(const FigureList& list)
+{
+    std::vector<const noBase*> result;
+    for(const noBase* fig : list)
+        result.push_back(fig);
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FigureListSuite)
+
+BOOST_AUTO_TEST_CASE(KeepsInsertionOrder)
+{
+    unsigned numAlive = 0;
+    {
+        FigureList list;
+        BOOST_TEST(list.empty());
+        BOOST_TEST(list.size() == 0u);
+        BOOST_TEST((list.begin() == list.end()));
+
+        std::vector<const noBase*> figs;
+        for(unsigned i = 0; i < 4; i++)
+        {
+            auto fig = std::make_unique<DummyFigure>(numAlive);
+            figs.push_back(fig.get());
+            list.push_back(std::move(fig));
+        }
+        BOOST_TEST(!list.empty());
+        BOOST_TEST(list.size() == 4u);
+        BOOST_TEST(*list.begin() == figs[0]);
+        BOOST_TEST(toVector(list) == figs, boost::test_tools::per_element());
+        for(const noBase* fig : figs)
+            BOOST_TEST(list.contains(*fig));
+
+        // Remove from the middle, front and back
+        for(unsigned idx : {2u, 0u, 3u})
+        {
+            std::unique_ptr<noBase> removed = list.remove(const_cast<noBase&>(*figs[idx]));
+            BOOST_TEST(removed.get() == figs[idx]);
+            BOOST_TEST(!list.contains(*removed));
+            // Can be added again (to the end)
+            if(idx == 2u)
+                list.push_back(std::move(removed));
+        }
+        BOOST_TEST(numAlive == 2u);
+        BOOST_TEST(toVector(list) == std::vector<const noBase*>({figs[1], figs[2]}), boost::test_tools::per_element());
+
+        // Iterators to other elements stay valid when removing
+        auto it = list.begin();
+        std::unique_ptr<noBase> removed = list.remove(const_cast<noBase&>(*figs[2]));
+        BOOST_TEST(*it == figs[1]);
+        BOOST_TEST((++it == list.end()));
+
+        FigureList movedList(std::move(list));
+        BOOST_TEST(list.empty()); //-V1001
+        BOOST_TEST(movedList.size() == 1u);
+        list = std::move(movedList);
+        BOOST_TEST(list.size() == 1u);
+        BOOST_TEST(*list.begin() == figs[1]);
+    }
+    // List owns the figures
+    BOOST_TEST(numAlive == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,120 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "FramesInfo.h"
+#include <boost/test/unit_test.hpp>
+
+namespace {
+struct CatchUpFixture
+{
+    FramesInfoClient framesInfo;
+    /// In the future so the time spent running the GFs never exceeds the GF length
+    const FramesInfo::UsedClock::time_point currentTime = FramesInfo::UsedClock::now() + std::chrono::hours(1);
+    unsigned skipToGF = 0;
+    unsigned curGF = 0;
+
+    /// Run the due GFs and return how many were run
+    unsigned runDueGFs()
+    {
+        const unsigned startGF = curGF;
+        framesInfo.RunDueGFs(
+          currentTime, [this]() { return skipToGF > curGF; },
+          [this](bool isSkipping) {
+              if(isSkipping)
+                  framesInfo.lastTime = currentTime;
+              else
+                  framesInfo.lastTime += framesInfo.gf_length;
+              ++curGF;
+              return true;
+          });
+        return curGF - startGF;
+    }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FramesInfoSuite)
+
+BOOST_FIXTURE_TEST_CASE(RunsDueGFsUpToLimit, CatchUpFixture)
+{
+    // Nothing due
+    framesInfo.lastTime = currentTime - framesInfo.gf_length / 2;
+    BOOST_TEST(runDueGFs() == 0u);
+    // Some GFs due -> Run all
+    framesInfo.lastTime = currentTime - 3 * framesInfo.gf_length;
+    BOOST_TEST(runDueGFs() == 3u);
+    BOOST_TEST((currentTime - framesInfo.lastTime < framesInfo.gf_length));
+    // Far behind -> Run at most MAX_CATCHUP_GFS per call
+    framesInfo.lastTime = currentTime - 100 * framesInfo.gf_length;
+    BOOST_TEST(runDueGFs() == FramesInfoClient::MAX_CATCHUP_GFS);
+    BOOST_TEST(runDueGFs() == FramesInfoClient::MAX_CATCHUP_GFS);
+    const unsigned numRemainingGFs = 100 - 2 * FramesInfoClient::MAX_CATCHUP_GFS;
+    BOOST_TEST((currentTime - framesInfo.lastTime == numRemainingGFs * framesInfo.gf_length));
+}
+
+BOOST_FIXTURE_TEST_CASE(RunsOneGFPerCallWhenSkipping, CatchUpFixture)
+{
+    framesInfo.lastTime = currentTime;
+    skipToGF = 3;
+    BOOST_TEST(runDueGFs() == 1u);
+    BOOST_TEST(runDueGFs() == 1u);
+    BOOST_TEST(runDueGFs() == 1u);
+    // Target reached and nothing due
+    BOOST_TEST(runDueGFs() == 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(StopsWhenPausedOrGFFails, CatchUpFixture)
+{
+    framesInfo.lastTime = currentTime - 5 * framesInfo.gf_length;
+    framesInfo.isPaused = true;
+    BOOST_TEST(runDueGFs() == 1u);
+    framesInfo.isPaused = false;
+
+    unsigned numCalls = 0;
+    const bool result = framesInfo.RunDueGFs(
+      currentTime, []() { return false; },
+      [&numCalls](bool) {
+          ++numCalls;
+          return false;
+      });
+    BOOST_TEST(!result);
+    BOOST_TEST(numCalls == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(FrameTimeIsClampedForDrawing)
+{
+    using std::chrono::milliseconds;
+    FramesInfoClient framesInfo;
+    const FramesInfo::UsedClock::time_point lastTime = FramesInfo::UsedClock::now();
+    framesInfo.lastTime = lastTime;
+    BOOST_TEST(framesInfo.GetFrameTimeAt(lastTime).count() == 0u);
+    BOOST_TEST(framesInfo.GetFrameTimeAt(lastTime - milliseconds(1)).count() == 0u);
+    BOOST_TEST(framesInfo.GetFrameTimeAt(lastTime + milliseconds(5)).count() == 5u);
+    // The simulation is behind -> Never report a full GF
+    const unsigned maxFrameTime = framesInfo.gf_length.count() - 1u;
+    BOOST_TEST(framesInfo.GetFrameTimeAt(lastTime + 3 * framesInfo.gf_length).count() == maxFrameTime);
+    BOOST_TEST(framesInfo.GetFrameTimeAt(lastTime + std::chrono::hours(24 * 100)).count() == maxFrameTime);
+}
+
+BOOST_AUTO_TEST_CASE(NextGFTimeRespectsPauses)
+{
+    using std::chrono::milliseconds;
+    FramesInfoClient framesInfo;
+    const FramesInfo::UsedClock::time_point currentTime = FramesInfo::UsedClock::now();
+    framesInfo.lastTime = currentTime - milliseconds(5);
+    BOOST_TEST((framesInfo.GetNextGFTime(currentTime, milliseconds(100)) == framesInfo.lastTime + framesInfo.gf_length));
+    // Limited by the maximum waiting time
+    BOOST_TEST((framesInfo.GetNextGFTime(currentTime, milliseconds(2)) == currentTime + milliseconds(2)));
+    // Already due
+    framesInfo.lastTime = currentTime - 2 * framesInfo.gf_length;
+    BOOST_TEST((framesInfo.GetNextGFTime(currentTime, milliseconds(100)) < currentTime));
+
+    framesInfo.forcePauseStart = currentTime;
+    framesInfo.forcePauseLen = milliseconds(50);
+    BOOST_TEST((framesInfo.GetNextGFTime(currentTime, milliseconds(100)) == currentTime + milliseconds(50)));
+
+    framesInfo.isPaused = true;
+    BOOST_TEST((framesInfo.GetNextGFTime(currentTime, milliseconds(100)) == currentTime + milliseconds(100)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,7 @@
 
 #include "JoinPlayerInfo.h"
 #include "network/GameMessages.h"
+#include "network/SerializedGameMessage.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "gameTypes/PlayerState.h"
 #include "rttr/test/random.hpp"
@@ -204,7 +205,8 @@ BOOST_AUTO_TEST_CASE(Serialization)
     }
     {
         const GameMessage_Map_Info msgIn(randString(), randomEnum<MapType>(), randomValue<unsigned>(),
-                                         randomValue<unsigned>(), randomValue<unsigned>(), randomValue<unsigned>());
+                                         randomValue<unsigned>(), randomValue<unsigned>(), randomValue<unsigned>(),
+                                         randomValue<unsigned>(), randomValue<unsigned>());
         const auto msgOut = serializeDeserializeMessage(msgIn);
         BOOST_TEST(msgOut->filename == msgIn.filename);
         BOOST_TEST(msgOut->mt == msgIn.mt);
@@ -212,6 +214,8 @@ BOOST_AUTO_TEST_CASE(Serialization)
         BOOST_TEST(msgOut->mapCompressedLen == msgIn.mapCompressedLen);
         BOOST_TEST(msgOut->luaLen == msgIn.luaLen);
         BOOST_TEST(msgOut->luaCompressedLen == msgIn.luaCompressedLen);
+        BOOST_TEST(msgOut->mapChecksum == msgIn.mapChecksum);
+        BOOST_TEST(msgOut->luaChecksum == msgIn.luaChecksum);
     }
     {
         const GameMessage_MapRequest msgIn(randomBool());
@@ -226,7 +230,26 @@ BOOST_AUTO_TEST_CASE(Serialization)
         const auto msgOut = serializeDeserializeMessage(msgIn);
         BOOST_TEST(msgOut->isMapData == msgIn.isMapData);
         BOOST_TEST(msgOut->offset == msgIn.offset);
-        BOOST_TEST(msgOut->data == msgIn.data);
+        BOOST_TEST_REQUIRE(msgOut->length == data.size());
+        BOOST_TEST(std::vector<char>(msgOut->getData(), msgOut->getData() + msgOut->length) == data,
+                   boost::test_tools::per_element());
+    }
+    {
+        // Chunk of a shared buffer
+        auto data = std::make_shared<std::vector<char>>(randomValue(10, 20));
+        for(auto& c : *data)
+            c = randomValue<char>();
+        const unsigned offset = randomValue(0u, 5u);
+        const unsigned length = randomValue(1u, 5u);
+        const GameMessage_Map_Data msgIn(randomBool(), data, offset, length);
+        BOOST_TEST(msgIn.getData() == data->data() + offset);
+        const auto msgOut = serializeDeserializeMessage(msgIn);
+        BOOST_TEST(msgOut->isMapData == msgIn.isMapData);
+        BOOST_TEST(msgOut->offset == offset);
+        BOOST_TEST_REQUIRE(msgOut->length == length);
+        BOOST_TEST(std::vector<char>(msgOut->getData(), msgOut->getData() + length)
+                     == std::vector<char>(data->begin() + offset, data->begin() + offset + length),
+                   boost::test_tools::per_element());
     }
     {
         const GameMessage_Map_Checksum msgIn(randomValue<unsigned>(), randomValue<unsigned>());
@@ -305,4 +328,24 @@ BOOST_AUTO_TEST_CASE(Serialization)
     }
 }
 
+BOOST_AUTO_TEST_CASE(SerializedMessage)
+{
+    const GameMessage_Player_Name msgIn(rttr::test::randomValue<uint8_t>(), rttr::test::randString());
+    const SerializedGameMessage serializedMsg(msgIn);
+    BOOST_TEST(serializedMsg.getId() == msgIn.getId());
+    // Copies share the data and are received as the original message
+    const std::unique_ptr<SerializedGameMessage> msgCopy(serializedMsg.copy());
+    BOOST_TEST(msgCopy->getId() == msgIn.getId());
+    Serializer ser;
+    msgCopy->Serialize(ser);
+    std::unique_ptr<Message> msgOut(GameMessage::create_game(msgCopy->getId()));
+    Serializer serOut(ser.GetData(), ser.GetLength());
+    msgOut->Deserialize(serOut);
+    BOOST_TEST(serOut.GetBytesLeft() == 0u);
+    const auto* playerNameMsg = dynamic_cast<const GameMessage_Player_Name*>(msgOut.get());
+    BOOST_TEST_REQUIRE(playerNameMsg);
+    BOOST_TEST(playerNameMsg->player == msgIn.player);
+    BOOST_TEST(playerNameMsg->playername == msgIn.playername);
+}
+
 BOOST_AUTO_TEST_SUITE_END()